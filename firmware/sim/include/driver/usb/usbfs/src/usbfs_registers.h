@@ -0,0 +1,26 @@
+/*******************************************************************************
+  Host Simulator USBFS Register Map
+
+  File Name:
+    usbfs_registers.h
+
+  Summary:
+    Replaces the USBFS register map when building for the host.
+
+  Description:
+    The simulator implements DRV_USBFS_DEVICE_INTERFACE in software and never
+    touches the USB SFRs, so only the module ID used by DRV_USBFS_INIT is
+    provided here.
+*******************************************************************************/
+
+#ifndef SIM_USBFS_REGISTERS_H
+#define SIM_USBFS_REGISTERS_H
+
+typedef enum {
+
+    USB_ID_1 = 0,
+    USB_NUMBER_OF_MODULES = 1
+
+} USB_MODULE_ID;
+
+#endif // SIM_USBFS_REGISTERS_H
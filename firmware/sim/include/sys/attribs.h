@@ -0,0 +1,20 @@
+/*******************************************************************************
+  Host Simulator Attribute Header
+
+  File Name:
+    attribs.h
+
+  Summary:
+    Stand-in for <sys/attribs.h> when building for the host.
+
+  Description:
+    Interrupt vectors do not exist on the host. Handlers are called directly
+    by the simulator, so __ISR() expands to nothing.
+*******************************************************************************/
+
+#ifndef SIM_SYS_ATTRIBS_H
+#define SIM_SYS_ATTRIBS_H
+
+#define __ISR(v, ...)
+
+#endif // SIM_SYS_ATTRIBS_H
@@ -0,0 +1,328 @@
+/*******************************************************************************
+  Host Simulator Device Header
+
+  File Name:
+    xc.h
+
+  Summary:
+    Stand-in for the XC32 device header when building for the host.
+
+  Description:
+    The Harmony headers include <xc.h> for the interrupt source numbers, the
+    SFR names and the CP0 access macros. This file provides just enough of
+    them to compile the USB device stack and the application on a Linux host.
+    SFRs are plain variables defined in sim_platform.c so that plib_gpio.c and
+    the GPIO macros of plib_gpio.h read and write simulated pin state.
+*******************************************************************************/
+
+#ifndef SIM_XC_H
+#define SIM_XC_H
+
+#include <stdint.h>
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interrupt Request Numbers
+// *****************************************************************************
+// *****************************************************************************
+
+#define _CORE_TIMER_IRQ                      0
+#define _CORE_SOFTWARE_0_IRQ                 1
+#define _CORE_SOFTWARE_1_IRQ                 2
+#define _EXTERNAL_0_IRQ                      3
+#define _TIMER_1_IRQ                         4
+#define _INPUT_CAPTURE_ERROR_1_IRQ           5
+#define _INPUT_CAPTURE_1_IRQ                 6
+#define _OUTPUT_COMPARE_1_IRQ                7
+#define _EXTERNAL_1_IRQ                      8
+#define _TIMER_2_IRQ                         9
+#define _INPUT_CAPTURE_ERROR_2_IRQ           10
+#define _INPUT_CAPTURE_2_IRQ                 11
+#define _OUTPUT_COMPARE_2_IRQ                12
+#define _EXTERNAL_2_IRQ                      13
+#define _TIMER_3_IRQ                         14
+#define _INPUT_CAPTURE_ERROR_3_IRQ           15
+#define _INPUT_CAPTURE_3_IRQ                 16
+#define _OUTPUT_COMPARE_3_IRQ                17
+#define _EXTERNAL_3_IRQ                      18
+#define _TIMER_4_IRQ                         19
+#define _INPUT_CAPTURE_ERROR_4_IRQ           20
+#define _INPUT_CAPTURE_4_IRQ                 21
+#define _OUTPUT_COMPARE_4_IRQ                22
+#define _EXTERNAL_4_IRQ                      23
+#define _TIMER_5_IRQ                         24
+#define _INPUT_CAPTURE_ERROR_5_IRQ           25
+#define _INPUT_CAPTURE_5_IRQ                 26
+#define _OUTPUT_COMPARE_5_IRQ                27
+#define _ADC_IRQ                             28
+#define _FAIL_SAFE_MONITOR_IRQ               29
+#define _RTCC_IRQ                            30
+#define _FLASH_CONTROL_IRQ                   31
+#define _COMPARATOR_1_IRQ                    32
+#define _COMPARATOR_2_IRQ                    33
+#define _COMPARATOR_3_IRQ                    34
+#define _USB_IRQ                             35
+#define _SPI1_ERR_IRQ                        36
+#define _SPI1_RX_IRQ                         37
+#define _SPI1_TX_IRQ                         38
+#define _UART1_ERR_IRQ                       39
+#define _UART1_RX_IRQ                        40
+#define _UART1_TX_IRQ                        41
+#define _I2C1_BUS_IRQ                        42
+#define _I2C1_SLAVE_IRQ                      43
+#define _I2C1_MASTER_IRQ                     44
+#define _CHANGE_NOTICE_A_IRQ                 45
+#define _CHANGE_NOTICE_B_IRQ                 46
+#define _CHANGE_NOTICE_C_IRQ                 47
+#define _PMP_IRQ                             48
+#define _PMP_ERROR_IRQ                       49
+#define _SPI2_ERR_IRQ                        50
+#define _SPI2_RX_IRQ                         51
+#define _SPI2_TX_IRQ                         52
+#define _UART2_ERR_IRQ                       53
+#define _UART2_RX_IRQ                        54
+#define _UART2_TX_IRQ                        55
+#define _I2C2_BUS_IRQ                        56
+#define _I2C2_SLAVE_IRQ                      57
+#define _I2C2_MASTER_IRQ                     58
+#define _CTMU_IRQ                            59
+#define _DMA0_IRQ                            60
+#define _DMA1_IRQ                            61
+#define _DMA2_IRQ                            62
+#define _DMA3_IRQ                            63
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Special Function Registers
+// *****************************************************************************
+// *****************************************************************************
+
+/* The GPIO registers of each port sit in one 0x100 byte block, as on the
+   device, so that plib_gpio.c can step from PORTA to PORTB by offset. The
+   SET/CLR/INV aliases are separate words. Every access goes through
+   SIM_SFR_Register(), which first folds pending alias writes into their base
+   registers, so back-to-back writes to the same alias are all applied. */
+#define SIM_SFR_PORT_WORDS                  0x40U
+
+extern volatile uint32_t SIM_SFR_GPIO[2U * SIM_SFR_PORT_WORDS];
+extern volatile uint32_t SIM_SFR_INT[8];
+
+volatile uint32_t * SIM_SFR_Register(volatile uint32_t * reg);
+
+#define SIM_SFR_GPIO_REG(port, offset)      (*SIM_SFR_Register(&SIM_SFR_GPIO[((port) * SIM_SFR_PORT_WORDS) + ((offset) / 4U)]))
+
+#define ANSELA                              SIM_SFR_GPIO_REG(0U, 0x00U)
+#define ANSELACLR                           SIM_SFR_GPIO_REG(0U, 0x04U)
+#define ANSELASET                           SIM_SFR_GPIO_REG(0U, 0x08U)
+#define ANSELAINV                           SIM_SFR_GPIO_REG(0U, 0x0CU)
+#define TRISA                               SIM_SFR_GPIO_REG(0U, 0x10U)
+#define TRISACLR                            SIM_SFR_GPIO_REG(0U, 0x14U)
+#define TRISASET                            SIM_SFR_GPIO_REG(0U, 0x18U)
+#define TRISAINV                            SIM_SFR_GPIO_REG(0U, 0x1CU)
+#define PORTA                               SIM_SFR_GPIO_REG(0U, 0x20U)
+#define PORTACLR                            SIM_SFR_GPIO_REG(0U, 0x24U)
+#define PORTASET                            SIM_SFR_GPIO_REG(0U, 0x28U)
+#define PORTAINV                            SIM_SFR_GPIO_REG(0U, 0x2CU)
+#define LATA                                SIM_SFR_GPIO_REG(0U, 0x30U)
+#define LATACLR                             SIM_SFR_GPIO_REG(0U, 0x34U)
+#define LATASET                             SIM_SFR_GPIO_REG(0U, 0x38U)
+#define LATAINV                             SIM_SFR_GPIO_REG(0U, 0x3CU)
+#define ODCA                                SIM_SFR_GPIO_REG(0U, 0x40U)
+#define ODCACLR                             SIM_SFR_GPIO_REG(0U, 0x44U)
+#define ODCASET                             SIM_SFR_GPIO_REG(0U, 0x48U)
+#define ODCAINV                             SIM_SFR_GPIO_REG(0U, 0x4CU)
+#define CNPUA                               SIM_SFR_GPIO_REG(0U, 0x50U)
+#define CNPUACLR                            SIM_SFR_GPIO_REG(0U, 0x54U)
+#define CNPUASET                            SIM_SFR_GPIO_REG(0U, 0x58U)
+#define CNPUAINV                            SIM_SFR_GPIO_REG(0U, 0x5CU)
+#define CNPDA                               SIM_SFR_GPIO_REG(0U, 0x60U)
+#define CNPDACLR                            SIM_SFR_GPIO_REG(0U, 0x64U)
+#define CNPDASET                            SIM_SFR_GPIO_REG(0U, 0x68U)
+#define CNPDAINV                            SIM_SFR_GPIO_REG(0U, 0x6CU)
+#define CNCONA                              SIM_SFR_GPIO_REG(0U, 0x70U)
+#define CNCONACLR                           SIM_SFR_GPIO_REG(0U, 0x74U)
+#define CNCONASET                           SIM_SFR_GPIO_REG(0U, 0x78U)
+#define CNCONAINV                           SIM_SFR_GPIO_REG(0U, 0x7CU)
+#define CNENA                               SIM_SFR_GPIO_REG(0U, 0x80U)
+#define CNENACLR                            SIM_SFR_GPIO_REG(0U, 0x84U)
+#define CNENASET                            SIM_SFR_GPIO_REG(0U, 0x88U)
+#define CNENAINV                            SIM_SFR_GPIO_REG(0U, 0x8CU)
+#define CNSTATA                             SIM_SFR_GPIO_REG(0U, 0x90U)
+#define CNSTATACLR                          SIM_SFR_GPIO_REG(0U, 0x94U)
+#define CNSTATASET                          SIM_SFR_GPIO_REG(0U, 0x98U)
+#define CNSTATAINV                          SIM_SFR_GPIO_REG(0U, 0x9CU)
+
+#define ANSELB                              SIM_SFR_GPIO_REG(1U, 0x00U)
+#define ANSELBCLR                           SIM_SFR_GPIO_REG(1U, 0x04U)
+#define ANSELBSET                           SIM_SFR_GPIO_REG(1U, 0x08U)
+#define ANSELBINV                           SIM_SFR_GPIO_REG(1U, 0x0CU)
+#define TRISB                               SIM_SFR_GPIO_REG(1U, 0x10U)
+#define TRISBCLR                            SIM_SFR_GPIO_REG(1U, 0x14U)
+#define TRISBSET                            SIM_SFR_GPIO_REG(1U, 0x18U)
+#define TRISBINV                            SIM_SFR_GPIO_REG(1U, 0x1CU)
+#define PORTB                               SIM_SFR_GPIO_REG(1U, 0x20U)
+#define PORTBCLR                            SIM_SFR_GPIO_REG(1U, 0x24U)
+#define PORTBSET                            SIM_SFR_GPIO_REG(1U, 0x28U)
+#define PORTBINV                            SIM_SFR_GPIO_REG(1U, 0x2CU)
+#define LATB                                SIM_SFR_GPIO_REG(1U, 0x30U)
+#define LATBCLR                             SIM_SFR_GPIO_REG(1U, 0x34U)
+#define LATBSET                             SIM_SFR_GPIO_REG(1U, 0x38U)
+#define LATBINV                             SIM_SFR_GPIO_REG(1U, 0x3CU)
+#define ODCB                                SIM_SFR_GPIO_REG(1U, 0x40U)
+#define ODCBCLR                             SIM_SFR_GPIO_REG(1U, 0x44U)
+#define ODCBSET                             SIM_SFR_GPIO_REG(1U, 0x48U)
+#define ODCBINV                             SIM_SFR_GPIO_REG(1U, 0x4CU)
+#define CNPUB                               SIM_SFR_GPIO_REG(1U, 0x50U)
+#define CNPUBCLR                            SIM_SFR_GPIO_REG(1U, 0x54U)
+#define CNPUBSET                            SIM_SFR_GPIO_REG(1U, 0x58U)
+#define CNPUBINV                            SIM_SFR_GPIO_REG(1U, 0x5CU)
+#define CNPDB                               SIM_SFR_GPIO_REG(1U, 0x60U)
+#define CNPDBCLR                            SIM_SFR_GPIO_REG(1U, 0x64U)
+#define CNPDBSET                            SIM_SFR_GPIO_REG(1U, 0x68U)
+#define CNPDBINV                            SIM_SFR_GPIO_REG(1U, 0x6CU)
+#define CNCONB                              SIM_SFR_GPIO_REG(1U, 0x70U)
+#define CNCONBCLR                           SIM_SFR_GPIO_REG(1U, 0x74U)
+#define CNCONBSET                           SIM_SFR_GPIO_REG(1U, 0x78U)
+#define CNCONBINV                           SIM_SFR_GPIO_REG(1U, 0x7CU)
+#define CNENB                               SIM_SFR_GPIO_REG(1U, 0x80U)
+#define CNENBCLR                            SIM_SFR_GPIO_REG(1U, 0x84U)
+#define CNENBSET                            SIM_SFR_GPIO_REG(1U, 0x88U)
+#define CNENBINV                            SIM_SFR_GPIO_REG(1U, 0x8CU)
+#define CNSTATB                             SIM_SFR_GPIO_REG(1U, 0x90U)
+#define CNSTATBCLR                          SIM_SFR_GPIO_REG(1U, 0x94U)
+#define CNSTATBSET                          SIM_SFR_GPIO_REG(1U, 0x98U)
+#define CNSTATBINV                          SIM_SFR_GPIO_REG(1U, 0x9CU)
+
+typedef union
+{
+    struct
+    {
+        uint32_t :13;
+        uint32_t CNAIF:1;
+        uint32_t CNBIF:1;
+        uint32_t :17;
+    };
+    uint32_t w;
+
+} __IFS1bits_t;
+
+typedef union
+{
+    struct
+    {
+        uint32_t CTIF:1;
+        uint32_t :8;
+        uint32_t T2IF:1;
+        uint32_t :4;
+        uint32_t T3IF:1;
+        uint32_t :17;
+    };
+    uint32_t w;
+
+} __IFS0bits_t;
+
+typedef struct
+{
+    uint32_t :13;
+    uint32_t IOLOCK:1;
+    uint32_t :18;
+
+} __CFGCONbits_t;
+
+extern volatile __CFGCONbits_t CFGCONbits;
+extern volatile uint32_t SYSKEY, U1RXR, RPB15R, RPA4R;
+
+/* IFS0 and IEC0 with their aliases, laid out like SIM_SFR_INT */
+extern volatile uint32_t SIM_SFR_INT0[8];
+
+#define IFS0                                (*SIM_SFR_Register(&SIM_SFR_INT0[0]))
+#define IFS0CLR                             (*SIM_SFR_Register(&SIM_SFR_INT0[1]))
+#define IFS0SET                             (*SIM_SFR_Register(&SIM_SFR_INT0[2]))
+#define IEC0                                (*SIM_SFR_Register(&SIM_SFR_INT0[4]))
+#define IEC0CLR                             (*SIM_SFR_Register(&SIM_SFR_INT0[5]))
+#define IEC0SET                             (*SIM_SFR_Register(&SIM_SFR_INT0[6]))
+#define IFS0bits                            (*(volatile __IFS0bits_t *)SIM_SFR_Register(&SIM_SFR_INT0[0]))
+
+/* TMR2, TMR3 and OC3, each register followed by its CLR, SET and INV aliases */
+extern volatile uint32_t SIM_SFR_TMR2[12];
+extern volatile uint32_t SIM_SFR_TMR3[12];
+extern volatile uint32_t SIM_SFR_OC3[12];
+
+#define T2CON                               (*SIM_SFR_Register(&SIM_SFR_TMR2[0]))
+#define T2CONCLR                            (*SIM_SFR_Register(&SIM_SFR_TMR2[1]))
+#define T2CONSET                            (*SIM_SFR_Register(&SIM_SFR_TMR2[2]))
+#define TMR2                                (*SIM_SFR_Register(&SIM_SFR_TMR2[4]))
+#define PR2                                 (*SIM_SFR_Register(&SIM_SFR_TMR2[8]))
+#define T3CON                               (*SIM_SFR_Register(&SIM_SFR_TMR3[0]))
+#define T3CONCLR                            (*SIM_SFR_Register(&SIM_SFR_TMR3[1]))
+#define T3CONSET                            (*SIM_SFR_Register(&SIM_SFR_TMR3[2]))
+#define TMR3                                (*SIM_SFR_Register(&SIM_SFR_TMR3[4]))
+#define PR3                                 (*SIM_SFR_Register(&SIM_SFR_TMR3[8]))
+#define OC3CON                              (*SIM_SFR_Register(&SIM_SFR_OC3[0]))
+#define OC3CONCLR                           (*SIM_SFR_Register(&SIM_SFR_OC3[1]))
+#define OC3CONSET                           (*SIM_SFR_Register(&SIM_SFR_OC3[2]))
+#define OC3R                                (*SIM_SFR_Register(&SIM_SFR_OC3[4]))
+#define OC3RS                               (*SIM_SFR_Register(&SIM_SFR_OC3[8]))
+
+/* RCON, RSWRST and WDTCON, each followed by its CLR, SET and INV aliases */
+extern volatile uint32_t SIM_SFR_RCON[4];
+extern volatile uint32_t SIM_SFR_RSWRST[4];
+extern volatile uint32_t SIM_SFR_WDTCON[4];
+
+#define RCON                                (*SIM_SFR_Register(&SIM_SFR_RCON[0]))
+#define RCONCLR                             (*SIM_SFR_Register(&SIM_SFR_RCON[1]))
+#define RSWRST                              (*SIM_SFR_Register(&SIM_SFR_RSWRST[0]))
+#define RSWRSTSET                           (*SIM_SFR_Register(&SIM_SFR_RSWRST[2]))
+#define WDTCON                              (*SIM_SFR_Register(&SIM_SFR_WDTCON[0]))
+#define WDTCONCLR                           (*SIM_SFR_Register(&SIM_SFR_WDTCON[1]))
+#define WDTCONSET                           (*SIM_SFR_Register(&SIM_SFR_WDTCON[2]))
+
+#define IFS1                                (*SIM_SFR_Register(&SIM_SFR_INT[0]))
+#define IFS1CLR                             (*SIM_SFR_Register(&SIM_SFR_INT[1]))
+#define IFS1SET                             (*SIM_SFR_Register(&SIM_SFR_INT[2]))
+#define IEC1                                (*SIM_SFR_Register(&SIM_SFR_INT[4]))
+#define IEC1CLR                             (*SIM_SFR_Register(&SIM_SFR_INT[5]))
+#define IEC1SET                             (*SIM_SFR_Register(&SIM_SFR_INT[6]))
+#define IFS1bits                            (*(volatile __IFS1bits_t *)SIM_SFR_Register(&SIM_SFR_INT[0]))
+
+#define _CNCONA_ON_MASK                     0x00008000U
+#define _CNCONB_ON_MASK                     0x00008000U
+#define _IEC1_CNAIE_MASK                    0x00002000U
+#define _IEC1_CNBIE_MASK                    0x00004000U
+#define _IFS1_CNAIF_MASK                    0x00002000U
+#define _IFS1_CNBIF_MASK                    0x00004000U
+#define _IEC0_CTIE_MASK                     0x00000001U
+#define _IFS0_CTIF_MASK                     0x00000001U
+#define _IEC0_T2IE_MASK                     0x00000200U
+#define _IFS0_T2IF_MASK                     0x00000200U
+#define _T2CON_ON_MASK                      0x00008000U
+#define _IEC0_T3IE_MASK                     0x00004000U
+#define _IFS0_T3IF_MASK                     0x00004000U
+#define _T3CON_ON_MASK                      0x00008000U
+#define _OC3CON_ON_MASK                     0x00008000U
+#define _RCON_POR_MASK                      0x00000001U
+#define _RCON_BOR_MASK                      0x00000002U
+#define _RCON_WDTO_MASK                     0x00000010U
+#define _RCON_SWR_MASK                      0x00000040U
+#define _RCON_EXTR_MASK                     0x00000080U
+#define _RSWRST_SWRST_MASK                  0x00000001U
+#define _WDTCON_WDTCLR_MASK                 0x00000001U
+#define _WDTCON_ON_MASK                     0x00008000U
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Core Access
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SIM_CoreStatusGet(void);
+uint32_t SIM_CoreCountGet(void);
+void SIM_CoreCompareSet(uint32_t compare);
+
+#define _CP0_GET_STATUS()                   SIM_CoreStatusGet()
+#define _CP0_GET_COUNT()                    SIM_CoreCountGet()
+#define _CP0_SET_COMPARE(compare)           SIM_CoreCompareSet(compare)
+#define __builtin_disable_interrupts()      SIM_CoreStatusGet()
+#define __builtin_enable_interrupts()       ((void)0)
+
+#endif // SIM_XC_H
@@ -0,0 +1,727 @@
+/*******************************************************************************
+  Simulated USBFS Device Driver
+
+  File Name:
+    drv_usbfs_sim.c
+
+  Summary:
+    Software implementation of DRV_USB_DEVICE_INTERFACE for the host simulator.
+
+  Description:
+    This file provides gDrvUSBFSDeviceInterface and the DRV_USBFS_* client
+    functions behind it, so that usb_device.c and usb_device_hid.c link
+    unchanged on the host with or without USB_DEVICE_STATIC_BINDING. Instead
+    of a BDT and the USBFS interrupt, each endpoint direction keeps an IRP
+    queue that the test host drains with SIM_USB_Setup, SIM_USB_In and
+    SIM_USB_Out. IRP completion follows drv_usbfs_device.c: a SETUP packet
+    completes the head RX IRP on EP0 with USB_DEVICE_IRP_STATUS_SETUP, an OUT
+    transfer ends on a short packet or when the IRP is full, and an IN
+    transfer ends with a short packet or with a ZLP when the IRP asks for one.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "driver/usb/usbfs/drv_usbfs.h"
+#include "sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Mirrors USB_DEVICE_IRP_FLAG_SEND_ZLP of drv_usbfs_local.h. The flag is set
+   at submit time on a TX IRP that must be terminated with a ZLP. */
+#define SIM_USB_IRP_FLAG_SEND_ZLP   0x80
+
+/* Progress of an IRP is kept in its driver private data. privateData[1]
+   and [2] hold the queue link, which is 64 bits wide on the host. */
+#define SIM_USB_IRP_PROGRESS(irp)   ((irp)->privateData[0])
+
+typedef struct
+{
+    /* Queue of submitted IRPs, head is in progress */
+    USB_DEVICE_IRP * irpQueue;
+
+    uint16_t maxPacketSize;
+
+    USB_TRANSFER_TYPE transferType;
+
+    bool isEnabled;
+
+    bool isStalled;
+
+} SIM_USB_ENDPOINT_OBJ;
+
+typedef struct
+{
+    bool isOpened;
+
+    bool isAttached;
+
+    bool isVbusPresent;
+
+    /* VBUS level last reported to the client */
+    bool isSessionValid;
+
+    uint8_t address;
+
+    uint16_t frameNumber;
+
+    uintptr_t hClientArg;
+
+    DRV_USB_EVENT_CALLBACK eventCallBack;
+
+    /* Index 0 is OUT (RX), index 1 is IN (TX) */
+    SIM_USB_ENDPOINT_OBJ endpoint[DRV_USBFS_ENDPOINTS_NUMBER][2];
+
+    SIM_USB_STATISTICS statistics;
+
+} SIM_USB_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static SIM_USB_OBJ simUSBObj;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static USB_DEVICE_IRP * _SIM_USB_IRPNextGet(const USB_DEVICE_IRP * irp)
+{
+    USB_DEVICE_IRP * next;
+
+    memcpy(&next, &irp->privateData[1], sizeof(next));
+
+    return next;
+}
+
+static void _SIM_USB_IRPNextSet(USB_DEVICE_IRP * irp, USB_DEVICE_IRP * next)
+{
+    memcpy(&irp->privateData[1], &next, sizeof(next));
+}
+
+static void _SIM_USB_EventSend(DRV_USB_EVENT event, void * eventData)
+{
+    if((simUSBObj.isAttached) && (simUSBObj.eventCallBack != NULL))
+    {
+        simUSBObj.eventCallBack((DRV_HANDLE)simUSBObj.hClientArg, event, eventData);
+    }
+}
+
+static SIM_USB_ENDPOINT_OBJ * _SIM_USB_EndpointGet(USB_ENDPOINT endpointAndDirection)
+{
+    uint8_t endpoint = endpointAndDirection & 0xF;
+
+    if(endpoint >= DRV_USBFS_ENDPOINTS_NUMBER)
+    {
+        return NULL;
+    }
+
+    return &simUSBObj.endpoint[endpoint][(endpointAndDirection & 0x80) != 0];
+}
+
+static void _SIM_USB_IRPComplete(SIM_USB_ENDPOINT_OBJ * endpointObj, USB_DEVICE_IRP_STATUS status)
+{
+    USB_DEVICE_IRP * irp = endpointObj->irpQueue;
+
+    /* Pop the IRP before the callback, which may submit the next one */
+    endpointObj->irpQueue = _SIM_USB_IRPNextGet(irp);
+    if(endpointObj->irpQueue != NULL)
+    {
+        endpointObj->irpQueue->status = USB_DEVICE_IRP_STATUS_IN_PROGRESS;
+    }
+
+    irp->status = status;
+    simUSBObj.statistics.irpsCompleted++;
+
+    if((irp->callback != NULL) && (status != USB_DEVICE_IRP_STATUS_ABORTED))
+    {
+        irp->callback(irp);
+    }
+}
+
+static void _SIM_USB_IRPQueueFlush(SIM_USB_ENDPOINT_OBJ * endpointObj, USB_DEVICE_IRP_STATUS status)
+{
+    USB_DEVICE_IRP * irp = endpointObj->irpQueue;
+    USB_DEVICE_IRP * next;
+
+    /* Detach the queue first. Callbacks may submit new IRPs, and those must
+       survive the flush. */
+    endpointObj->irpQueue = NULL;
+
+    while(irp != NULL)
+    {
+        next = _SIM_USB_IRPNextGet(irp);
+        irp->status = status;
+
+        if(irp->callback != NULL)
+        {
+            irp->callback(irp);
+        }
+
+        irp = next;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver Client Interface
+// *****************************************************************************
+// *****************************************************************************
+
+DRV_HANDLE DRV_USBFS_Open(const SYS_MODULE_INDEX drvIndex, const DRV_IO_INTENT intent)
+{
+    if((drvIndex != DRV_USBFS_INDEX_0) || (simUSBObj.isOpened))
+    {
+        return DRV_HANDLE_INVALID;
+    }
+
+    simUSBObj.isOpened = true;
+
+    return (DRV_HANDLE)&simUSBObj;
+}
+
+void DRV_USBFS_Close(DRV_HANDLE handle)
+{
+    simUSBObj.isOpened = false;
+    simUSBObj.eventCallBack = NULL;
+}
+
+void DRV_USBFS_ClientEventCallBackSet(DRV_HANDLE handle, uintptr_t hReferenceData, DRV_USB_EVENT_CALLBACK eventHandler)
+{
+    simUSBObj.hClientArg = hReferenceData;
+    simUSBObj.eventCallBack = eventHandler;
+}
+
+void DRV_USBFS_DEVICE_AddressSet(DRV_HANDLE handle, uint8_t address)
+{
+    simUSBObj.address = address;
+}
+
+USB_SPEED DRV_USBFS_DEVICE_CurrentSpeedGet(DRV_HANDLE handle)
+{
+    return USB_SPEED_FULL;
+}
+
+uint16_t DRV_USBFS_DEVICE_SOFNumberGet(DRV_HANDLE handle)
+{
+    return simUSBObj.frameNumber;
+}
+
+void DRV_USBFS_DEVICE_Attach(DRV_HANDLE handle)
+{
+    simUSBObj.isAttached = true;
+}
+
+void DRV_USBFS_DEVICE_Detach(DRV_HANDLE handle)
+{
+    simUSBObj.isAttached = false;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_EndpointEnable(DRV_HANDLE handle, USB_ENDPOINT endpoint, USB_TRANSFER_TYPE transferType, uint16_t endpointSize)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+    int direction;
+
+    if((endpointObj == NULL) || (endpointSize == 0) || (endpointSize > 64))
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    /* EP0 is bidirectional, the direction bit is ignored */
+    for(direction = 0; direction < 2; direction++)
+    {
+        if(((endpoint & 0xF) == 0) || (direction == ((endpoint & 0x80) != 0)))
+        {
+            endpointObj = &simUSBObj.endpoint[endpoint & 0xF][direction];
+            endpointObj->maxPacketSize = endpointSize;
+            endpointObj->transferType = transferType;
+            endpointObj->isEnabled = true;
+            endpointObj->isStalled = false;
+        }
+    }
+
+    return USB_ERROR_NONE;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_EndpointDisable(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj;
+    int number, direction;
+
+    if(endpoint == DRV_USB_DEVICE_ENDPOINT_ALL)
+    {
+        /* Every endpoint except EP0 */
+        for(number = 1; number < DRV_USBFS_ENDPOINTS_NUMBER; number++)
+        {
+            for(direction = 0; direction < 2; direction++)
+            {
+                endpointObj = &simUSBObj.endpoint[number][direction];
+                _SIM_USB_IRPQueueFlush(endpointObj, USB_DEVICE_IRP_STATUS_ABORTED);
+                endpointObj->isEnabled = false;
+                endpointObj->isStalled = false;
+            }
+        }
+
+        return USB_ERROR_NONE;
+    }
+
+    endpointObj = _SIM_USB_EndpointGet(endpoint);
+    if(endpointObj == NULL)
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    _SIM_USB_IRPQueueFlush(endpointObj, USB_DEVICE_IRP_STATUS_ABORTED);
+    endpointObj->isEnabled = false;
+    endpointObj->isStalled = false;
+
+    return USB_ERROR_NONE;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_EndpointStall(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+    int direction;
+
+    if(endpointObj == NULL)
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    /* For EP0 both directions are stalled */
+    for(direction = 0; direction < 2; direction++)
+    {
+        if(((endpoint & 0xF) == 0) || (direction == ((endpoint & 0x80) != 0)))
+        {
+            endpointObj = &simUSBObj.endpoint[endpoint & 0xF][direction];
+            endpointObj->isStalled = true;
+            _SIM_USB_IRPQueueFlush(endpointObj, USB_DEVICE_IRP_STATUS_ABORTED_ENDPOINT_HALT);
+        }
+    }
+
+    return USB_ERROR_NONE;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_EndpointStallClear(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+
+    if(endpointObj == NULL)
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    endpointObj->isStalled = false;
+    _SIM_USB_IRPQueueFlush(endpointObj, USB_DEVICE_IRP_STATUS_ABORTED);
+
+    return USB_ERROR_NONE;
+}
+
+bool DRV_USBFS_DEVICE_EndpointIsEnabled(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+
+    return (endpointObj != NULL) && (endpointObj->isEnabled);
+}
+
+bool DRV_USBFS_DEVICE_EndpointIsStalled(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+
+    return (endpointObj != NULL) && (endpointObj->isStalled);
+}
+
+USB_ERROR DRV_USBFS_DEVICE_IRPSubmit(DRV_HANDLE handle, USB_ENDPOINT endpoint, USB_DEVICE_IRP * irp)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+    USB_DEVICE_IRP * iterator;
+    bool isTx = ((endpoint & 0x80) != 0);
+
+    if((endpointObj == NULL) || (irp == NULL))
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    if(irp->status > USB_DEVICE_IRP_STATUS_SETUP)
+    {
+        return USB_ERROR_DEVICE_IRP_IN_USE;
+    }
+
+    if(!endpointObj->isEnabled)
+    {
+        return USB_ERROR_ENDPOINT_NOT_CONFIGURED;
+    }
+
+    if((!isTx) && ((irp->size % endpointObj->maxPacketSize) != 0))
+    {
+        /* RX IRPs must be a multiple of the endpoint size */
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    irp->flags &= ~SIM_USB_IRP_FLAG_SEND_ZLP;
+    if((isTx) && (irp->size != 0) && ((irp->size % endpointObj->maxPacketSize) == 0)
+            && (irp->flags & USB_DEVICE_IRP_FLAG_DATA_COMPLETE))
+    {
+        irp->flags |= SIM_USB_IRP_FLAG_SEND_ZLP;
+    }
+
+    SIM_USB_IRP_PROGRESS(irp) = 0;
+    _SIM_USB_IRPNextSet(irp, NULL);
+    irp->status = USB_DEVICE_IRP_STATUS_PENDING;
+
+    if(endpointObj->irpQueue == NULL)
+    {
+        irp->status = USB_DEVICE_IRP_STATUS_IN_PROGRESS;
+        endpointObj->irpQueue = irp;
+    }
+    else
+    {
+        iterator = endpointObj->irpQueue;
+        while(_SIM_USB_IRPNextGet(iterator) != NULL)
+        {
+            iterator = _SIM_USB_IRPNextGet(iterator);
+        }
+        _SIM_USB_IRPNextSet(iterator, irp);
+    }
+
+    return USB_ERROR_NONE;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_IRPCancel(DRV_HANDLE handle, USB_DEVICE_IRP * irp)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj;
+    USB_DEVICE_IRP * iterator;
+    USB_DEVICE_IRP * previous;
+    int number, direction;
+
+    for(number = 0; number < DRV_USBFS_ENDPOINTS_NUMBER; number++)
+    {
+        for(direction = 0; direction < 2; direction++)
+        {
+            endpointObj = &simUSBObj.endpoint[number][direction];
+            previous = NULL;
+            for(iterator = endpointObj->irpQueue; iterator != NULL; iterator = _SIM_USB_IRPNextGet(iterator))
+            {
+                if(iterator == irp)
+                {
+                    if(previous == NULL)
+                    {
+                        endpointObj->irpQueue = _SIM_USB_IRPNextGet(irp);
+                    }
+                    else
+                    {
+                        _SIM_USB_IRPNextSet(previous, _SIM_USB_IRPNextGet(irp));
+                    }
+
+                    irp->status = USB_DEVICE_IRP_STATUS_ABORTED;
+                    if(irp->callback != NULL)
+                    {
+                        irp->callback(irp);
+                    }
+                    return USB_ERROR_NONE;
+                }
+                previous = iterator;
+            }
+        }
+    }
+
+    return USB_ERROR_PARAMETER_INVALID;
+}
+
+USB_ERROR DRV_USBFS_DEVICE_IRPCancelAll(DRV_HANDLE handle, USB_ENDPOINT endpoint)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint);
+
+    if(endpointObj == NULL)
+    {
+        return USB_ERROR_PARAMETER_INVALID;
+    }
+
+    _SIM_USB_IRPQueueFlush(endpointObj, USB_DEVICE_IRP_STATUS_ABORTED);
+
+    return USB_ERROR_NONE;
+}
+
+void DRV_USBFS_DEVICE_RemoteWakeupStart(DRV_HANDLE handle)
+{
+}
+
+void DRV_USBFS_DEVICE_RemoteWakeupStop(DRV_HANDLE handle)
+{
+}
+
+DRV_USB_DEVICE_INTERFACE gDrvUSBFSDeviceInterface =
+{
+    .open = DRV_USBFS_Open,
+    .close = DRV_USBFS_Close,
+    .eventHandlerSet = DRV_USBFS_ClientEventCallBackSet,
+    .deviceAddressSet = DRV_USBFS_DEVICE_AddressSet,
+    .deviceCurrentSpeedGet = DRV_USBFS_DEVICE_CurrentSpeedGet,
+    .deviceSOFNumberGet = DRV_USBFS_DEVICE_SOFNumberGet,
+    .deviceAttach = DRV_USBFS_DEVICE_Attach,
+    .deviceDetach = DRV_USBFS_DEVICE_Detach,
+    .deviceEndpointEnable = DRV_USBFS_DEVICE_EndpointEnable,
+    .deviceEndpointDisable = DRV_USBFS_DEVICE_EndpointDisable,
+    .deviceEndpointStall = DRV_USBFS_DEVICE_EndpointStall,
+    .deviceEndpointStallClear = DRV_USBFS_DEVICE_EndpointStallClear,
+    .deviceEndpointIsEnabled = DRV_USBFS_DEVICE_EndpointIsEnabled,
+    .deviceEndpointIsStalled = DRV_USBFS_DEVICE_EndpointIsStalled,
+    .deviceIRPSubmit = DRV_USBFS_DEVICE_IRPSubmit,
+    .deviceIRPCancel = DRV_USBFS_DEVICE_IRPCancel,
+    .deviceIRPCancelAll = DRV_USBFS_DEVICE_IRPCancelAll,
+    .deviceRemoteWakeupStop = DRV_USBFS_DEVICE_RemoteWakeupStop,
+    .deviceRemoteWakeupStart = DRV_USBFS_DEVICE_RemoteWakeupStart,
+    .deviceTestModeEnter = NULL
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Bus Interface
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_USB_DeviceReset(void)
+{
+    bool isVbusPresent = simUSBObj.isVbusPresent;
+    SIM_USB_STATISTICS statistics = simUSBObj.statistics;
+
+    /* The pull-up goes with the rest of the module, and the IRPs in the
+       queues belonged to the firmware that was reset */
+    memset(&simUSBObj, 0, sizeof(simUSBObj));
+    simUSBObj.isVbusPresent = isVbusPresent;
+    simUSBObj.statistics = statistics;
+}
+
+void SIM_USB_VbusSet(bool present)
+{
+    simUSBObj.isVbusPresent = present;
+}
+
+void SIM_USB_Tasks(void)
+{
+    /* Like DRV_USBFS_Tasks, report VBUS changes once a client is listening.
+       Session events are sent while detached. */
+    if((simUSBObj.eventCallBack != NULL) && (simUSBObj.isSessionValid != simUSBObj.isVbusPresent))
+    {
+        simUSBObj.isSessionValid = simUSBObj.isVbusPresent;
+        simUSBObj.eventCallBack((DRV_HANDLE)simUSBObj.hClientArg,
+                simUSBObj.isSessionValid ? DRV_USB_EVENT_DEVICE_SESSION_VALID : DRV_USB_EVENT_DEVICE_SESSION_INVALID, NULL);
+    }
+}
+
+void SIM_USB_BusReset(void)
+{
+    simUSBObj.address = 0;
+    _SIM_USB_EventSend(DRV_USB_EVENT_RESET_DETECT, NULL);
+}
+
+void SIM_USB_Suspend(void)
+{
+    _SIM_USB_EventSend(DRV_USB_EVENT_IDLE_DETECT, NULL);
+}
+
+void SIM_USB_Resume(void)
+{
+    _SIM_USB_EventSend(DRV_USB_EVENT_RESUME_DETECT, NULL);
+}
+
+void SIM_USB_StartOfFrame(void)
+{
+    simUSBObj.frameNumber = (simUSBObj.frameNumber + 1) & 0x7FF;
+    simUSBObj.statistics.frames++;
+    _SIM_USB_EventSend(DRV_USB_EVENT_SOF_DETECT, NULL);
+}
+
+SIM_USB_HANDSHAKE SIM_USB_Setup(const uint8_t * setup)
+{
+    SIM_USB_ENDPOINT_OBJ * rxObj = &simUSBObj.endpoint[0][0];
+    USB_DEVICE_IRP * irp;
+
+    if((!simUSBObj.isAttached) || (!rxObj->isEnabled))
+    {
+        simUSBObj.statistics.errors++;
+        return SIM_USB_HANDSHAKE_ERROR;
+    }
+
+    /* A SETUP packet is always accepted and clears the EP0 stall */
+    rxObj->isStalled = false;
+    simUSBObj.endpoint[0][1].isStalled = false;
+
+    irp = rxObj->irpQueue;
+    if(irp == NULL)
+    {
+        simUSBObj.statistics.naks++;
+        return SIM_USB_HANDSHAKE_NAK;
+    }
+
+    memcpy(irp->data, setup, 8);
+    irp->size = 8;
+    simUSBObj.statistics.transactions++;
+    _SIM_USB_IRPComplete(rxObj, USB_DEVICE_IRP_STATUS_SETUP);
+
+    return SIM_USB_HANDSHAKE_ACK;
+}
+
+SIM_USB_HANDSHAKE SIM_USB_Out(uint8_t endpoint, const uint8_t * data, size_t length)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet(endpoint & 0xF);
+    USB_DEVICE_IRP * irp;
+    uint32_t received;
+
+    if((!simUSBObj.isAttached) || (endpointObj == NULL) || (!endpointObj->isEnabled)
+            || (length > endpointObj->maxPacketSize))
+    {
+        simUSBObj.statistics.errors++;
+        return SIM_USB_HANDSHAKE_ERROR;
+    }
+
+    if(endpointObj->isStalled)
+    {
+        simUSBObj.statistics.stalls++;
+        return SIM_USB_HANDSHAKE_STALL;
+    }
+
+    irp = endpointObj->irpQueue;
+    if(irp == NULL)
+    {
+        simUSBObj.statistics.naks++;
+        return SIM_USB_HANDSHAKE_NAK;
+    }
+
+    received = SIM_USB_IRP_PROGRESS(irp);
+    if(length > (irp->size - received))
+    {
+        /* The host sent more than the IRP can hold. The hardware would
+           overrun the buffer; report it instead. */
+        simUSBObj.statistics.errors++;
+        return SIM_USB_HANDSHAKE_ERROR;
+    }
+
+    memcpy((uint8_t *)irp->data + received, data, length);
+    received += length;
+    SIM_USB_IRP_PROGRESS(irp) = received;
+    simUSBObj.statistics.transactions++;
+
+    if((length < endpointObj->maxPacketSize) || (received >= irp->size))
+    {
+        USB_DEVICE_IRP_STATUS status = (received >= irp->size) ?
+                USB_DEVICE_IRP_STATUS_COMPLETED : USB_DEVICE_IRP_STATUS_COMPLETED_SHORT;
+
+        irp->size = received;
+        _SIM_USB_IRPComplete(endpointObj, status);
+    }
+
+    return SIM_USB_HANDSHAKE_ACK;
+}
+
+SIM_USB_HANDSHAKE SIM_USB_In(uint8_t endpoint, uint8_t * data, size_t * length)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet((endpoint & 0xF) | 0x80);
+    USB_DEVICE_IRP * irp;
+    uint32_t sent;
+    size_t packet;
+
+    *length = 0;
+
+    if((!simUSBObj.isAttached) || (endpointObj == NULL) || (!endpointObj->isEnabled))
+    {
+        simUSBObj.statistics.errors++;
+        return SIM_USB_HANDSHAKE_ERROR;
+    }
+
+    if(endpointObj->isStalled)
+    {
+        simUSBObj.statistics.stalls++;
+        return SIM_USB_HANDSHAKE_STALL;
+    }
+
+    irp = endpointObj->irpQueue;
+    if(irp == NULL)
+    {
+        simUSBObj.statistics.naks++;
+        return SIM_USB_HANDSHAKE_NAK;
+    }
+
+    sent = SIM_USB_IRP_PROGRESS(irp);
+    packet = irp->size - sent;
+    if(packet > endpointObj->maxPacketSize)
+    {
+        packet = endpointObj->maxPacketSize;
+    }
+
+    memcpy(data, (const uint8_t *)irp->data + sent, packet);
+    sent += packet;
+    SIM_USB_IRP_PROGRESS(irp) = sent;
+    *length = packet;
+    simUSBObj.statistics.transactions++;
+
+    if(sent >= irp->size)
+    {
+        if((packet == endpointObj->maxPacketSize) && (irp->flags & SIM_USB_IRP_FLAG_SEND_ZLP))
+        {
+            /* The next IN token gets the ZLP */
+            irp->flags &= ~SIM_USB_IRP_FLAG_SEND_ZLP;
+        }
+        else
+        {
+            _SIM_USB_IRPComplete(endpointObj, USB_DEVICE_IRP_STATUS_COMPLETED);
+        }
+    }
+
+    return SIM_USB_HANDSHAKE_ACK;
+}
+
+bool SIM_USB_IsAttached(void)
+{
+    return simUSBObj.isAttached;
+}
+
+uint8_t SIM_USB_AddressGet(void)
+{
+    return simUSBObj.address;
+}
+
+uint16_t SIM_USB_MaxPacketSizeGet(uint8_t endpoint, bool isIn)
+{
+    SIM_USB_ENDPOINT_OBJ * endpointObj = _SIM_USB_EndpointGet((endpoint & 0xF) | (isIn ? 0x80 : 0));
+
+    return ((endpointObj != NULL) && (endpointObj->isEnabled)) ? endpointObj->maxPacketSize : 0;
+}
+
+void SIM_USB_StatisticsGet(SIM_USB_STATISTICS * statistics)
+{
+    *statistics = simUSBObj.statistics;
+}
+
+void SIM_USB_StatisticsClear(void)
+{
+    memset(&simUSBObj.statistics, 0, sizeof(simUSBObj.statistics));
+}
+
+const char * SIM_USB_HandshakeName(SIM_USB_HANDSHAKE handshake)
+{
+    switch(handshake)
+    {
+        case SIM_USB_HANDSHAKE_ACK:
+            return "ACK";
+        case SIM_USB_HANDSHAKE_NAK:
+            return "NAK";
+        case SIM_USB_HANDSHAKE_STALL:
+            return "STALL";
+        default:
+            return "ERROR";
+    }
+}
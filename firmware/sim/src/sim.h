@@ -0,0 +1,210 @@
+/*******************************************************************************
+  Host Simulator Interface
+
+  File Name:
+    sim.h
+
+  Summary:
+    Host side of the USB device stack simulator.
+
+  Description:
+    The simulator links the unmodified USB device layer, HID function driver,
+    descriptors and application against a software DRV_USBFS implementation
+    (drv_usbfs_sim.c) and a small platform layer (sim_platform.c). This file
+    declares the calls a test host uses to play the role of the USB host and
+    of the physical buttons: bus events, SETUP/IN/OUT tokens and pin changes.
+
+    Every token is handled synchronously, the same way the USBFS interrupt
+    handler would complete IRPs on the target. The caller runs the firmware
+    task loop (SIM_TasksRun) between tokens to let the device layer and the
+    application react.
+*******************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Task passes a host transfer waits on a NAK before giving up */
+#define SIM_HOST_NAK_RETRIES                64
+
+/* Task passes run after a bus or pin event to let the firmware settle */
+#define SIM_HOST_TASK_PASSES                8
+
+/* Largest control transfer data stage the host helpers handle */
+#define SIM_HOST_BUFFER_SIZE                512
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Simulated Token Handshake
+
+  Summary:
+    Handshake returned by the device for one host token.
+
+  Description:
+    ACK means the token completed a transaction. NAK means no IRP was queued
+    on the endpoint (the host retries later). STALL means the endpoint is
+    halted. ERROR means the token could not reach the device at all
+    (detached, endpoint not enabled, or a packet larger than maxPacketSize).
+*/
+
+typedef enum
+{
+    SIM_USB_HANDSHAKE_ACK = 0,
+    SIM_USB_HANDSHAKE_NAK,
+    SIM_USB_HANDSHAKE_STALL,
+    SIM_USB_HANDSHAKE_ERROR
+
+} SIM_USB_HANDSHAKE;
+
+// *****************************************************************************
+/* Simulated Bus Statistics
+
+  Summary:
+    Counters kept by the simulated USB driver.
+
+  Description:
+    Counted from the last SIM_USB_StatisticsClear call. "transactions" counts
+    tokens answered with ACK.
+*/
+
+typedef struct
+{
+    uint32_t transactions;
+    uint32_t naks;
+    uint32_t stalls;
+    uint32_t errors;
+    uint32_t irpsCompleted;
+    uint32_t frames;
+
+} SIM_USB_STATISTICS;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated USB Bus
+// *****************************************************************************
+// *****************************************************************************
+
+/* The USBFS module as after a device reset: detached and closed. VBUS and
+   the statistics are kept. */
+void SIM_USB_DeviceReset(void);
+void SIM_USB_VbusSet(bool present);
+
+void SIM_USB_Tasks(void);
+
+void SIM_USB_BusReset(void);
+
+void SIM_USB_Suspend(void);
+
+void SIM_USB_Resume(void);
+
+void SIM_USB_StartOfFrame(void);
+
+SIM_USB_HANDSHAKE SIM_USB_Setup(const uint8_t * setup);
+
+SIM_USB_HANDSHAKE SIM_USB_Out(uint8_t endpoint, const uint8_t * data, size_t length);
+
+SIM_USB_HANDSHAKE SIM_USB_In(uint8_t endpoint, uint8_t * data, size_t * length);
+
+bool SIM_USB_IsAttached(void);
+
+uint8_t SIM_USB_AddressGet(void);
+
+uint16_t SIM_USB_MaxPacketSizeGet(uint8_t endpoint, bool isIn);
+
+void SIM_USB_StatisticsGet(SIM_USB_STATISTICS * statistics);
+
+void SIM_USB_StatisticsClear(void);
+
+const char * SIM_USB_HandshakeName(SIM_USB_HANDSHAKE handshake);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Host
+// *****************************************************************************
+// *****************************************************************************
+
+SIM_USB_HANDSHAKE SIM_HOST_InRetry(uint8_t endpoint, uint8_t * data, size_t * length);
+
+SIM_USB_HANDSHAKE SIM_HOST_ControlTransfer(const uint8_t * setup, uint8_t * data, size_t * length);
+
+bool SIM_HOST_Enumerate(void);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Platform
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_Initialize(void);
+
+void SIM_TasksRun(unsigned int passes);
+
+void SIM_GPIO_PinWrite(GPIO_PIN pin, bool level);
+
+bool SIM_GPIO_PinRead(GPIO_PIN pin);
+
+void SIM_SFR_Update(void);
+
+void SIM_ConsoleEnable(bool enable);
+
+/* Moves CP0 Count forward, as if that many ticks passed at once */
+void SIM_CoreCountAdvance(uint32_t ticks);
+
+/* Resets the device with the given RCON flags set: the USBFS module is
+   reset and SIM_Initialize runs again. Persistent data, which the startup
+   code would not clear, is kept like every other variable. */
+void SIM_Reset(uint32_t resetFlags);
+
+/* Device resets since the simulator started */
+uint32_t SIM_ResetCountGet(void);
+
+/* The main loop stops for the given milliseconds while the timers and their
+   interrupts keep running. Ends early when the watchdog resets the device. */
+void SIM_MainLoopStall(unsigned int milliseconds);
+
+/* Longest interrupt handler runs, by load slot, and the longest stretch
+   with interrupts disabled, in host nanoseconds */
+typedef struct
+{
+    uint64_t handlerNs[APP_LOAD_SLOTS];
+
+    uint64_t disabledNs;
+
+} SIM_LATENCY;
+
+/* Starts over and keeps the longest runs from now on, or stops keeping them */
+void SIM_LatencyMeasure(bool enable);
+
+void SIM_LatencyGet(SIM_LATENCY * latency);
+
+/* Defined in plib_gpio.c and the TMR PLIBs and normally called from interrupts.c */
+void CHANGE_NOTICE_InterruptHandler(void);
+
+void TIMER_2_InterruptHandler(void);
+
+void CORE_TIMER_InterruptHandler(void);
+
+void TIMER_3_InterruptHandler(void);
+
+#endif // SIM_H
@@ -0,0 +1,546 @@
+/*******************************************************************************
+  Host Simulator Benchmarks
+
+  File Name:
+    sim_bench.c
+
+  Summary:
+    Micro-benchmarks of the USB device stack on the host simulator.
+
+  Description:
+    Each benchmark repeats one operation against the enumerated device and
+    reports wall time and retired user-space instructions per operation as
+    JSON. Instructions are read with perf_event_open; where the kernel does
+    not allow it the field is null and only the time is reported.
+
+    Control transfer benchmarks include the host side of the transfer and one
+    pass of the task loop per token, the same work SIM_HOST_ControlTransfer
+    does in the scripts. Instruction counts are stable from run to run and are
+    the number to compare; wall time depends on the machine.
+
+    The USB entry latency section runs the buttons, the encoder and the
+    gesture and repeat timers in both modes and reports the longest run of
+    each interrupt handler and the longest stretch with interrupts disabled
+    (SIM_LatencyMeasure). With every vector at one priority the USB
+    interrupt could wait for the longest handler; at priority 7 it waits at
+    most for the longest disabled section. The figures are host time and
+    only their ratio carries over to the device. Every iteration runs the
+    whole workload and keeps its own maxima; the smallest of them is
+    reported, so that a host scheduling delay in some iterations does not
+    count as the firmware's.
+
+      usb_bench [-n iterations] [-f name-filter] [-o file]
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include "sim.h"
+#include "usb/src/usb_device_function_driver.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_BENCH_ITERATIONS_DEFAULT    100000UL
+#define SIM_BENCH_WARMUP                64UL
+
+/* Task passes, and so milliseconds, a button is held in the latency
+   workload: long enough for the repeat timer to fire a few times */
+#define SIM_BENCH_LATENCY_HOLD_PASSES   700U
+
+/* Load slots of the handlers the USB interrupt used to share a priority
+   with, and their names in the report */
+static const struct
+{
+    APP_LOAD_SLOT slot;
+    const char * name;
+
+} simBenchLatencyHandlers[] =
+{
+    { APP_LOAD_CHANGE_NOTICE,   "change_notice" },
+    { APP_LOAD_TIMER_2,         "timer_2" },
+    { APP_LOAD_TIMER_3,         "timer_3" },
+    { APP_LOAD_CORE_TIMER,      "core_timer" },
+};
+
+typedef struct
+{
+    const char * name;
+
+    /* Iterations are divided by this for expensive operations */
+    unsigned long divisor;
+
+    void (* operation)(void);
+
+} SIM_BENCH;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static USB_DEVICE_IRP simBenchIrp;
+static uint8_t simBenchData[SIM_HOST_BUFFER_SIZE];
+static unsigned long simBenchCallbacks;
+static unsigned long simBenchFailures;
+static int simBenchPerfFd = -1;
+
+/* The device layer has a single client, opened by the application. IRPs are
+   submitted on its handle. */
+extern APP_DATA appData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Benchmark Operations
+// *****************************************************************************
+// *****************************************************************************
+
+static void _SIM_BENCH_IrpCallback(USB_DEVICE_IRP * irp)
+{
+    simBenchCallbacks++;
+}
+
+static void _SIM_BENCH_InDrain(void)
+{
+    size_t length;
+
+    if(SIM_USB_In(1, simBenchData, &length) != SIM_USB_HANDSHAKE_ACK)
+    {
+        simBenchFailures++;
+    }
+}
+
+static void _SIM_BENCH_Control(uint8_t bmRequestType, uint8_t bRequest, uint16_t wValue, uint16_t wIndex, uint16_t wLength)
+{
+    uint8_t setup[8] =
+    {
+        bmRequestType, bRequest, wValue & 0xFF, wValue >> 8,
+        wIndex & 0xFF, wIndex >> 8, wLength & 0xFF, wLength >> 8
+    };
+    size_t length;
+
+    if(SIM_HOST_ControlTransfer(setup, simBenchData, &length) != SIM_USB_HANDSHAKE_ACK)
+    {
+        simBenchFailures++;
+    }
+}
+
+static void _SIM_BENCH_IrpSubmitComplete(void)
+{
+    simBenchIrp.data = simBenchData;
+    simBenchIrp.size = 2;
+    /* As the HID driver submits it: EP1 is 2 bytes, and a full packet with
+       DATA_COMPLETE would be followed by a ZLP */
+    simBenchIrp.flags = 0;
+    simBenchIrp.callback = _SIM_BENCH_IrpCallback;
+
+    if(USB_DEVICE_IRPSubmit(appData.deviceHandle, 0x81, &simBenchIrp) != USB_ERROR_NONE)
+    {
+        simBenchFailures++;
+    }
+
+    _SIM_BENCH_InDrain();
+}
+
+static void _SIM_BENCH_HidReportSend(void)
+{
+    USB_DEVICE_HID_TRANSFER_HANDLE transferHandle;
+
+    if(USB_DEVICE_HID_ReportSend(USB_DEVICE_HID_INDEX_0, &transferHandle, simBenchData, 2) != USB_DEVICE_HID_RESULT_OK)
+    {
+        simBenchFailures++;
+    }
+
+    _SIM_BENCH_InDrain();
+}
+
+static void _SIM_BENCH_StartOfFrame(void)
+{
+    SIM_USB_StartOfFrame();
+}
+
+static void _SIM_BENCH_TasksIdle(void)
+{
+    SIM_TasksRun(1);
+}
+
+static void _SIM_BENCH_GetStatus(void)
+{
+    _SIM_BENCH_Control(0x80, USB_REQUEST_GET_STATUS, 0, 0, 2);
+}
+
+static void _SIM_BENCH_ClearFeature(void)
+{
+    _SIM_BENCH_Control(0x02, USB_REQUEST_CLEAR_FEATURE, USB_FEATURE_SELECTOR_ENDPOINT_HALT, 0x81, 0);
+}
+
+static void _SIM_BENCH_SetAddress(void)
+{
+    _SIM_BENCH_Control(0x00, USB_REQUEST_SET_ADDRESS, 1, 0, 0);
+}
+
+static void _SIM_BENCH_GetDescriptorDevice(void)
+{
+    _SIM_BENCH_Control(0x80, USB_REQUEST_GET_DESCRIPTOR, USB_DESCRIPTOR_DEVICE << 8, 0, 18);
+}
+
+static void _SIM_BENCH_GetDescriptorConfiguration(void)
+{
+    _SIM_BENCH_Control(0x80, USB_REQUEST_GET_DESCRIPTOR, USB_DESCRIPTOR_CONFIGURATION << 8, 0, 0xFF);
+}
+
+static void _SIM_BENCH_GetDescriptorString(void)
+{
+    _SIM_BENCH_Control(0x80, USB_REQUEST_GET_DESCRIPTOR, (USB_DESCRIPTOR_STRING << 8) | 2, 0x0409, 0xFF);
+}
+
+static void _SIM_BENCH_GetConfiguration(void)
+{
+    _SIM_BENCH_Control(0x80, USB_REQUEST_GET_CONFIGURATION, 0, 0, 1);
+}
+
+static void _SIM_BENCH_SetConfiguration(void)
+{
+    _SIM_BENCH_Control(0x00, USB_REQUEST_SET_CONFIGURATION, 1, 0, 0);
+}
+
+static void _SIM_BENCH_GetInterface(void)
+{
+    _SIM_BENCH_Control(0x81, USB_REQUEST_GET_INTERFACE, 0, 0, 1);
+}
+
+static void _SIM_BENCH_HidGetReportDescriptor(void)
+{
+    _SIM_BENCH_Control(0x81, USB_REQUEST_GET_DESCRIPTOR, 0x2200, 0, 0xFF);
+}
+
+static void _SIM_BENCH_HidGetIdle(void)
+{
+    _SIM_BENCH_Control(0xA1, 0x02, 0, 0, 1);
+}
+
+static void _SIM_BENCH_Enumeration(void)
+{
+    SIM_USB_BusReset();
+
+    if(!SIM_HOST_Enumerate())
+    {
+        simBenchFailures++;
+    }
+}
+
+static const SIM_BENCH simBenches[] =
+{
+    { "irp_submit_complete",            1,      _SIM_BENCH_IrpSubmitComplete },
+    { "hid_report_send",                1,      _SIM_BENCH_HidReportSend },
+    { "sof_event",                      1,      _SIM_BENCH_StartOfFrame },
+    { "tasks_idle",                     1,      _SIM_BENCH_TasksIdle },
+    { "control_get_status",             10,     _SIM_BENCH_GetStatus },
+    { "control_clear_feature",          10,     _SIM_BENCH_ClearFeature },
+    { "control_set_address",            10,     _SIM_BENCH_SetAddress },
+    { "control_get_descriptor_device",  10,     _SIM_BENCH_GetDescriptorDevice },
+    { "control_get_descriptor_config",  10,     _SIM_BENCH_GetDescriptorConfiguration },
+    { "control_get_descriptor_string",  10,     _SIM_BENCH_GetDescriptorString },
+    { "control_get_configuration",      10,     _SIM_BENCH_GetConfiguration },
+    { "control_set_configuration",      10,     _SIM_BENCH_SetConfiguration },
+    { "control_get_interface",          10,     _SIM_BENCH_GetInterface },
+    { "control_hid_get_report_descriptor", 10,  _SIM_BENCH_HidGetReportDescriptor },
+    { "control_hid_get_idle",           10,     _SIM_BENCH_HidGetIdle },
+    { "enumeration",                    100,    _SIM_BENCH_Enumeration },
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Measurement
+// *****************************************************************************
+// *****************************************************************************
+
+static void _SIM_BENCH_PerfOpen(void)
+{
+    struct perf_event_attr attr;
+
+    memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = PERF_COUNT_HW_INSTRUCTIONS;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+
+    simBenchPerfFd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+}
+
+static uint64_t _SIM_BENCH_NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static void _SIM_BENCH_Run(FILE * out, const SIM_BENCH * bench, unsigned long iterations, bool isLast)
+{
+    unsigned long i;
+    uint64_t start;
+    uint64_t elapsed;
+    uint64_t instructions = 0;
+    unsigned long failures;
+
+    if(iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    for(i = 0; i < SIM_BENCH_WARMUP / bench->divisor; i++)
+    {
+        bench->operation();
+    }
+
+    failures = simBenchFailures;
+
+    if(simBenchPerfFd >= 0)
+    {
+        ioctl(simBenchPerfFd, PERF_EVENT_IOC_RESET, 0);
+        ioctl(simBenchPerfFd, PERF_EVENT_IOC_ENABLE, 0);
+    }
+
+    start = _SIM_BENCH_NowNs();
+    for(i = 0; i < iterations; i++)
+    {
+        bench->operation();
+    }
+    elapsed = _SIM_BENCH_NowNs() - start;
+
+    if(simBenchPerfFd >= 0)
+    {
+        ioctl(simBenchPerfFd, PERF_EVENT_IOC_DISABLE, 0);
+        if(read(simBenchPerfFd, &instructions, sizeof(instructions)) != sizeof(instructions))
+        {
+            instructions = 0;
+        }
+    }
+
+    fprintf(out, "    { \"name\": \"%s\", \"iterations\": %lu, \"ns_per_op\": %.1f, ",
+            bench->name, iterations, (double)elapsed / (double)iterations);
+
+    if(simBenchPerfFd >= 0)
+    {
+        fprintf(out, "\"instructions_per_op\": %.1f, ", (double)instructions / (double)iterations);
+    }
+    else
+    {
+        fprintf(out, "\"instructions_per_op\": null, ");
+    }
+
+    fprintf(out, "\"errors\": %lu }%s\n", simBenchFailures - failures, isLast ? "" : ",");
+}
+
+static void _SIM_BENCH_LatencyPasses(unsigned int passes)
+{
+    size_t length;
+
+    while(passes-- > 0U)
+    {
+        SIM_USB_StartOfFrame();
+        SIM_TasksRun(1);
+
+        /* The host reads whatever the interfaces have */
+        (void)SIM_USB_In(1, simBenchData, &length);
+        (void)SIM_USB_In(2, simBenchData, &length);
+        (void)SIM_USB_In(5, simBenchData, &length);
+    }
+}
+
+static void _SIM_BENCH_LatencyButton(GPIO_PIN pin, unsigned int holdPasses)
+{
+    SIM_GPIO_PinWrite(pin, false);
+    _SIM_BENCH_LatencyPasses(holdPasses);
+    SIM_GPIO_PinWrite(pin, true);
+    _SIM_BENCH_LatencyPasses(300U);
+}
+
+static void _SIM_BENCH_LatencyWorkload(void)
+{
+    static const uint8_t command[2][2] = { { 0x01, 0x01 }, { 0x01, 0x02 } };
+    static const uint8_t encoderCW[4] = { 0x1, 0x3, 0x2, 0x0 };
+    unsigned int mode;
+    unsigned int step;
+
+    for(mode = 0; mode < 2U; mode++)
+    {
+        /* YouTube mode first, which also counts as the heartbeat, then media
+           mode */
+        (void)SIM_USB_Out(2, command[mode], sizeof(command[mode]));
+
+        _SIM_BENCH_LatencyButton(MECH_SW_NEXT_PIN, 10U);
+        _SIM_BENCH_LatencyButton(MECH_SW_PREV_PIN, SIM_BENCH_LATENCY_HOLD_PASSES);
+        _SIM_BENCH_LatencyButton(MECH_SW_PLAY_PIN, 10U);
+        _SIM_BENCH_LatencyButton(ENCODER_SW_PIN, 10U);
+
+        for(step = 0; step < 8U; step++)
+        {
+            SIM_GPIO_PinWrite(ENCODER_CH_A_PIN, (encoderCW[step % 4U] & 0x1U) != 0U);
+            SIM_GPIO_PinWrite(ENCODER_CH_B_PIN, (encoderCW[step % 4U] & 0x2U) != 0U);
+            _SIM_BENCH_LatencyPasses(1U);
+        }
+        _SIM_BENCH_LatencyPasses(300U);
+    }
+}
+
+static void _SIM_BENCH_Latency(FILE * out, unsigned long iterations)
+{
+    SIM_LATENCY latency;
+    SIM_LATENCY round;
+    uint64_t handlerMaxNs = 0;
+    unsigned long i;
+    size_t h;
+
+    memset(&latency, 0xFF, sizeof(latency));
+
+    if(iterations == 0)
+    {
+        iterations = 1;
+    }
+
+    for(i = 0; i < iterations; i++)
+    {
+        SIM_LatencyMeasure(true);
+        _SIM_BENCH_LatencyWorkload();
+        SIM_LatencyMeasure(false);
+        SIM_LatencyGet(&round);
+
+        for(h = 0; h < APP_LOAD_SLOTS; h++)
+        {
+            if(round.handlerNs[h] < latency.handlerNs[h])
+            {
+                latency.handlerNs[h] = round.handlerNs[h];
+            }
+        }
+        if(round.disabledNs < latency.disabledNs)
+        {
+            latency.disabledNs = round.disabledNs;
+        }
+    }
+
+    fprintf(out, "  \"usb_entry_latency\": {\n    \"iterations\": %lu,\n    \"handler_max_ns\": { ", iterations);
+
+    for(h = 0; h < sizeof(simBenchLatencyHandlers) / sizeof(simBenchLatencyHandlers[0]); h++)
+    {
+        fprintf(out, "\"%s\": %llu%s", simBenchLatencyHandlers[h].name,
+                (unsigned long long)latency.handlerNs[simBenchLatencyHandlers[h].slot],
+                (h + 1U < sizeof(simBenchLatencyHandlers) / sizeof(simBenchLatencyHandlers[0])) ? ", " : " },\n");
+
+        if(latency.handlerNs[simBenchLatencyHandlers[h].slot] > handlerMaxNs)
+        {
+            handlerMaxNs = latency.handlerNs[simBenchLatencyHandlers[h].slot];
+        }
+    }
+
+    /* Before the priority plan USB waited behind any handler, now only
+       behind a disabled section */
+    fprintf(out, "    \"shared_priority_max_ns\": %llu,\n    \"usb_priority_7_max_ns\": %llu\n  },\n",
+            (unsigned long long)handlerMaxNs, (unsigned long long)latency.disabledNs);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+
+int main(int argc, char ** argv)
+{
+    unsigned long iterations = SIM_BENCH_ITERATIONS_DEFAULT;
+    const char * filter = NULL;
+    FILE * out = stdout;
+    size_t count = sizeof(simBenches) / sizeof(simBenches[0]);
+    size_t last = count;
+    size_t i;
+    int option;
+
+    while((option = getopt(argc, argv, "n:f:o:")) != -1)
+    {
+        switch(option)
+        {
+            case 'n':
+                iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'f':
+                filter = optarg;
+                break;
+            case 'o':
+                out = fopen(optarg, "w");
+                if(out == NULL)
+                {
+                    perror(optarg);
+                    return 2;
+                }
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-n iterations] [-f filter] [-o file]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    SIM_ConsoleEnable(false);
+    SIM_Initialize();
+
+    if(!SIM_HOST_Enumerate())
+    {
+        fprintf(stderr, "enumeration failed\n");
+        return 1;
+    }
+
+    _SIM_BENCH_PerfOpen();
+
+    for(i = 0; i < count; i++)
+    {
+        if((filter == NULL) || (strstr(simBenches[i].name, filter) != NULL))
+        {
+            last = i;
+        }
+    }
+
+    fprintf(out, "{\n  \"suite\": \"usb_sim\",\n  \"instructions_counter\": \"%s\",\n  \"results\": [\n",
+            (simBenchPerfFd >= 0) ? "perf_event" : "unavailable");
+
+    for(i = 0; i < count; i++)
+    {
+        if((filter == NULL) || (strstr(simBenches[i].name, filter) != NULL))
+        {
+            _SIM_BENCH_Run(out, &simBenches[i], iterations / simBenches[i].divisor, i == last);
+        }
+    }
+
+    fprintf(out, "  ],\n");
+
+    if((filter == NULL) || (strstr("usb_entry_latency", filter) != NULL))
+    {
+        _SIM_BENCH_Latency(out, iterations / 1000UL);
+    }
+
+    fprintf(out, "  \"irp_callbacks\": %lu,\n  \"errors\": %lu\n}\n", simBenchCallbacks, simBenchFailures);
+
+    if(out != stdout)
+    {
+        fclose(out);
+    }
+
+    return (simBenchFailures == 0) ? 0 : 1;
+}
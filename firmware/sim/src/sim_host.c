@@ -0,0 +1,219 @@
+/*******************************************************************************
+  Host Simulator USB Host Helpers
+
+  File Name:
+    sim_host.c
+
+  Summary:
+    Control transfers and enumeration on top of the simulated bus.
+
+  Description:
+    Builds the transfers a USB host would run out of the single-token calls of
+    drv_usbfs_sim.c. Between tokens the firmware task loop is run so that the
+    device layer can queue the next IRP; a NAK is retried up to
+    SIM_HOST_NAK_RETRIES task passes before the transfer is given up.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static SIM_USB_HANDSHAKE _SIM_HOST_SetupRetry(const uint8_t * setup)
+{
+    SIM_USB_HANDSHAKE handshake = SIM_USB_HANDSHAKE_NAK;
+    unsigned int retries;
+
+    for(retries = 0; (retries < SIM_HOST_NAK_RETRIES) && (handshake == SIM_USB_HANDSHAKE_NAK); retries++)
+    {
+        SIM_TasksRun(1);
+        handshake = SIM_USB_Setup(setup);
+    }
+
+    return handshake;
+}
+
+static SIM_USB_HANDSHAKE _SIM_HOST_OutRetry(uint8_t endpoint, const uint8_t * data, size_t length)
+{
+    SIM_USB_HANDSHAKE handshake = SIM_USB_HANDSHAKE_NAK;
+    unsigned int retries;
+
+    for(retries = 0; (retries < SIM_HOST_NAK_RETRIES) && (handshake == SIM_USB_HANDSHAKE_NAK); retries++)
+    {
+        SIM_TasksRun(1);
+        handshake = SIM_USB_Out(endpoint, data, length);
+    }
+
+    return handshake;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Host Interface
+// *****************************************************************************
+// *****************************************************************************
+
+SIM_USB_HANDSHAKE SIM_HOST_InRetry(uint8_t endpoint, uint8_t * data, size_t * length)
+{
+    SIM_USB_HANDSHAKE handshake = SIM_USB_HANDSHAKE_NAK;
+    unsigned int retries;
+
+    for(retries = 0; (retries < SIM_HOST_NAK_RETRIES) && (handshake == SIM_USB_HANDSHAKE_NAK); retries++)
+    {
+        SIM_TasksRun(1);
+        handshake = SIM_USB_In(endpoint, data, length);
+    }
+
+    return handshake;
+}
+
+SIM_USB_HANDSHAKE SIM_HOST_ControlTransfer(const uint8_t * setup, uint8_t * data, size_t * length)
+{
+    SIM_USB_HANDSHAKE handshake;
+    uint16_t wLength = setup[6] | (setup[7] << 8);
+    uint16_t maxPacketSize;
+    uint8_t statusStage[64];
+    size_t transferred = 0;
+    size_t packet;
+
+    handshake = _SIM_HOST_SetupRetry(setup);
+    if(handshake != SIM_USB_HANDSHAKE_ACK)
+    {
+        return handshake;
+    }
+
+    maxPacketSize = SIM_USB_MaxPacketSizeGet(0, true);
+
+    if(setup[0] & USB_SETUP_DIRN_DEVICE_TO_HOST)
+    {
+        /* Data stage IN until a short packet or wLength, then OUT ZLP */
+        while(transferred < wLength)
+        {
+            handshake = SIM_HOST_InRetry(0, &data[transferred], &packet);
+            if(handshake != SIM_USB_HANDSHAKE_ACK)
+            {
+                return handshake;
+            }
+
+            transferred += packet;
+            if(packet < maxPacketSize)
+            {
+                break;
+            }
+        }
+
+        handshake = _SIM_HOST_OutRetry(0, statusStage, 0);
+    }
+    else
+    {
+        /* Data stage OUT, then IN ZLP */
+        while(transferred < wLength)
+        {
+            packet = wLength - transferred;
+            if(packet > maxPacketSize)
+            {
+                packet = maxPacketSize;
+            }
+
+            handshake = _SIM_HOST_OutRetry(0, &data[transferred], packet);
+            if(handshake != SIM_USB_HANDSHAKE_ACK)
+            {
+                return handshake;
+            }
+
+            transferred += packet;
+        }
+
+        handshake = SIM_HOST_InRetry(0, statusStage, &packet);
+    }
+
+    if(length != NULL)
+    {
+        *length = transferred;
+    }
+
+    return handshake;
+}
+
+bool SIM_HOST_Enumerate(void)
+{
+    uint8_t setup[8];
+    uint8_t buffer[SIM_HOST_BUFFER_SIZE];
+    size_t length;
+    uint16_t totalLength;
+    uint16_t i;
+
+    SIM_USB_VbusSet(true);
+    SIM_TasksRun(SIM_HOST_NAK_RETRIES);
+    if(!SIM_USB_IsAttached())
+    {
+        return false;
+    }
+
+    SIM_USB_BusReset();
+
+    /* GET_DESCRIPTOR(Device) */
+    memcpy(setup, (const uint8_t []){ 0x80, USB_REQUEST_GET_DESCRIPTOR, 0x00, USB_DESCRIPTOR_DEVICE, 0x00, 0x00, 0x12, 0x00 }, 8);
+    if((SIM_HOST_ControlTransfer(setup, buffer, &length) != SIM_USB_HANDSHAKE_ACK) || (length != 18))
+    {
+        return false;
+    }
+
+    /* SET_ADDRESS(1) */
+    memcpy(setup, (const uint8_t []){ 0x00, USB_REQUEST_SET_ADDRESS, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, 8);
+    if(SIM_HOST_ControlTransfer(setup, NULL, NULL) != SIM_USB_HANDSHAKE_ACK)
+    {
+        return false;
+    }
+
+    /* GET_DESCRIPTOR(Configuration), header then the whole set */
+    memcpy(setup, (const uint8_t []){ 0x80, USB_REQUEST_GET_DESCRIPTOR, 0x00, USB_DESCRIPTOR_CONFIGURATION, 0x00, 0x00, 0x09, 0x00 }, 8);
+    if((SIM_HOST_ControlTransfer(setup, buffer, &length) != SIM_USB_HANDSHAKE_ACK) || (length != 9))
+    {
+        return false;
+    }
+
+    totalLength = buffer[2] | (buffer[3] << 8);
+    if(totalLength > sizeof(buffer))
+    {
+        return false;
+    }
+
+    setup[6] = totalLength & 0xFF;
+    setup[7] = totalLength >> 8;
+    if((SIM_HOST_ControlTransfer(setup, buffer, &length) != SIM_USB_HANDSHAKE_ACK) || (length != totalLength))
+    {
+        return false;
+    }
+
+    /* GET_DESCRIPTOR(String) for the language table and strings 1 and 2 */
+    for(i = 0; i < 3; i++)
+    {
+        memcpy(setup, (const uint8_t []){ 0x80, USB_REQUEST_GET_DESCRIPTOR, (uint8_t)i, USB_DESCRIPTOR_STRING, 0x09, 0x04, 0xFF, 0x00 }, 8);
+        if(SIM_HOST_ControlTransfer(setup, buffer, &length) != SIM_USB_HANDSHAKE_ACK)
+        {
+            return false;
+        }
+    }
+
+    /* SET_CONFIGURATION(1) */
+    memcpy(setup, (const uint8_t []){ 0x00, USB_REQUEST_SET_CONFIGURATION, 0x01, 0x00, 0x00, 0x00, 0x00, 0x00 }, 8);
+    if(SIM_HOST_ControlTransfer(setup, NULL, NULL) != SIM_USB_HANDSHAKE_ACK)
+    {
+        return false;
+    }
+
+    SIM_TasksRun(SIM_HOST_TASK_PASSES);
+
+    return (SIM_USB_AddressGet() == 1);
+}
@@ -0,0 +1,785 @@
+/*******************************************************************************
+  Host Simulator Main
+
+  File Name:
+    sim_main.c
+
+  Summary:
+    Command interpreter that drives the simulated device.
+
+  Description:
+    Commands are read one per line from a script file, from stdin, or from a
+    client connected to a Unix domain socket (-s <path>). Blank lines and text
+    after '#' are ignored. Run "help" for the command list.
+
+    "expect" compares the data of the last IN token with the given bytes, "--"
+    standing for a byte of any value. The process exits with status 1 if any
+    expectation failed, so scripts can be run from a shell or CI job.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include "sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+#define SIM_LINE_SIZE           256
+#define SIM_LOOP_LINES          256
+#define SIM_ARGS_MAX            72
+
+typedef struct
+{
+    const char * name;
+    GPIO_PIN pin;
+
+} SIM_PIN_NAME;
+
+typedef struct
+{
+    FILE * out;
+
+    /* Data of the last IN token, for "expect" */
+    uint8_t lastIn[64];
+    size_t lastInLength;
+
+    /* Software timer armed by "timer start" and its expiries */
+    APP_TIME_HANDLE timer;
+    unsigned long timerFired;
+
+    /* APP_TIME_Counter64Get at "count mark" */
+    uint64_t countMark;
+
+    unsigned int failures;
+
+    bool quit;
+
+} SIM_SESSION;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static const SIM_PIN_NAME simPinNames[] =
+{
+    { "next",   MECH_SW_NEXT_PIN },
+    { "prev",   MECH_SW_PREV_PIN },
+    { "play",   MECH_SW_PLAY_PIN },
+    { "fn",     MECH_SW_FN_PIN },
+    { "mode",   MODE_SW_PIN },
+    { "encsw",  ENCODER_SW_PIN },
+    { "enca",   ENCODER_CH_A_PIN },
+    { "encb",   ENCODER_CH_B_PIN },
+    { "led",    LED_INDICATOR_PIN },
+};
+
+/* Indexed by APP_LED_PATTERN */
+static const char * const simLedPatternNames[] = { "off", "steady", "breathe", "code" };
+
+/* Gray code seen on CH_B:CH_A for one clockwise detent; the reverse order
+   is counter-clockwise. Matches ENCODER_CW in app.h. */
+static const uint8_t simEncoderCW[4] = { 0x1, 0x3, 0x2, 0x0 };
+
+static const char simHelp[] =
+    "vbus 0|1                 VBUS off/on\n"
+    "reset                    bus reset\n"
+    "suspend | resume         bus idle / resume\n"
+    "sof [n]                  n frames, one task pass after each\n"
+    "tasks [n]                n passes of the firmware task loop\n"
+    "setup b0 .. b7           one SETUP token\n"
+    "out ep [bytes]           one OUT token\n"
+    "in ep                    one IN token\n"
+    "poll ep                  IN token, retried on NAK\n"
+    "control bm req wValue wIndex wLength [bytes]\n"
+    "                         full control transfer\n"
+    "enumerate                VBUS, reset, descriptors, SET_CONFIGURATION 1\n"
+    "pin name|RAn|RBn 0|1     drive an input pin\n"
+    "press name | release name\n"
+    "get name|RAn|RBn         read a pin\n"
+    "encoder cw|ccw [n]       n detents, one frame per step\n"
+    "led [pattern [duty]]     show the LED pattern and OC3RS, or check them\n"
+    "timer start ms [periodic] | timer stop\n"
+    "timer [fired [on|off]]   show the expiries and TMR2 state, or check them\n"
+    "count advance ticks      move CP0 Count forward\n"
+    "count mark | count [ms]  64-bit count since the mark, or check it (within 1 s)\n"
+    "crash [code [epc [addr]]] exception: capture, then software reset\n"
+    "stall ms                 main loop stops, timers and the watchdog run on\n"
+    "resets [n]               show the device resets, or check them\n"
+    "expect [bytes]           compare the data of the last IN token, -- matches any\n"
+    "stats | clear            bus counters\n"
+    "console on|off           firmware console output\n"
+    "loop n ... end           repeat the enclosed lines\n"
+    "echo text | help | quit\n";
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static bool _SIM_PinParse(const char * name, GPIO_PIN * pin)
+{
+    size_t i;
+    char * end;
+    long number;
+
+    for(i = 0; i < (sizeof(simPinNames) / sizeof(simPinNames[0])); i++)
+    {
+        if(strcasecmp(name, simPinNames[i].name) == 0)
+        {
+            *pin = simPinNames[i].pin;
+            return true;
+        }
+    }
+
+    if((strncasecmp(name, "RA", 2) == 0) || (strncasecmp(name, "RB", 2) == 0))
+    {
+        number = strtol(&name[2], &end, 10);
+        if((*end == '\0') && (number >= 0) && (number < 16))
+        {
+            *pin = (GPIO_PIN)(((toupper((unsigned char)name[1]) == 'B') ? 16 : 0) + number);
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static size_t _SIM_BytesParse(char ** args, int count, uint8_t * bytes, size_t size)
+{
+    size_t length = 0;
+    int i;
+
+    for(i = 0; (i < count) && (length < size); i++)
+    {
+        bytes[length++] = (uint8_t)strtoul(args[i], NULL, 16);
+    }
+
+    return length;
+}
+
+static void _SIM_BytesPrint(FILE * out, const uint8_t * bytes, size_t length)
+{
+    size_t i;
+
+    for(i = 0; i < length; i++)
+    {
+        fprintf(out, " %02x", bytes[i]);
+    }
+}
+
+static void _SIM_InReport(SIM_SESSION * session, uint8_t endpoint, SIM_USB_HANDSHAKE handshake, const uint8_t * data, size_t length)
+{
+    fprintf(session->out, "in %u %s", endpoint, SIM_USB_HandshakeName(handshake));
+    if(handshake == SIM_USB_HANDSHAKE_ACK)
+    {
+        _SIM_BytesPrint(session->out, data, length);
+        memcpy(session->lastIn, data, length);
+        session->lastInLength = length;
+    }
+    else
+    {
+        session->lastInLength = 0;
+    }
+    fputc('\n', session->out);
+}
+
+static void _SIM_TimerCallback(uintptr_t context)
+{
+    ((SIM_SESSION *)context)->timerFired++;
+}
+
+static void _SIM_EncoderStep(uint8_t value)
+{
+    SIM_GPIO_PinWrite(ENCODER_CH_A_PIN, (value & 0x1) != 0);
+    SIM_GPIO_PinWrite(ENCODER_CH_B_PIN, (value & 0x2) != 0);
+
+    /* The application samples the encoder on SOF */
+    SIM_USB_StartOfFrame();
+    SIM_TasksRun(1);
+}
+
+static void _SIM_Execute(SIM_SESSION * session, int argc, char ** argv)
+{
+    FILE * out = session->out;
+    uint8_t buffer[SIM_HOST_BUFFER_SIZE];
+    size_t length;
+    SIM_USB_HANDSHAKE handshake;
+    SIM_USB_STATISTICS statistics;
+    GPIO_PIN pin;
+    unsigned long count;
+    unsigned long i;
+    int step;
+    bool matched;
+    const char * command = argv[0];
+
+    count = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1;
+
+    if(strcmp(command, "vbus") == 0)
+    {
+        SIM_USB_VbusSet(count != 0);
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+        fprintf(out, "vbus %lu attached %u\n", count, SIM_USB_IsAttached());
+    }
+    else if(strcmp(command, "reset") == 0)
+    {
+        SIM_USB_BusReset();
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if(strcmp(command, "suspend") == 0)
+    {
+        SIM_USB_Suspend();
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if(strcmp(command, "resume") == 0)
+    {
+        SIM_USB_Resume();
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if(strcmp(command, "sof") == 0)
+    {
+        for(i = 0; i < count; i++)
+        {
+            SIM_USB_StartOfFrame();
+            SIM_TasksRun(1);
+        }
+    }
+    else if(strcmp(command, "tasks") == 0)
+    {
+        SIM_TasksRun((unsigned int)count);
+    }
+    else if((strcmp(command, "setup") == 0) && (argc == 9))
+    {
+        _SIM_BytesParse(&argv[1], 8, buffer, 8);
+        fprintf(out, "setup %s\n", SIM_USB_HandshakeName(SIM_USB_Setup(buffer)));
+    }
+    else if((strcmp(command, "out") == 0) && (argc >= 2))
+    {
+        length = _SIM_BytesParse(&argv[2], argc - 2, buffer, 64);
+        fprintf(out, "out %lu %s\n", count, SIM_USB_HandshakeName(SIM_USB_Out((uint8_t)count, buffer, length)));
+    }
+    else if((strcmp(command, "in") == 0) && (argc == 2))
+    {
+        handshake = SIM_USB_In((uint8_t)count, buffer, &length);
+        _SIM_InReport(session, (uint8_t)count, handshake, buffer, length);
+    }
+    else if((strcmp(command, "poll") == 0) && (argc == 2))
+    {
+        handshake = SIM_HOST_InRetry((uint8_t)count, buffer, &length);
+        _SIM_InReport(session, (uint8_t)count, handshake, buffer, length);
+    }
+    else if((strcmp(command, "control") == 0) && (argc >= 6))
+    {
+        uint8_t setup[8];
+        uint16_t wValue = (uint16_t)strtoul(argv[3], NULL, 16);
+        uint16_t wIndex = (uint16_t)strtoul(argv[4], NULL, 16);
+        uint16_t wLength = (uint16_t)strtoul(argv[5], NULL, 16);
+
+        setup[0] = (uint8_t)strtoul(argv[1], NULL, 16);
+        setup[1] = (uint8_t)strtoul(argv[2], NULL, 16);
+        setup[2] = wValue & 0xFF;
+        setup[3] = wValue >> 8;
+        setup[4] = wIndex & 0xFF;
+        setup[5] = wIndex >> 8;
+        setup[6] = wLength & 0xFF;
+        setup[7] = wLength >> 8;
+
+        if(wLength > sizeof(buffer))
+        {
+            fprintf(out, "control wLength too large\n");
+            return;
+        }
+
+        memset(buffer, 0, sizeof(buffer));
+        _SIM_BytesParse(&argv[6], argc - 6, buffer, wLength);
+        handshake = SIM_HOST_ControlTransfer(setup, buffer, &length);
+
+        fprintf(out, "control %s", SIM_USB_HandshakeName(handshake));
+        if((handshake == SIM_USB_HANDSHAKE_ACK) && (setup[0] & USB_SETUP_DIRN_DEVICE_TO_HOST))
+        {
+            _SIM_BytesPrint(out, buffer, length);
+            memcpy(session->lastIn, buffer, (length < sizeof(session->lastIn)) ? length : sizeof(session->lastIn));
+            session->lastInLength = (length < sizeof(session->lastIn)) ? length : sizeof(session->lastIn);
+        }
+        fputc('\n', out);
+    }
+    else if(strcmp(command, "enumerate") == 0)
+    {
+        bool result = SIM_HOST_Enumerate();
+
+        fprintf(out, "enumerate %s address %u\n", result ? "ok" : "failed", SIM_USB_AddressGet());
+        if(!result)
+        {
+            session->failures++;
+        }
+    }
+    else if(((strcmp(command, "pin") == 0) && (argc == 3)) ||
+            (((strcmp(command, "press") == 0) || (strcmp(command, "release") == 0)) && (argc == 2)))
+    {
+        bool level = (argc == 3) ? (strtoul(argv[2], NULL, 0) != 0) : (strcmp(command, "release") == 0);
+
+        if(!_SIM_PinParse(argv[1], &pin))
+        {
+            fprintf(out, "unknown pin %s\n", argv[1]);
+            return;
+        }
+
+        /* Buttons are active low with pull-ups */
+        SIM_GPIO_PinWrite(pin, level);
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if((strcmp(command, "get") == 0) && (argc == 2))
+    {
+        if(!_SIM_PinParse(argv[1], &pin))
+        {
+            fprintf(out, "unknown pin %s\n", argv[1]);
+            return;
+        }
+
+        fprintf(out, "%s %u\n", argv[1], SIM_GPIO_PinRead(pin));
+    }
+    else if((strcmp(command, "encoder") == 0) && (argc >= 2))
+    {
+        count = (argc > 2) ? strtoul(argv[2], NULL, 0) : 1;
+
+        for(i = 0; i < count; i++)
+        {
+            for(step = 0; step < 4; step++)
+            {
+                _SIM_EncoderStep((strcmp(argv[1], "ccw") == 0) ? simEncoderCW[(6 - step) % 4] : simEncoderCW[step]);
+            }
+        }
+    }
+    else if(strcmp(command, "led") == 0)
+    {
+        APP_LED_PATTERN pattern = APP_LED_PatternGet();
+        uint16_t duty = APP_LED_DutyGet();
+
+        fprintf(out, "led %s duty %u\n", simLedPatternNames[pattern], duty);
+
+        matched = (argc < 2) || (strcmp(argv[1], simLedPatternNames[pattern]) == 0);
+        if(argc > 2)
+        {
+            matched = matched && (strtoul(argv[2], NULL, 0) == duty);
+        }
+
+        if(!matched)
+        {
+            fprintf(out, "led FAILED\n");
+            session->failures++;
+        }
+    }
+    else if((strcmp(command, "timer") == 0) && (argc >= 3) && (strcmp(argv[1], "start") == 0))
+    {
+        APP_TIME_TimerDestroy(session->timer);
+        session->timerFired = 0;
+        session->timer = APP_TIME_CallbackRegisterMS(_SIM_TimerCallback, (uintptr_t)session, strtoul(argv[2], NULL, 0),
+                ((argc > 3) && (strcmp(argv[3], "periodic") == 0)) ? APP_TIME_PERIODIC : APP_TIME_SINGLE);
+        if(session->timer == APP_TIME_HANDLE_INVALID)
+        {
+            fprintf(out, "timer FAILED\n");
+            session->failures++;
+        }
+    }
+    else if((strcmp(command, "timer") == 0) && (argc == 2) && (strcmp(argv[1], "stop") == 0))
+    {
+        APP_TIME_TimerDestroy(session->timer);
+        session->timer = APP_TIME_HANDLE_INVALID;
+    }
+    else if(strcmp(command, "timer") == 0)
+    {
+        bool running = (T2CON & _T2CON_ON_MASK) != 0U;
+
+        fprintf(out, "timer fired %lu tmr2 %s\n", session->timerFired, running ? "on" : "off");
+
+        matched = (argc < 2) || (count == session->timerFired);
+        if(argc > 2)
+        {
+            matched = matched && ((strcmp(argv[2], "on") == 0) == running);
+        }
+
+        if(!matched)
+        {
+            fprintf(out, "timer FAILED\n");
+            session->failures++;
+        }
+    }
+    else if((strcmp(command, "count") == 0) && (argc == 3) && (strcmp(argv[1], "advance") == 0))
+    {
+        SIM_CoreCountAdvance(strtoul(argv[2], NULL, 0));
+    }
+    else if((strcmp(command, "count") == 0) && (argc == 2) && (strcmp(argv[1], "mark") == 0))
+    {
+        session->countMark = APP_TIME_Counter64Get();
+    }
+    else if(strcmp(command, "count") == 0)
+    {
+        uint64_t elapsed = APP_TIME_Counter64ToUS(APP_TIME_Counter64Get() - session->countMark) / 1000U;
+
+        fprintf(out, "count %llu ms\n", (unsigned long long)elapsed);
+
+        if((argc > 1) && ((elapsed < count) || (elapsed >= (count + 1000U))))
+        {
+            fprintf(out, "count FAILED\n");
+            session->failures++;
+        }
+    }
+    else if(strcmp(command, "crash") == 0)
+    {
+        /* What the exception handlers in exceptions.c do, with the reset
+           simulated instead of APP_CRASH_Reset */
+        APP_CRASH_Capture(APP_CRASH_CAUSE_EXCEPTION, (uint8_t)((argc > 1) ? strtoul(argv[1], NULL, 16) : 0),
+                (argc > 2) ? (uint32_t)strtoul(argv[2], NULL, 16) : 0,
+                (argc > 3) ? (uint32_t)strtoul(argv[3], NULL, 16) : 0);
+        SIM_Reset(_RCON_SWR_MASK);
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if((strcmp(command, "stall") == 0) && (argc == 2))
+    {
+        SIM_MainLoopStall((unsigned int)count);
+        SIM_TasksRun(SIM_HOST_TASK_PASSES);
+    }
+    else if(strcmp(command, "resets") == 0)
+    {
+        fprintf(out, "resets %u\n", SIM_ResetCountGet());
+
+        if((argc > 1) && (SIM_ResetCountGet() != count))
+        {
+            fprintf(out, "resets FAILED\n");
+            session->failures++;
+        }
+    }
+    else if(strcmp(command, "expect") == 0)
+    {
+        length = _SIM_BytesParse(&argv[1], argc - 1, buffer, sizeof(buffer));
+        matched = (length == session->lastInLength);
+        for(i = 0; matched && (i < length); i++)
+        {
+            /* "--" accepts any value, for fields such as timestamps */
+            matched = (strcmp(argv[i + 1], "--") == 0) || (buffer[i] == session->lastIn[i]);
+        }
+
+        if(!matched)
+        {
+            fprintf(out, "expect FAILED, got");
+            _SIM_BytesPrint(out, session->lastIn, session->lastInLength);
+            fputc('\n', out);
+            session->failures++;
+        }
+    }
+    else if(strcmp(command, "stats") == 0)
+    {
+        SIM_USB_StatisticsGet(&statistics);
+        fprintf(out, "stats transactions %u naks %u stalls %u errors %u irps %u frames %u\n",
+                statistics.transactions, statistics.naks, statistics.stalls,
+                statistics.errors, statistics.irpsCompleted, statistics.frames);
+    }
+    else if(strcmp(command, "clear") == 0)
+    {
+        SIM_USB_StatisticsClear();
+    }
+    else if((strcmp(command, "console") == 0) && (argc == 2))
+    {
+        SIM_ConsoleEnable(strcmp(argv[1], "on") == 0);
+    }
+    else if(strcmp(command, "echo") == 0)
+    {
+        for(i = 1; i < (unsigned long)argc; i++)
+        {
+            fprintf(out, "%s%s", argv[i], (i + 1 < (unsigned long)argc) ? " " : "\n");
+        }
+    }
+    else if(strcmp(command, "help") == 0)
+    {
+        fputs(simHelp, out);
+    }
+    else if(strcmp(command, "quit") == 0)
+    {
+        session->quit = true;
+    }
+    else
+    {
+        fprintf(out, "unknown command: %s\n", command);
+        session->failures++;
+    }
+}
+
+static int _SIM_LineSplit(char * line, char ** argv)
+{
+    int argc = 0;
+    char * token;
+    char * comment = strchr(line, '#');
+
+    if(comment != NULL)
+    {
+        *comment = '\0';
+    }
+
+    for(token = strtok(line, " \t\r\n"); (token != NULL) && (argc < SIM_ARGS_MAX); token = strtok(NULL, " \t\r\n"))
+    {
+        argv[argc++] = token;
+    }
+
+    return argc;
+}
+
+static void _SIM_LinesRun(SIM_SESSION * session, char (* lines)[SIM_LINE_SIZE], size_t count);
+
+/* Runs one line. "loop n" reads the following lines up to the matching
+   "end" with next(), then runs them n times. */
+static void _SIM_LineRun(SIM_SESSION * session, const char * text, bool (* next)(void * source, char * line), void * source)
+{
+    char line[SIM_LINE_SIZE];
+    char * argv[SIM_ARGS_MAX];
+    char (* body)[SIM_LINE_SIZE];
+    size_t bodyCount = 0;
+    unsigned long repeat;
+    int depth = 1;
+    int argc;
+
+    strncpy(line, text, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+
+    argc = _SIM_LineSplit(line, argv);
+    if(argc == 0)
+    {
+        return;
+    }
+
+    if(strcmp(argv[0], "loop") != 0)
+    {
+        _SIM_Execute(session, argc, argv);
+        fflush(session->out);
+        return;
+    }
+
+    repeat = (argc > 1) ? strtoul(argv[1], NULL, 0) : 1;
+    body = calloc(SIM_LOOP_LINES, SIM_LINE_SIZE);
+    if(body == NULL)
+    {
+        return;
+    }
+
+    while((bodyCount < SIM_LOOP_LINES) && next(source, body[bodyCount]))
+    {
+        memcpy(line, body[bodyCount], sizeof(line));
+        argc = _SIM_LineSplit(line, argv);
+        if(argc > 0)
+        {
+            depth += (strcmp(argv[0], "loop") == 0) ? 1 : 0;
+            depth -= (strcmp(argv[0], "end") == 0) ? 1 : 0;
+        }
+
+        if(depth == 0)
+        {
+            break;
+        }
+
+        bodyCount++;
+    }
+
+    while((repeat-- > 0) && (!session->quit))
+    {
+        _SIM_LinesRun(session, body, bodyCount);
+    }
+
+    free(body);
+}
+
+typedef struct
+{
+    char (* lines)[SIM_LINE_SIZE];
+    size_t count;
+    size_t index;
+
+} SIM_LINE_ARRAY;
+
+static bool _SIM_LineArrayNext(void * source, char * line)
+{
+    SIM_LINE_ARRAY * array = source;
+
+    if(array->index >= array->count)
+    {
+        return false;
+    }
+
+    memcpy(line, array->lines[array->index++], SIM_LINE_SIZE);
+
+    return true;
+}
+
+static void _SIM_LinesRun(SIM_SESSION * session, char (* lines)[SIM_LINE_SIZE], size_t count)
+{
+    SIM_LINE_ARRAY array = { lines, count, 0 };
+    char line[SIM_LINE_SIZE];
+
+    while((!session->quit) && _SIM_LineArrayNext(&array, line))
+    {
+        _SIM_LineRun(session, line, _SIM_LineArrayNext, &array);
+    }
+}
+
+static bool _SIM_FileNext(void * source, char * line)
+{
+    return fgets(line, SIM_LINE_SIZE, (FILE *)source) != NULL;
+}
+
+static void _SIM_StreamRun(SIM_SESSION * session, FILE * in)
+{
+    char line[SIM_LINE_SIZE];
+
+    while((!session->quit) && _SIM_FileNext(in, line))
+    {
+        _SIM_LineRun(session, line, _SIM_FileNext, in);
+    }
+}
+
+static int _SIM_SocketServe(SIM_SESSION * session, const char * path)
+{
+    struct sockaddr_un address;
+    int server;
+    int client;
+    FILE * in;
+    FILE * out;
+
+    server = socket(AF_UNIX, SOCK_STREAM, 0);
+    if(server < 0)
+    {
+        perror("socket");
+        return 1;
+    }
+
+    memset(&address, 0, sizeof(address));
+    address.sun_family = AF_UNIX;
+    strncpy(address.sun_path, path, sizeof(address.sun_path) - 1);
+    unlink(path);
+
+    if((bind(server, (struct sockaddr *)&address, sizeof(address)) != 0) || (listen(server, 1) != 0))
+    {
+        perror(path);
+        close(server);
+        return 1;
+    }
+
+    /* One client at a time. The device keeps its state between clients;
+       "quit" from a client stops the simulator. */
+    while(!session->quit)
+    {
+        client = accept(server, NULL, NULL);
+        if(client < 0)
+        {
+            continue;
+        }
+
+        /* Separate streams, a single "r+" stream cannot switch direction
+           without a seek */
+        in = fdopen(client, "r");
+        out = fdopen(dup(client), "w");
+        if((in == NULL) || (out == NULL))
+        {
+            (in != NULL) ? fclose(in) : close(client);
+            if(out != NULL)
+            {
+                fclose(out);
+            }
+            continue;
+        }
+
+        setvbuf(out, NULL, _IOLBF, 0);
+        session->out = out;
+        _SIM_StreamRun(session, in);
+        session->out = stdout;
+        fclose(out);
+        fclose(in);
+    }
+
+    close(server);
+    unlink(path);
+
+    return 0;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Main Entry Point
+// *****************************************************************************
+// *****************************************************************************
+
+int main(int argc, char ** argv)
+{
+    SIM_SESSION session = { 0 };
+    const char * socketPath = NULL;
+    FILE * in = stdin;
+    int option;
+    int result = 0;
+
+    session.out = stdout;
+    session.timer = APP_TIME_HANDLE_INVALID;
+
+    while((option = getopt(argc, argv, "qs:")) != -1)
+    {
+        switch(option)
+        {
+            case 'q':
+                SIM_ConsoleEnable(false);
+                break;
+            case 's':
+                socketPath = optarg;
+                break;
+            default:
+                fprintf(stderr, "usage: %s [-q] [-s socket] [script]\n", argv[0]);
+                return 2;
+        }
+    }
+
+    if(optind < argc)
+    {
+        in = fopen(argv[optind], "r");
+        if(in == NULL)
+        {
+            perror(argv[optind]);
+            return 2;
+        }
+    }
+
+    SIM_Initialize();
+
+    if(socketPath != NULL)
+    {
+        result = _SIM_SocketServe(&session, socketPath);
+    }
+    else
+    {
+        _SIM_StreamRun(&session, in);
+    }
+
+    if(in != stdin)
+    {
+        fclose(in);
+    }
+
+    if(session.failures != 0)
+    {
+        fprintf(session.out == stdout ? stdout : stderr, "%u failure(s)\n", session.failures);
+        result = 1;
+    }
+
+    return result;
+}
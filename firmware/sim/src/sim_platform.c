@@ -0,0 +1,614 @@
+/*******************************************************************************
+  Host Simulator Platform
+
+  File Name:
+    sim_platform.c
+
+  Summary:
+    SFRs, system services and the task loop of the host simulator.
+
+  Description:
+    This file stands in for initialization.c, tasks.c and the system services
+    that the application and the USB device layer call. GPIO registers are
+    plain memory laid out like the device so that the real plib_gpio.c runs
+    unchanged; pin changes driven by the test host raise the change notice
+    interrupt by calling CHANGE_NOTICE_InterruptHandler directly. TMR3 and
+    OC3 are plain memory too; while TMR3 runs with its interrupt enabled,
+    every task loop pass counts as one period and calls
+    TIMER_3_InterruptHandler. TMR2, the software timer counter, counts
+    SIM_TMR2_COUNTS_PER_PASS (1 ms) per pass while it is on and calls
+    TIMER_2_InterruptHandler at each period match. CP0 Count follows the
+    host clock, and a pass in which it passes CP0 Compare calls
+    CORE_TIMER_InterruptHandler. The tasks and handlers are measured with
+    APP_LOAD_MEASURE as in tasks.c and interrupts.c. Console output goes to
+    stderr.
+
+    While SIM_LatencyMeasure is on, the longest run of each interrupt
+    handler and the longest stretch between SYS_INT_Disable and the
+    SYS_INT_Restore that enables interrupts again are kept in host
+    nanoseconds. They bound how long the USB interrupt can wait: behind a
+    whole handler when all vectors share one priority, only behind a
+    disabled section when USB has the highest.
+
+    The watchdog runs on CP0 Count, like the firmware that services it, while
+    WDTCON.ON is set. At the end of each pass, after the main loop has had
+    its chance to clear it, it resets the device (SIM_Reset) when its period
+    has passed or it was cleared before its window opened, with the values
+    of the configuration bits in initialization.c. Host scheduling delays
+    therefore never fire it, only a loop that stops clearing it. A reset
+    starts the firmware over without clearing its variables, which is how
+    the crash record in .persist behaves.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "sim.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Special Function Registers
+// *****************************************************************************
+// *****************************************************************************
+
+volatile uint32_t SIM_SFR_GPIO[2U * SIM_SFR_PORT_WORDS];
+
+/* IFS1, IFS1CLR, IFS1SET, IFS1INV, IEC1, IEC1CLR, IEC1SET, IEC1INV */
+volatile uint32_t SIM_SFR_INT[8];
+
+/* IFS0, IFS0CLR, IFS0SET, IFS0INV, IEC0, IEC0CLR, IEC0SET, IEC0INV */
+volatile uint32_t SIM_SFR_INT0[8];
+
+volatile uint32_t SIM_SFR_TMR2[12];
+volatile uint32_t SIM_SFR_TMR3[12];
+volatile uint32_t SIM_SFR_OC3[12];
+
+/* Power-on reset flags are set at start */
+volatile uint32_t SIM_SFR_RCON[4] = { _RCON_POR_MASK | _RCON_BOR_MASK };
+volatile uint32_t SIM_SFR_RSWRST[4];
+volatile uint32_t SIM_SFR_WDTCON[4];
+
+volatile __CFGCONbits_t CFGCONbits;
+volatile uint32_t SYSKEY, U1RXR, RPB15R, RPA4R;
+
+/* Direct access to a GPIO register word, without folding */
+#define SIM_GPIO_RAW(port, offset)          SIM_SFR_GPIO[((port) * SIM_SFR_PORT_WORDS) + ((offset) / 4U)]
+
+#define SIM_GPIO_TRIS                       0x10U
+#define SIM_GPIO_PORT                       0x20U
+#define SIM_GPIO_LAT                        0x30U
+#define SIM_GPIO_CNPU                       0x50U
+#define SIM_GPIO_CNCON                      0x70U
+#define SIM_GPIO_CNSTAT                     0x90U
+
+/* Watchdog period (WDTPS) and the time before its window opens
+   (FWDTWINSZ), in CP0 Count ticks */
+#define SIM_WDT_PERIOD_TICKS                (256U * 20000U)
+#define SIM_WDT_WINDOW_OPEN_TICKS           (128U * 20000U)
+
+/* TMR2 counts at 625 kHz */
+#define SIM_TMR2_COUNTS_PER_PASS            625U
+
+/* Offsets of the registers whose SET/CLR/INV aliases are folded */
+static const uint32_t simSFRGPIOOffset[] = { 0x00, 0x10, 0x30, 0x50, 0x60, 0x70, 0x80 };
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+SYSTEM_OBJECTS sysObj;
+
+static const APP_TIME_PLIB_INTERFACE simTimePlibAPI =
+{
+    .timerCallbackSet = (APP_TIME_PLIB_CALLBACK_REGISTER)TMR2_CallbackRegister,
+    .timerStart = (APP_TIME_PLIB_START)TMR2_Start,
+    .timerStop = (APP_TIME_PLIB_STOP)TMR2_Stop,
+    .timerFrequencyGet = (APP_TIME_PLIB_FREQUENCY_GET)TMR2_FrequencyGet,
+    .timerPeriodSet = (APP_TIME_PLIB_PERIOD_SET)TMR2_PeriodSet,
+    .timerCounterGet = (APP_TIME_PLIB_COUNTER_GET)TMR2_CounterGet,
+};
+
+static const APP_TIME_INIT simTimeInitData =
+{
+    .timePlib = &simTimePlibAPI,
+    .hwTimerIntNum = INT_SOURCE_TIMER_2,
+};
+
+/* Level driven onto each port by the test host, and which pins it drives.
+   Undriven inputs follow their pull-up, or read low. */
+static uint32_t simPinLevel[2];
+static uint32_t simPinDriven[2];
+
+static bool simConsoleEnabled = true;
+
+/* CP0 Count is the host clock plus simCoreCountOffset. simCoreCountSeen is
+   the count at the last core timer check. */
+static uint32_t simCoreCountOffset;
+static uint32_t simCoreCompare;
+static uint32_t simCoreCountSeen;
+
+/* CP0 Count when the watchdog was last cleared or turned on, and a clear
+   came too early */
+static bool simWdtIsOn;
+static uint32_t simWdtClearCount;
+static bool simWdtIsEarlyClear;
+
+static uint32_t simResets;
+
+/* Interrupts are enabled; SYS_INT_Disable nests like on the device */
+static bool simIntIsEnabled = true;
+
+static bool simLatencyIsMeasured;
+static uint64_t simIntDisabledStartNs;
+static SIM_LATENCY simLatency;
+
+/* The application's device layer handle, closed by SIM_Reset */
+extern APP_DATA appData;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static uint64_t _SIM_NowNs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+static void _SIM_LatencyHandlerRecord(APP_LOAD_SLOT slot, uint64_t startNs)
+{
+    uint64_t elapsed;
+
+    if(simLatencyIsMeasured)
+    {
+        elapsed = _SIM_NowNs() - startNs;
+        if(elapsed > simLatency.handlerNs[slot])
+        {
+            simLatency.handlerNs[slot] = elapsed;
+        }
+    }
+}
+
+/* Runs an interrupt handler the way interrupts.c does */
+#define SIM_ISR_RUN(slot, handler)                                          \
+    do {                                                                    \
+        uint64_t _simIsrStartNs = simLatencyIsMeasured ? _SIM_NowNs() : 0U; \
+        APP_LOAD_MEASURE((slot), handler);                                  \
+        _SIM_LatencyHandlerRecord((slot), _simIsrStartNs);                  \
+    } while(0)
+
+static void _SIM_SFR_Fold(volatile uint32_t * reg)
+{
+    /* reg[1..3] are the CLR, SET and INV aliases of reg[0] */
+    if((reg[1] | reg[2] | reg[3]) != 0U)
+    {
+        reg[0] = ((reg[0] & ~reg[1]) | reg[2]) ^ reg[3];
+        reg[1] = 0;
+        reg[2] = 0;
+        reg[3] = 0;
+    }
+}
+
+static void _SIM_TMR2_Advance(uint32_t counts)
+{
+    uint32_t toMatch;
+
+    while((counts > 0U) && ((SIM_SFR_TMR2[0] & _T2CON_ON_MASK) != 0U))
+    {
+        /* Counts up to and including the one that restarts from zero */
+        toMatch = (SIM_SFR_TMR2[8] - SIM_SFR_TMR2[4]) + 1U;
+
+        if(counts < toMatch)
+        {
+            SIM_SFR_TMR2[4] += counts;
+            break;
+        }
+
+        counts -= toMatch;
+        SIM_SFR_TMR2[4] = 0;
+        SIM_SFR_INT0[0] |= _IFS0_T2IF_MASK;
+
+        if((SIM_SFR_INT0[4] & _IEC0_T2IE_MASK) != 0U)
+        {
+            SIM_ISR_RUN(APP_LOAD_TIMER_2, TIMER_2_InterruptHandler());
+            SIM_SFR_Update();
+        }
+    }
+}
+
+static void _SIM_CoreTimerCheck(void)
+{
+    uint32_t count;
+
+    while(true)
+    {
+        /* Count reached Compare somewhere in (seen, count] */
+        count = SIM_CoreCountGet();
+        if((uint32_t)(simCoreCompare - simCoreCountSeen - 1U) >= (uint32_t)(count - simCoreCountSeen))
+        {
+            break;
+        }
+
+        simCoreCountSeen = simCoreCompare;
+        SIM_SFR_INT0[0] |= _IFS0_CTIF_MASK;
+
+        if((SIM_SFR_INT0[4] & _IEC0_CTIE_MASK) != 0U)
+        {
+            SIM_ISR_RUN(APP_LOAD_CORE_TIMER, CORE_TIMER_InterruptHandler());
+            SIM_SFR_Update();
+        }
+    }
+
+    simCoreCountSeen = count;
+}
+
+static void _SIM_WDT_Update(void)
+{
+    uint32_t count;
+    bool isOn;
+
+    _SIM_SFR_Fold(SIM_SFR_WDTCON);
+
+    isOn = (SIM_SFR_WDTCON[0] & _WDTCON_ON_MASK) != 0U;
+
+    /* WDTCLR reads back as zero */
+    if((isOn != simWdtIsOn) || ((SIM_SFR_WDTCON[0] & _WDTCON_WDTCLR_MASK) != 0U))
+    {
+        count = SIM_CoreCountGet();
+
+        if(isOn && simWdtIsOn)
+        {
+            simWdtIsEarlyClear = simWdtIsEarlyClear || ((count - simWdtClearCount) < SIM_WDT_WINDOW_OPEN_TICKS);
+        }
+
+        SIM_SFR_WDTCON[0] &= ~_WDTCON_WDTCLR_MASK;
+        simWdtIsOn = isOn;
+        simWdtClearCount = count;
+    }
+}
+
+/* Called between passes only, so the reset never cuts a task short */
+static void _SIM_WDT_Check(void)
+{
+    if(simWdtIsOn && (simWdtIsEarlyClear || ((SIM_CoreCountGet() - simWdtClearCount) >= SIM_WDT_PERIOD_TICKS)))
+    {
+        SIM_Reset(_RCON_WDTO_MASK);
+    }
+}
+
+static uint32_t _SIM_GPIO_PortLevelGet(uint32_t port)
+{
+    uint32_t tris = SIM_GPIO_RAW(port, SIM_GPIO_TRIS);
+    uint32_t lat = SIM_GPIO_RAW(port, SIM_GPIO_LAT);
+    uint32_t pullUp = SIM_GPIO_RAW(port, SIM_GPIO_CNPU);
+    uint32_t input = (simPinLevel[port] & simPinDriven[port]) | (pullUp & ~simPinDriven[port]);
+
+    return ((lat & ~tris) | (input & tris)) & 0xFFFFU;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Simulated Platform Interface
+// *****************************************************************************
+// *****************************************************************************
+
+void SIM_SFR_Update(void)
+{
+    uint32_t port;
+    uint32_t i;
+
+    for(port = 0; port < 2U; port++)
+    {
+        for(i = 0; i < (sizeof(simSFRGPIOOffset) / sizeof(simSFRGPIOOffset[0])); i++)
+        {
+            _SIM_SFR_Fold(&SIM_GPIO_RAW(port, simSFRGPIOOffset[i]));
+        }
+
+        SIM_GPIO_RAW(port, SIM_GPIO_PORT) = _SIM_GPIO_PortLevelGet(port);
+    }
+
+    _SIM_SFR_Fold(&SIM_SFR_INT[0]);
+    _SIM_SFR_Fold(&SIM_SFR_INT[4]);
+    _SIM_SFR_Fold(&SIM_SFR_INT0[0]);
+    _SIM_SFR_Fold(&SIM_SFR_INT0[4]);
+
+    for(i = 0; i < 12U; i += 4U)
+    {
+        _SIM_SFR_Fold(&SIM_SFR_TMR2[i]);
+        _SIM_SFR_Fold(&SIM_SFR_TMR3[i]);
+        _SIM_SFR_Fold(&SIM_SFR_OC3[i]);
+    }
+
+    _SIM_SFR_Fold(SIM_SFR_RCON);
+    _SIM_SFR_Fold(SIM_SFR_RSWRST);
+    _SIM_WDT_Update();
+}
+
+volatile uint32_t * SIM_SFR_Register(volatile uint32_t * reg)
+{
+    SIM_SFR_Update();
+
+    return reg;
+}
+
+void SIM_GPIO_PinWrite(GPIO_PIN pin, bool level)
+{
+    uint32_t port = (uint32_t)pin >> 4;
+    uint32_t mask = 1UL << ((uint32_t)pin & 0xFU);
+    uint32_t previous;
+    uint32_t changed;
+
+    SIM_SFR_Update();
+    previous = SIM_GPIO_RAW(port, SIM_GPIO_PORT);
+
+    simPinDriven[port] |= mask;
+    simPinLevel[port] = level ? (simPinLevel[port] | mask) : (simPinLevel[port] & ~mask);
+    SIM_GPIO_RAW(port, SIM_GPIO_PORT) = _SIM_GPIO_PortLevelGet(port);
+
+    changed = previous ^ SIM_GPIO_RAW(port, SIM_GPIO_PORT);
+    if((changed == 0U) || ((SIM_GPIO_RAW(port, SIM_GPIO_CNCON) & _CNCONA_ON_MASK) == 0U))
+    {
+        return;
+    }
+
+    /* Latch the mismatch and raise the change notice interrupt */
+    SIM_GPIO_RAW(port, SIM_GPIO_CNSTAT) |= changed;
+    SIM_SFR_INT[0] |= (port == 0U) ? _IFS1_CNAIF_MASK : _IFS1_CNBIF_MASK;
+
+    if((SIM_SFR_INT[4] & ((port == 0U) ? _IEC1_CNAIE_MASK : _IEC1_CNBIE_MASK)) != 0U)
+    {
+        SIM_ISR_RUN(APP_LOAD_CHANGE_NOTICE, CHANGE_NOTICE_InterruptHandler());
+    }
+
+    /* The handler read PORTx, which clears the mismatch */
+    SIM_GPIO_RAW(port, SIM_GPIO_CNSTAT) = 0;
+    SIM_SFR_Update();
+}
+
+bool SIM_GPIO_PinRead(GPIO_PIN pin)
+{
+    SIM_SFR_Update();
+
+    return (SIM_GPIO_RAW((uint32_t)pin >> 4, SIM_GPIO_PORT) >> ((uint32_t)pin & 0xFU)) & 0x1U;
+}
+
+void SIM_ConsoleEnable(bool enable)
+{
+    simConsoleEnabled = enable;
+}
+
+void SIM_Initialize(void)
+{
+    APP_BootPhaseRecord(APP_BOOT_PHASE_ENTRY);
+
+    memset((void *)SIM_SFR_GPIO, 0, sizeof(SIM_SFR_GPIO));
+
+    /* All pins are inputs out of reset */
+    SIM_GPIO_RAW(0U, SIM_GPIO_TRIS) = 0xFFFFU;
+    SIM_GPIO_RAW(1U, SIM_GPIO_TRIS) = 0xFFFFU;
+
+    GPIO_Initialize();
+    OCMP3_Initialize();
+    TMR3_Initialize();
+    TMR2_Initialize();
+    CORETIMER_Initialize();
+    SIM_SFR_Update();
+
+    sysObj.appTime = APP_TIME_Initialize(APP_TIME_INDEX_0, (SYS_MODULE_INIT *)&simTimeInitData);
+    APP_LOAD_Initialize();
+
+    sysObj.usbDevObject0 = USB_DEVICE_Initialize(USB_DEVICE_INDEX_0, (SYS_MODULE_INIT *)&usbDevInitData);
+    APP_BootPhaseRecord(APP_BOOT_PHASE_USB_INIT);
+
+    APP_Initialize();
+    SIM_SFR_Update();
+    APP_BootPhaseRecord(APP_BOOT_PHASE_INIT_DONE);
+}
+
+void SIM_TasksRun(unsigned int passes)
+{
+    while(passes-- > 0U)
+    {
+        SIM_USB_Tasks();
+        APP_LOAD_MEASURE(APP_LOAD_USB_DEVICE_TASKS, USB_DEVICE_Tasks(sysObj.usbDevObject0));
+        APP_LOAD_MEASURE(APP_LOAD_APP_TASKS, APP_Tasks());
+        SIM_SFR_Update();
+
+        /* The rest of the main loop in main.c */
+        APP_CRASH_WatchdogService();
+        SIM_SFR_Update();
+
+        /* One TMR3 period, and so one LED PWM period, per pass */
+        if(((SIM_SFR_TMR3[0] & _T3CON_ON_MASK) != 0U) && ((SIM_SFR_INT0[4] & _IEC0_T3IE_MASK) != 0U))
+        {
+            SIM_SFR_INT0[0] |= _IFS0_T3IF_MASK;
+            SIM_ISR_RUN(APP_LOAD_TIMER_3, TIMER_3_InterruptHandler());
+            SIM_SFR_Update();
+        }
+
+        _SIM_TMR2_Advance(SIM_TMR2_COUNTS_PER_PASS);
+        _SIM_CoreTimerCheck();
+        _SIM_WDT_Check();
+    }
+}
+
+void SIM_Reset(uint32_t resetFlags)
+{
+    simResets++;
+
+    /* The SFRs the firmware relies on being at their reset values */
+    memset((void *)SIM_SFR_INT, 0, sizeof(SIM_SFR_INT));
+    memset((void *)SIM_SFR_INT0, 0, sizeof(SIM_SFR_INT0));
+    memset((void *)SIM_SFR_TMR2, 0, sizeof(SIM_SFR_TMR2));
+    memset((void *)SIM_SFR_TMR3, 0, sizeof(SIM_SFR_TMR3));
+    memset((void *)SIM_SFR_OC3, 0, sizeof(SIM_SFR_OC3));
+    memset((void *)SIM_SFR_RSWRST, 0, sizeof(SIM_SFR_RSWRST));
+    memset((void *)SIM_SFR_WDTCON, 0, sizeof(SIM_SFR_WDTCON));
+    SIM_SFR_RCON[0] |= resetFlags;
+    simWdtIsOn = false;
+    simWdtIsEarlyClear = false;
+
+    /* The device layer keeps its client in RAM the startup code would have
+       cleared: release the application's handle so that it opens again */
+    if(appData.deviceHandle != USB_DEVICE_HANDLE_INVALID)
+    {
+        USB_DEVICE_Close(appData.deviceHandle);
+    }
+
+    SIM_USB_DeviceReset();
+    SIM_Initialize();
+}
+
+uint32_t SIM_ResetCountGet(void)
+{
+    return simResets;
+}
+
+void SIM_MainLoopStall(unsigned int milliseconds)
+{
+    uint32_t resets = simResets;
+
+    while((milliseconds-- > 0U) && (resets == simResets))
+    {
+        SIM_CoreCountAdvance(20000U);
+        _SIM_TMR2_Advance(SIM_TMR2_COUNTS_PER_PASS);
+        _SIM_CoreTimerCheck();
+        _SIM_WDT_Check();
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Core and System Service Stubs
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t SIM_CoreStatusGet(void)
+{
+    /* Interrupts are reported as enabled (IE set) */
+    return 0x1U;
+}
+
+uint32_t SIM_CoreCountGet(void)
+{
+    struct timespec now;
+
+    /* CP0 Count runs at SYSCLK / 2, 20 MHz */
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)now.tv_sec * 20000000ULL) + ((uint64_t)now.tv_nsec / 50U)) + simCoreCountOffset;
+}
+
+void SIM_CoreCompareSet(uint32_t compare)
+{
+    simCoreCompare = compare;
+    simCoreCountSeen = SIM_CoreCountGet();
+}
+
+void SIM_CoreCountAdvance(uint32_t ticks)
+{
+    simCoreCountOffset += ticks;
+}
+
+bool SYS_INT_Disable(void)
+{
+    bool state = simIntIsEnabled;
+
+    if(state && simLatencyIsMeasured)
+    {
+        simIntDisabledStartNs = _SIM_NowNs();
+    }
+
+    simIntIsEnabled = false;
+
+    return state;
+}
+
+void SYS_INT_Restore(bool state)
+{
+    uint64_t elapsed;
+
+    if(state && !simIntIsEnabled && simLatencyIsMeasured && (simIntDisabledStartNs != 0U))
+    {
+        elapsed = _SIM_NowNs() - simIntDisabledStartNs;
+        if(elapsed > simLatency.disabledNs)
+        {
+            simLatency.disabledNs = elapsed;
+        }
+    }
+
+    if(state)
+    {
+        simIntIsEnabled = true;
+        simIntDisabledStartNs = 0;
+    }
+}
+
+void SIM_LatencyMeasure(bool enable)
+{
+    if(enable)
+    {
+        memset(&simLatency, 0, sizeof(simLatency));
+        simIntDisabledStartNs = 0;
+    }
+
+    simLatencyIsMeasured = enable;
+}
+
+void SIM_LatencyGet(SIM_LATENCY * latency)
+{
+    *latency = simLatency;
+}
+
+bool EVIC_SourceStatusGet(INT_SOURCE source)
+{
+    volatile uint32_t * ifs = (source < 32) ? &SIM_SFR_INT0[0] : &SIM_SFR_INT[0];
+
+    SIM_SFR_Update();
+
+    return ((*ifs >> ((uint32_t)source & 0x1FU)) & 0x1U) != 0U;
+}
+
+SYS_ERROR_LEVEL SYS_DEBUG_ErrorLevelGet(void)
+{
+    return SYS_DEBUG_GLOBAL_ERROR_LEVEL;
+}
+
+SYS_MODULE_INDEX SYS_DEBUG_ConsoleInstanceGet(void)
+{
+    return SYS_CONSOLE_INDEX_0;
+}
+
+void SYS_CONSOLE_Print(const SYS_CONSOLE_HANDLE handle, const char * format, ...)
+{
+    va_list args;
+
+    if(simConsoleEnabled)
+    {
+        va_start(args, format);
+        vfprintf(stderr, format, args);
+        va_end(args);
+    }
+}
+
+void SYS_CONSOLE_Message(const SYS_CONSOLE_HANDLE handle, const char * message)
+{
+    if(simConsoleEnabled)
+    {
+        fputs(message, stderr);
+    }
+}
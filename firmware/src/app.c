@@ -25,8 +25,190 @@
 
 APP_DATA appData;
 
-MEDIA_CONTROLLER_INPUT_REPORT_T  __attribute__((aligned(16))) controllerInputReport USB_ALIGN;
+/* One input report for the consumer and one for the vendor instance, owned
+   by the driver while its send is pending. The keyboard has its own layout. */
+MEDIA_CONTROLLER_INPUT_REPORT_T  __attribute__((aligned(16))) controllerInputReport[APP_HID_VENDOR + 1] USB_ALIGN;
+MEDIA_CONTROLLER_KEYBOARD_REPORT_T  __attribute__((aligned(16))) controllerKeyboardReport USB_ALIGN;
+/* Absolute volume reports, the level in the byte after the report ID. They
+   share the instance's send slot with controllerInputReport. */
+MEDIA_CONTROLLER_INPUT_REPORT_T  __attribute__((aligned(16))) controllerVolumeReport[APP_HID_VENDOR + 1] USB_ALIGN;
+MEDIA_CONTROLLER_SEEK_REPORT_T  __attribute__((aligned(16))) controllerSeekReport USB_ALIGN;
+MEDIA_CONTROLLER_STATE_REPORT_T  __attribute__((aligned(16))) controllerStateReport USB_ALIGN;
 MEDIA_CONTROLLER_OUTPUT_REPORT_T  __attribute__((aligned(16))) controllerOutputReport USB_ALIGN;
+MEDIA_CONTROLLER_BOOT_REPORT_T  __attribute__((aligned(16))) controllerBootReport USB_ALIGN;
+MEDIA_CONTROLLER_LOAD_REPORT_T  __attribute__((aligned(16))) controllerLoadReport USB_ALIGN;
+MEDIA_CONTROLLER_RECOVERY_REPORT_T  __attribute__((aligned(16))) controllerRecoveryReport USB_ALIGN;
+MEDIA_CONTROLLER_CRASH_REPORT_T  __attribute__((aligned(16))) controllerCrashReport USB_ALIGN;
+
+/* YouTube mode actions. Set "isKeyboard" to send an action as the page's
+ * own shortcut on the keyboard interface, which works without the extension
+ * and skips its messaging. Next and previous stay with the extension, which
+ * also steps through chapters. Actions not listed, like Fn + mute, are
+ * vendor reports. */
+static const APP_YOUTUBE_ACTION appYoutubeActions[] = {
+    /* keycode                              isKeyboard  modifiers                           key */
+    { APP_KEY_PLAY,                         false,      0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_K },           // play/pause
+    { APP_KEY_MUTE,                         false,      0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_M },           // mute
+    { APP_KEY_VOLUME_UP,                    false,      0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_UP_ARROW },    // volume up
+    { APP_KEY_VOLUME_DOWN,                  false,      0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_DOWN_ARROW },  // volume down
+    { APP_KEY_NEXT,                         false,      APP_KEYBOARD_MODIFIER_LEFT_SHIFT,   USB_HID_KEYBOARD_KEYPAD_KEYBOARD_N },           // next video
+    { APP_KEY_PREV,                         false,      APP_KEYBOARD_MODIFIER_LEFT_SHIFT,   USB_HID_KEYBOARD_KEYPAD_KEYBOARD_P },           // previous video
+    { APP_KEY_FN | APP_KEY_VOLUME_UP,       true,       0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_RIGHT_ARROW }, // forward 5 s
+    { APP_KEY_FN | APP_KEY_VOLUME_DOWN,     true,       0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_LEFT_ARROW },  // backward 5 s
+    { APP_KEY_FN | APP_KEY_PREV,            true,       0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_I },           // mini player
+    { APP_KEY_FN | APP_KEY_PLAY,            true,       0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_T },           // theater mode
+    { APP_KEY_FN | APP_KEY_NEXT,            true,       0,                                  USB_HID_KEYBOARD_KEYPAD_KEYBOARD_F },           // full screen
+};
+
+/* Hold-to-repeat rate of next and previous: slow enough at first to stop
+ * after one or two extra skips, then fast enough to run through a playlist */
+static const APP_GESTURE_REPEAT_RATE appRepeatSkip = {
+    .delayMs = APP_REPEAT_DELAY_MS,
+    .intervalMs = APP_REPEAT_INTERVAL_MS,
+    .minIntervalMs = APP_REPEAT_INTERVAL_MIN_MS,
+    .accelerationPercent = APP_REPEAT_ACCELERATION_PERCENT,
+};
+
+/* Gestures in YouTube mode, see app_gesture.h. Buttons listed here wait
+ * until the gesture is known: next and previous tap at the end of the chord
+ * window, play after the double tap window. The encoder switch is not
+ * listed and acts on press; it mutes, so repeating it would only toggle.
+ * The Fn actions reach the YouTube shortcuts without holding Fn. Media
+ * mode has no gestures and every button is sent on press. */
+static const APP_GESTURE_ACTION appGestureActions[] = {
+    /* inputs                       gesture                     keycode                         rate */
+    { APP_KEY_NEXT,                 APP_GESTURE_REPEAT,         APP_KEY_NEXT,                   &appRepeatSkip },
+    { APP_KEY_PREV,                 APP_GESTURE_REPEAT,         APP_KEY_PREV,                   &appRepeatSkip },
+    { APP_KEY_PLAY,                 APP_GESTURE_DOUBLE_TAP,     APP_KEY_FN | APP_KEY_PLAY,      NULL },             // theater mode
+    { APP_KEY_PREV | APP_KEY_NEXT,  APP_GESTURE_CHORD,          APP_KEY_FN | APP_KEY_MUTE,      NULL },             // vendor report for the extension
+};
+
+/* Rate limits by APP_RATE, see app.h */
+static const APP_RATE_LIMIT appRateLimits[APP_RATE_COUNT] = {
+    /* framesPerEvent                   burst */
+    { APP_RATE_ENCODER_KEY_FRAMES,      APP_RATE_ENCODER_KEY_BURST },
+    { APP_RATE_VOLUME_LEVEL_FRAMES,     APP_RATE_VOLUME_LEVEL_BURST },
+    { APP_RATE_SEEK_FRAMES,             APP_RATE_SEEK_BURST },
+};
+
+/* Written before APP_Initialize runs, so it is left to the C startup to clear */
+static struct {
+    uint32_t count[APP_BOOT_PHASE_COUNT];
+    uint16_t phases;
+} appBootTime;
+
+void APP_BootPhaseRecord(APP_BOOT_PHASE phase)
+{
+    if (!(appBootTime.phases & (1U << phase))) {
+        appBootTime.count[phase] = APP_TIME_Counter32Get();
+        appBootTime.phases |= (1U << phase);
+    }
+}
+
+void APP_BootReportBuild(void)
+{
+    uint32_t entry = appBootTime.count[APP_BOOT_PHASE_ENTRY];
+    int phase;
+    
+    controllerBootReport.reportId = APP_BOOT_REPORT_ID;
+#if defined(SYS_FAST_BOOT)
+    controllerBootReport.flags = 0x01;
+#else
+    controllerBootReport.flags = 0x00;
+#endif
+    controllerBootReport.phases = appBootTime.phases;
+    controllerBootReport.microseconds[APP_BOOT_PHASE_ENTRY] = entry / APP_TIME_COUNTER_TICKS_PER_US;
+    
+    for (phase = APP_BOOT_PHASE_ENTRY + 1; phase < APP_BOOT_PHASE_COUNT; phase++) {
+        controllerBootReport.microseconds[phase] = (appBootTime.phases & (1U << phase)) ?
+                (appBootTime.count[phase] - entry) / APP_TIME_COUNTER_TICKS_PER_US : 0;
+    }
+}
+
+#if defined(APP_LOAD_ENABLE)
+static uint16_t APP_LoadSaturate(uint32_t value)
+{
+    return (value > 0xFFFFU) ? 0xFFFFU : (uint16_t)value;
+}
+
+static uint16_t APP_LoadShare(uint32_t cycles, uint32_t windowCycles)
+{
+    return (windowCycles == 0U) ? 0U : (uint16_t)(((uint64_t)cycles * 10000U) / windowCycles);
+}
+
+void APP_LoadReportBuild(void)
+{
+    APP_LOAD_STATISTICS statistics;
+    int slot;
+    
+    APP_LOAD_StatisticsGet(&statistics);
+    
+    controllerLoadReport.reportId = APP_LOAD_REPORT_ID;
+    controllerLoadReport.slots = APP_LOAD_SLOTS;
+    controllerLoadReport.window = (uint16_t)statistics.window;
+    controllerLoadReport.idle = APP_LoadShare(statistics.idleCycles, statistics.windowCycles);
+    
+    for (slot = 0; slot < APP_LOAD_SLOTS; slot++) {
+        controllerLoadReport.slot[slot].load = APP_LoadShare(statistics.slot[slot].cycles, statistics.windowCycles);
+        controllerLoadReport.slot[slot].count = APP_LoadSaturate(statistics.slot[slot].count);
+        controllerLoadReport.slot[slot].maxMicroseconds =
+                APP_LoadSaturate(statistics.slot[slot].maxCycles / APP_TIME_COUNTER_TICKS_PER_US);
+    }
+}
+
+#if (APP_LOAD_CONSOLE_WINDOWS > 0)
+/* Console names of the APP_LOAD_SLOT entries */
+static const char * const appLoadSlotNames[APP_LOAD_SLOTS] = {
+    "usb", "cn", "uart", "tmr2", "tmr3", "core", "usbfs", "device", "app"
+};
+
+static uint32_t appLoadConsoleWindow;
+
+/* One line every APP_LOAD_CONSOLE_WINDOWS windows: the share of each slot
+ * and of idle in 1/100 percent */
+static void APP_LoadConsolePrint(void)
+{
+    APP_LOAD_STATISTICS statistics;
+    int slot;
+    
+    if ((APP_LOAD_WindowGet() - appLoadConsoleWindow) < APP_LOAD_CONSOLE_WINDOWS) {
+        return;
+    }
+    
+    APP_LOAD_StatisticsGet(&statistics);
+    appLoadConsoleWindow = statistics.window;
+    
+    SYS_CONSOLE_PRINT("load");
+    for (slot = 0; slot < APP_LOAD_SLOTS; slot++) {
+        SYS_CONSOLE_PRINT(" %s %u", appLoadSlotNames[slot],
+                APP_LoadShare(statistics.slot[slot].cycles, statistics.windowCycles));
+    }
+    SYS_CONSOLE_PRINT(" idle %u\r\n", APP_LoadShare(statistics.idleCycles, statistics.windowCycles));
+}
+#endif
+#endif
+
+/* Error blink code over suspend breathing over the mode level. Called from
+ * the USB and change notice interrupts as well as from APP_Tasks. */
+void APP_IndicatorUpdate(void)
+{
+    if (appData.errorCode != APP_ERROR_NONE) {
+        APP_LED_BlinkCode(appData.errorCode);
+    } else if (appData.isSuspended) {
+        APP_LED_Breathe();
+    } else {
+        APP_LED_LevelSet(appData.isYoutubeMode ? APP_LED_LEVEL_YOUTUBE : APP_LED_LEVEL_MEDIA);
+    }
+}
+
+/* Keeps the lowest-numbered (most urgent) code when several are raised */
+void APP_ErrorSet(uint8_t errorCode)
+{
+    if (appData.errorCode == APP_ERROR_NONE || errorCode < appData.errorCode) {
+        appData.errorCode = errorCode;
+    }
+    APP_IndicatorUpdate();
+}
 
 USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
 (
@@ -36,21 +218,29 @@ USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
     uintptr_t userData
 ) {
     APP_DATA * appDataObject = (APP_DATA *)userData;
+    USB_DEVICE_HID_EVENT_DATA_GET_REPORT * getReport;
 
     switch(event)
     {
         case USB_DEVICE_HID_EVENT_REPORT_SENT:
 
-            /* This means the mouse report was sent.
-             We are free to send another report */
+            /* This means the report was sent.
+             We are free to send another report on this instance */
 
-            appDataObject->isReportSentComplete = true;
+            appDataObject->isReportSentComplete[hidInstance] = true;
+            APP_BootPhaseRecord(APP_BOOT_PHASE_FIRST_REPORT);
+            APP_CRASH_Trace(APP_CRASH_TRACE_REPORT, (uint8_t)hidInstance);
             break;
 
         case USB_DEVICE_HID_EVENT_REPORT_RECEIVED:
 
-            /* This means we have received a report */
+            /* This means the receive has completed. It completes aborted
+             * when the host switches the vendor interface to another
+             * alternate setting; the buffer is stale then, but a new
+             * receive has to be placed all the same. */
             appDataObject->isReportReceived = true;
+            appDataObject->isReportValid = (((USB_DEVICE_HID_EVENT_DATA_REPORT_RECEIVED *)eventData)->status
+                    == USB_DEVICE_HID_RESULT_OK);
             break;
 
         case USB_DEVICE_HID_EVENT_SET_IDLE:
@@ -59,14 +249,14 @@ USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
            USB_DEVICE_ControlStatus(appDataObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
 
             /* save Idle rate received from Host */
-            appDataObject->idleRate
+            appDataObject->idleRate[hidInstance]
                    = ((USB_DEVICE_HID_EVENT_DATA_SET_IDLE*)eventData)->duration;
             break;
 
         case USB_DEVICE_HID_EVENT_GET_IDLE:
 
             /* Host is requesting for Idle rate. Now send the Idle rate */
-            USB_DEVICE_ControlSend(appDataObject->deviceHandle, & (appDataObject->idleRate),1);
+            USB_DEVICE_ControlSend(appDataObject->deviceHandle, & (appDataObject->idleRate[hidInstance]),1);
 
             /* On successfully receiving Idle rate, the Host would acknowledge back with a
                Zero Length packet. The HID function driver returns an event
@@ -79,7 +269,7 @@ USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
 
         case USB_DEVICE_HID_EVENT_SET_PROTOCOL:
             /* Host is trying set protocol. Now receive the protocol and save */
-            appDataObject->activeProtocol
+            appDataObject->activeProtocol[hidInstance]
                 = ((USB_DEVICE_HID_EVENT_DATA_SET_PROTOCOL *)eventData)->protocolCode;
 
               /* Acknowledge the Control Write Transfer */
@@ -89,7 +279,7 @@ USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
         case  USB_DEVICE_HID_EVENT_GET_PROTOCOL:
 
             /* Host is requesting for Current Protocol. Now send the Idle rate */
-             USB_DEVICE_ControlSend(appDataObject->deviceHandle, &(appDataObject->activeProtocol), 1);
+             USB_DEVICE_ControlSend(appDataObject->deviceHandle, &(appDataObject->activeProtocol[hidInstance]), 1);
 
              /* On successfully receiving Idle rate, the Host would acknowledge
                back with a Zero Length packet. The HID function driver returns
@@ -99,6 +289,61 @@ USB_DEVICE_HID_EVENT_RESPONSE APP_USBDeviceHIDEventHandler
                this control transfer event is complete */
              break;
 
+        case USB_DEVICE_HID_EVENT_GET_REPORT:
+            
+            getReport = (USB_DEVICE_HID_EVENT_DATA_GET_REPORT *)eventData;
+            
+            /* Only the diagnostic feature reports of the vendor collection
+               can be read over EP0 */
+            if (hidInstance != APP_HID_VENDOR) {
+                USB_DEVICE_ControlStatus(appDataObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+            } else if (getReport->reportType == USB_HID_REPORT_TYPE_FEATURE
+                    && getReport->reportID == APP_BOOT_REPORT_ID) {
+                APP_BootReportBuild();
+                USB_DEVICE_ControlSend(appDataObject->deviceHandle, controllerBootReport.data,
+                        (getReport->reportLength < sizeof(controllerBootReport.data)) ?
+                        getReport->reportLength : sizeof(controllerBootReport.data));
+            } else if (getReport->reportType == USB_HID_REPORT_TYPE_FEATURE
+                    && getReport->reportID == APP_RECOVERY_REPORT_ID) {
+                APP_RecoveryReportBuild();
+                USB_DEVICE_ControlSend(appDataObject->deviceHandle, controllerRecoveryReport.data,
+                        (getReport->reportLength < sizeof(controllerRecoveryReport.data)) ?
+                        getReport->reportLength : sizeof(controllerRecoveryReport.data));
+            } else if (getReport->reportType == USB_HID_REPORT_TYPE_FEATURE
+                    && getReport->reportID == APP_CRASH_REPORT_ID) {
+                APP_CrashReportBuild();
+                USB_DEVICE_ControlSend(appDataObject->deviceHandle, controllerCrashReport.data,
+                        (getReport->reportLength < sizeof(controllerCrashReport.data)) ?
+                        getReport->reportLength : sizeof(controllerCrashReport.data));
+#if defined(APP_LOAD_ENABLE)
+            } else if (getReport->reportType == USB_HID_REPORT_TYPE_FEATURE
+                    && getReport->reportID == APP_LOAD_REPORT_ID) {
+                APP_LoadReportBuild();
+                USB_DEVICE_ControlSend(appDataObject->deviceHandle, controllerLoadReport.data,
+                        (getReport->reportLength < sizeof(controllerLoadReport.data)) ?
+                        getReport->reportLength : sizeof(controllerLoadReport.data));
+#endif
+            } else {
+                USB_DEVICE_ControlStatus(appDataObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+            }
+            break;
+
+        case USB_DEVICE_HID_EVENT_SET_REPORT:
+            
+            /* The keyboard LEDs are the only report written over EP0 */
+            if (hidInstance == APP_HID_KEYBOARD) {
+                USB_DEVICE_ControlReceive(appDataObject->deviceHandle, &appDataObject->keyboardLeds, 1);
+            } else {
+                USB_DEVICE_ControlStatus(appDataObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+            }
+            break;
+
+        case USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_RECEIVED:
+            
+            /* Data stage of the SET_REPORT above */
+            USB_DEVICE_ControlStatus(appDataObject->deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+            break;
+
         case USB_DEVICE_HID_EVENT_CONTROL_TRANSFER_DATA_SENT:
             break;
 
@@ -114,6 +359,10 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event,
 {
     USB_DEVICE_EVENT_DATA_CONFIGURED *configurationValue;
 
+    if (event != USB_DEVICE_EVENT_SOF) {
+        APP_CRASH_Trace(APP_CRASH_TRACE_USB_EVENT, (uint8_t)event);
+    }
+
     switch(event)
     {
         case USB_DEVICE_EVENT_SOF:
@@ -122,13 +371,32 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event,
              * by the switch process routine. */
             appData.sofEventHasOccurred = true;
             APP_ReadEncoder();
+            APP_RateRefill();
+            
+            /* Late binding: this frame's reports carry the input just read */
+            if (appData.isReportAtSof && appData.isConfigured) {
+                APP_InputReportsSend();
+            }
             break;
             
         case USB_DEVICE_EVENT_RESET:
+            APP_BootPhaseRecord(APP_BOOT_PHASE_RESET);
+            appData.isSuspended = false;
+            APP_IndicatorUpdate();
+            /* Fall through */
         case USB_DEVICE_EVENT_DECONFIGURED:
 
-            /* Device got de-configured */
+            /* Device got de-configured. The recovery is timed from the
+             * first reset of a configured device. */
+            if (appData.isConfigured) {
+                appData.isRecovering = true;
+                appData.recoveryStartCount = APP_TIME_Counter64Get();
+                if (appData.resets < UINT16_MAX) {
+                    appData.resets++;
+                }
+            }
             appData.isConfigured = false;
+            APP_StateReset();
             appData.state = APP_STATE_WAIT_FOR_CONFIGURATION;            
             break;
 
@@ -139,23 +407,49 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event,
             if(configurationValue->configurationValue == 1)
             {
                 appData.isConfigured = true;
+                if (appData.errorCode == APP_ERROR_USB_DEVICE) {
+                    appData.errorCode = APP_ERROR_NONE;
+                }
+                APP_IndicatorUpdate();
+                APP_BootPhaseRecord(APP_BOOT_PHASE_CONFIGURED);
 
-                /* Register the Application HID Event Handler. */
-                USB_DEVICE_HID_EventHandlerSet(appData.hidInstance,
+                /* Register the Application HID Event Handler with every
+                   instance. */
+                USB_DEVICE_HID_EventHandlerSet(APP_HID_CONSUMER,
+                        APP_USBDeviceHIDEventHandler, (uintptr_t)&appData);
+                USB_DEVICE_HID_EventHandlerSet(APP_HID_VENDOR,
+                        APP_USBDeviceHIDEventHandler, (uintptr_t)&appData);
+                USB_DEVICE_HID_EventHandlerSet(APP_HID_KEYBOARD,
                         APP_USBDeviceHIDEventHandler, (uintptr_t)&appData);
+                
+                /* Re-arm the output report here rather than on the next
+                 * task pass, so the host can write to it at once */
+                appData.isReportReceived = false;
+                USB_DEVICE_HID_ReportReceive(APP_HID_VENDOR, &appData.receiveTransferHandle,
+                        (uint8_t *)&controllerOutputReport,
+                        USB_DEVICE_HID_ReportReceiveSizeGet(APP_HID_VENDOR));
+                
+                if (appData.isRecovering) {
+                    APP_RecoveryRecord();
+                }
             }
             break;
 
         case USB_DEVICE_EVENT_SUSPENDED:
+            appData.isSuspended = true;
+            APP_IndicatorUpdate();
             break;
 
         case USB_DEVICE_EVENT_RESUMED:
+            appData.isSuspended = false;
+            APP_IndicatorUpdate();
             break; 
 
         case USB_DEVICE_EVENT_POWER_DETECTED:
             
             /* Attach the device */
             USB_DEVICE_Attach (appData.deviceHandle);
+            APP_BootPhaseRecord(APP_BOOT_PHASE_ATTACH);
             break;
 
         case USB_DEVICE_EVENT_POWER_REMOVED:
@@ -165,6 +459,9 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event,
             break;
             
         case USB_DEVICE_EVENT_ERROR:
+            APP_ErrorSet(APP_ERROR_USB_DEVICE);
+            break;
+            
         default:            
             break;
 
@@ -174,13 +471,65 @@ void APP_USBDeviceEventHandler(USB_DEVICE_EVENT event,
 void APP_ChangeMode(bool isYoutube) {
     
     appData.isYoutubeMode = isYoutube;
-    
-    if (appData.isYoutubeMode) {
-        LED_INDICATOR_Set();    
+    if (isYoutube) {
+        APP_GESTURE_ActionsSet(appGestureActions, sizeof(appGestureActions) / sizeof(appGestureActions[0]));
     } else {
-        LED_INDICATOR_Clear();    
-    } 
+        APP_GESTURE_ActionsSet(NULL, 0);
+    }
+    /* A seek or detents not sent yet belong to the player that is left */
+    appData.seekMilliseconds = 0;
+    appData.encoderSteps = 0;
+    APP_IndicatorUpdate();
+    
+}
+
+/* Runs in the TMR2 interrupt APP_HEARTBEAT_TIMEOUT_MS after the last
+ * heartbeat */
+void APP_HeartbeatTimeout(uintptr_t context) {
+    
+    /* A single timer is freed before its callback runs */
+    appData.heartbeatTimer = APP_TIME_HANDLE_INVALID;
+    appData.isExtensionAlive = false;
+}
+
+/* The extension is there: restarts the timeout */
+void APP_HeartbeatReceived() {
+    
+    bool isConnected;
+    bool interruptState = SYS_INT_Disable();
+    
+    /* With interrupts off, a timer that expired has either run its callback
+     * or is still allocated and is destroyed before it can */
+    if (appData.heartbeatTimer != APP_TIME_HANDLE_INVALID) {
+        APP_TIME_TimerDestroy(appData.heartbeatTimer);
+    }
+    appData.heartbeatTimer = APP_TIME_CallbackRegisterMS(APP_HeartbeatTimeout, 0,
+            APP_HEARTBEAT_TIMEOUT_MS, APP_TIME_SINGLE);
     
+    isConnected = !appData.isExtensionAlive;
+    appData.isExtensionAlive = true;
+    
+    SYS_INT_Restore(interruptState);
+    
+    if (isConnected) {
+        SYS_CONSOLE_PRINT("Extension connected\r\n");
+    }
+}
+
+/* The device changed its own state; the extension is told with the next
+ * state report. Called from the button interrupt. */
+void APP_StateChanged() {
+    
+    appData.stateSequence++;
+    appData.isStateReportPending = true;
+}
+
+/* YouTube mode and the extension is listening. Without the extension the
+ * vendor reports go nowhere, so what it would get is sent as media keys;
+ * the keyboard shortcuts need no extension and are not affected. */
+bool APP_IsVendorRouted() {
+    
+    return appData.isYoutubeMode && appData.isExtensionAlive;
 }
 
 void APP_OutputReportHandler() {
@@ -189,8 +538,13 @@ void APP_OutputReportHandler() {
             controllerOutputReport.reportId, 
             controllerOutputReport.command);
     
+    /* Any vendor output report shows the extension is running */
+    APP_HeartbeatReceived();
+    
     if (controllerOutputReport.reportId == 0x01) {                    
         
+        APP_CRASH_Trace(APP_CRASH_TRACE_COMMAND, controllerOutputReport.command);
+        
         switch (controllerOutputReport.command) {                        
             case 0x01: // Youtube
                 APP_ChangeMode(true);
@@ -198,78 +552,287 @@ void APP_OutputReportHandler() {
             case 0x02:
                 APP_ChangeMode(false);
                 break;
+            case 0x03: // absolute volume
+                appData.isVolumeAbsolute = true;
+                break;
+            case 0x04: // relative volume
+                appData.isVolumeAbsolute = false;
+                break;
+            case 0x05: // scrubbing seek
+                appData.isSeekScrub = true;
+                break;
+            case 0x06: // 5 s seek keys
+                appData.isSeekScrub = false;
+                break;
+            case 0x07: // heartbeat
+                break;
+            case 0x08: // resync, the state report is sent again
+                appData.isStateReportPending = true;
+                break;
+            case 0x09: // reports built at SOF
+                appData.isReportAtSof = true;
+                break;
+            case 0x0A: // reports built in the task loop
+                appData.isReportAtSof = false;
+                break;
+            case 0x0B: // the crash record was read
+                APP_CRASH_RecordClear();
+                break;
         }
         
+    } else if (controllerOutputReport.reportId == APP_VOLUME_REPORT_ID) {
+        
+        /* The extension tells the player's level, so the next detent
+         * steps from there */
+        appData.volumeLevel[APP_HID_VENDOR] = (controllerOutputReport.data[1] > APP_VOLUME_MAX)
+                ? APP_VOLUME_MAX : controllerOutputReport.data[1];
+        appData.volumeLevelSent[APP_HID_VENDOR] = appData.volumeLevel[APP_HID_VENDOR];
     }
     
 }
 
-void APP_KeyInputHandler(GPIO_PIN pin, uintptr_t context)
-{    
-    switch(pin) {
-        
-        case MECH_SW_NEXT_PIN: // scan next
-            SYS_CONSOLE_PRINT("Next\r\n");
-            appData.controllerKeycode.flags.next = MECH_SW_NEXT_Get() ? 0 : 1;
-            break;
-        
-        case MECH_SW_PREV_PIN:  // scan previous            
-            SYS_CONSOLE_PRINT("Previous\r\n");
-            appData.controllerKeycode.flags.prev  = MECH_SW_PREV_Get() ? 0 : 1;
-            break;
-            
-        case MECH_SW_PLAY_PIN:  // play and pause            
-            SYS_CONSOLE_PRINT("Play/Pause\r\n");
-            appData.controllerKeycode.flags.play = MECH_SW_PLAY_Get() ? 0 : 1;
-            break;
-            
-        case ENCODER_SW_PIN:            
-            SYS_CONSOLE_PRINT("Encodor\r\n");
-            appData.controllerKeycode.flags.mute = ENCODER_SW_Get() ? 0 : 1;
-            break;
-            
-        case MODE_SW_PIN:
-            if (MODE_SW_Get() == 0) {
-                SYS_CONSOLE_PRINT("Mode\r\n");
-                APP_ChangeMode(!appData.isYoutubeMode);
-            }
-            break;
-        default:
-            break;
+/* A recognized gesture presses its keys for one report, like a button.
+ * While the device is not configured, and until what was kept then has
+ * been sent, it is queued instead so that nothing merges or overtakes. */
+void APP_GestureHandler(uint8_t keycode) {
+    
+    if (appData.isConfigured && appData.eventCount == 0) {
+        appData.controllerKeycode.code |= keycode;
+    } else if (appData.eventCount < APP_EVENT_QUEUE_SIZE) {
+        appData.eventQueue[(appData.eventHead + appData.eventCount) % APP_EVENT_QUEUE_SIZE] = keycode;
+        appData.eventCount++;
+        if (appData.queuedEvents < UINT16_MAX) {
+            appData.queuedEvents++;
+        }
+    } else if (appData.lostEvents < UINT16_MAX) {
+        appData.lostEvents++;
+    }
+}
+
+/* Presses the oldest queued key event once no key is down on the host */
+void APP_EventQueueTake() {
+    
+    bool interruptState;
+    
+    if (appData.eventCount == 0 || appData.previousKeycode != 0 || appData.fullScreenSqeunceNumber > 0
+            || (appData.controllerKeycode.code & 0x3F)) {
+        return;
+    }
+    
+    /* The button and timer interrupts queue events */
+    interruptState = SYS_INT_Disable();
+    appData.controllerKeycode.code |= appData.eventQueue[appData.eventHead];
+    appData.eventHead = (appData.eventHead + 1) % APP_EVENT_QUEUE_SIZE;
+    appData.eventCount--;
+    SYS_INT_Restore(interruptState);
+}
+
+/* Configured again after a reset: the time it took */
+void APP_RecoveryRecord(void) {
+    
+    uint64_t microseconds = APP_TIME_Counter64ToUS(APP_TIME_Counter64Get() - appData.recoveryStartCount);
+    
+    appData.recoveryLastMicroseconds = (microseconds > UINT32_MAX) ? UINT32_MAX : (uint32_t)microseconds;
+    if (appData.recoveryLastMicroseconds > appData.recoveryMaxMicroseconds) {
+        appData.recoveryMaxMicroseconds = appData.recoveryLastMicroseconds;
+    }
+    appData.isRecovering = false;
+}
+
+void APP_RecoveryReportBuild(void) {
+    
+    controllerRecoveryReport.reportId = APP_RECOVERY_REPORT_ID;
+    controllerRecoveryReport.resets = appData.resets;
+    controllerRecoveryReport.lastMicroseconds = appData.recoveryLastMicroseconds;
+    controllerRecoveryReport.maxMicroseconds = appData.recoveryMaxMicroseconds;
+    controllerRecoveryReport.queuedEvents = appData.queuedEvents;
+    controllerRecoveryReport.lostEvents = appData.lostEvents;
+}
+
+void APP_CrashReportBuild(void) {
+    
+    const APP_CRASH_RECORD * record = APP_CRASH_RecordGet();
+    
+    controllerCrashReport.reportId = APP_CRASH_REPORT_ID;
+    controllerCrashReport.cause = record->cause;
+    controllerCrashReport.exceptionCode = record->exceptionCode;
+    controllerCrashReport.crashes = record->crashes;
+    controllerCrashReport.epc = record->epc;
+    controllerCrashReport.badAddress = record->badAddress;
+    memcpy(controllerCrashReport.trace, record->trace, sizeof(controllerCrashReport.trace));
+}
+
+/* Fn is held, or the keys come from a gesture that stands for Fn */
+bool APP_FnIsHeld(uint8_t code) {
+    
+    return !MECH_SW_FN_Get() || (code & APP_KEY_FN);
+}
+
+void APP_KeyInputHandler(GPIO_PORT port, uint32_t status, uintptr_t context)
+{
+    /* All buttons sit on PORTB. Simultaneous changes arrive in one call and
+     * the port is sampled once for all of them. */
+    uint32_t level = GPIO_PortRead(port);
+    
+    if (status & APP_PIN_MASK(MECH_SW_NEXT_PIN)) { // scan next
+        SYS_CONSOLE_PRINT("Next\r\n");
+        APP_GESTURE_InputSet(APP_KEY_NEXT, !(level & APP_PIN_MASK(MECH_SW_NEXT_PIN)));
+    }
+    
+    if (status & APP_PIN_MASK(MECH_SW_PREV_PIN)) { // scan previous
+        SYS_CONSOLE_PRINT("Previous\r\n");
+        APP_GESTURE_InputSet(APP_KEY_PREV, !(level & APP_PIN_MASK(MECH_SW_PREV_PIN)));
+    }
+    
+    if (status & APP_PIN_MASK(MECH_SW_PLAY_PIN)) { // play and pause
+        SYS_CONSOLE_PRINT("Play/Pause\r\n");
+        APP_GESTURE_InputSet(APP_KEY_PLAY, !(level & APP_PIN_MASK(MECH_SW_PLAY_PIN)));
+    }
+    
+    if (status & APP_PIN_MASK(ENCODER_SW_PIN)) {
+        SYS_CONSOLE_PRINT("Encodor\r\n");
+        APP_GESTURE_InputSet(APP_KEY_MUTE, !(level & APP_PIN_MASK(ENCODER_SW_PIN)));
+    }
+    
+    if ((status & APP_PIN_MASK(MODE_SW_PIN)) && !(level & APP_PIN_MASK(MODE_SW_PIN))) {
+        SYS_CONSOLE_PRINT("Mode\r\n");
+        APP_ChangeMode(!appData.isYoutubeMode);
+        APP_StateChanged();
+    }
+}
+
+
+/* Keyboard routed YouTube action of the keys, or NULL */
+const APP_YOUTUBE_ACTION * APP_KeyboardActionFind(uint8_t code) {
+    
+    uint8_t keycode;
+    size_t i;
+    
+    if (!appData.isYoutubeMode || !(code & 0x3F)) {
+        return NULL;
+    }
+    
+    keycode = (code & 0x3F) | (APP_FnIsHeld(code) ? APP_KEY_FN : 0);
+    
+    for (i = 0; i < sizeof(appYoutubeActions) / sizeof(appYoutubeActions[0]); i++) {
+        if (appYoutubeActions[i].keycode == keycode) {
+            return appYoutubeActions[i].isKeyboard ? &appYoutubeActions[i] : NULL;
+        }
     }
+    
+    return NULL;
+}
+
+/* HID instance of the next input report. Steps 6 to 3 of the full screen
+ * sequence are media keys and steps 2 and 1 go to the vendor channel, see
+ * APP_FullScreenSequnce. A keyboard action takes the keyboard until its
+ * key is released. Otherwise the mode decides. */
+USB_DEVICE_HID_INDEX APP_InputReportInstance(uint8_t code) {
+    
+    if (appData.fullScreenSqeunceNumber > 2) {
+        return APP_HID_CONSUMER;
+    } else if (appData.fullScreenSqeunceNumber > 0) {
+        return APP_HID_VENDOR;
+    } else if (appData.keyboardAction != NULL || APP_KeyboardActionFind(code) != NULL) {
+        return APP_HID_KEYBOARD;
+    }
+    
+    return APP_IsVendorRouted() ? APP_HID_VENDOR : APP_HID_CONSUMER;
+}
+
+/* Presses the shortcut of a keyboard action, or releases it once the keys
+ * no longer match */
+void APP_KeyboardReportSend(uint8_t code) {
+    
+    const APP_YOUTUBE_ACTION * action = APP_KeyboardActionFind(code);
+    
+    if (action == appData.keyboardAction) {
+        return;
+    }
+    
+    memset(controllerKeyboardReport.data, 0, sizeof(controllerKeyboardReport.data));
+    if (action != NULL) {
+        controllerKeyboardReport.modifiers = action->modifiers;
+        controllerKeyboardReport.keys[0] = action->key;
+    }
+    
+    USB_DEVICE_HID_ReportSend(APP_HID_KEYBOARD, &appData.sendTransferHandle[APP_HID_KEYBOARD],
+            controllerKeyboardReport.data, sizeof(controllerKeyboardReport.data));
+    
+    appData.isReportSentComplete[APP_HID_KEYBOARD] = false;
+    appData.keyboardAction = action;
+}
+
+/* Sends the device state to the extension. The pending flag is cleared
+ * before the state is read, so a change during the send sends again. */
+void APP_StateReportSend() {
+    
+    appData.isStateReportPending = false;
+    
+    controllerStateReport.sequence = appData.stateSequence;
+    controllerStateReport.flags = (appData.isYoutubeMode ? APP_STATE_YOUTUBE : 0)
+            | (appData.isVolumeAbsolute ? APP_STATE_VOLUME_ABSOLUTE : 0)
+            | (appData.isSeekScrub ? APP_STATE_SEEK_SCRUB : 0)
+            | (appData.isReportAtSof ? APP_STATE_REPORT_AT_SOF : 0);
+    
+    USB_DEVICE_HID_ReportSend(APP_HID_VENDOR, &appData.sendTransferHandle[APP_HID_VENDOR],
+            controllerStateReport.data, sizeof(controllerStateReport.data));
+    
+    appData.isReportSentComplete[APP_HID_VENDOR] = false;
 }
 
+/* Sends the scrubbing seek added up since the last report, as much of it
+ * as one report holds */
+void APP_SeekReportSend() {
+    
+    int32_t milliseconds;
+    bool interruptState;
+    
+    /* The encoder adds to the seek in the SOF event */
+    interruptState = SYS_INT_Disable();
+    milliseconds = appData.seekMilliseconds;
+    if (milliseconds > INT16_MAX) {
+        milliseconds = INT16_MAX;
+    } else if (milliseconds < -INT16_MAX) {
+        milliseconds = -INT16_MAX;
+    }
+    appData.seekMilliseconds -= milliseconds;
+    SYS_INT_Restore(interruptState);
+    
+    controllerSeekReport.milliseconds = (int16_t)milliseconds;
+    
+    USB_DEVICE_HID_ReportSend(APP_HID_VENDOR, &appData.sendTransferHandle[APP_HID_VENDOR],
+            controllerSeekReport.data, sizeof(controllerSeekReport.data));
+    
+    appData.isReportSentComplete[APP_HID_VENDOR] = false;
+}
 
-uint8_t APP_FullScreenSequnce() {
+uint8_t APP_FullScreenSequnce(MEDIA_CONTROLLER_KEYCODE_T *keycode, MEDIA_CONTROLLER_INPUT_REPORT_T *report) {
     
     switch(appData.fullScreenSqeunceNumber) {        
         case 6: // volume up
-            controllerInputReport.reportId = 0x02;
-            appData.controllerKeycode.code = 0x10;
+            keycode->code = 0x10;
             break;
             
         case 4: // volume down
-            controllerInputReport.reportId = 0x02;
-            appData.controllerKeycode.code = 0x20;
+            keycode->code = 0x20;
             break;
             
         case 2: // custom code
-            controllerInputReport.reportId = 0x01;
-            appData.controllerKeycode.code = 0x81;
+            keycode->code = 0x81;
             break;
             
         case 5:
         case 3:
-            controllerInputReport.reportId = 0x02;            
         case 1:
-            appData.controllerKeycode.code = 0x00;
+            keycode->code = 0x00;
             break;
             
         default:
             break;
     }
     
-    controllerInputReport.code = appData.controllerKeycode.code;
+    report->code = keycode->code;
     
     if (appData.fullScreenSqeunceNumber > 0) {
         appData.fullScreenSqeunceNumber--;
@@ -278,21 +841,84 @@ uint8_t APP_FullScreenSequnce() {
     return appData.fullScreenSqeunceNumber;
 }
 
-void APP_KeycodeToReport () {
+void APP_KeycodeToReport (MEDIA_CONTROLLER_KEYCODE_T *keycode, MEDIA_CONTROLLER_INPUT_REPORT_T *report) {
     
-    uint8_t funcFlag = MECH_SW_FN_Get() ? 0 : 1;
+    uint8_t funcFlag = APP_FnIsHeld(keycode->code) ? 1 : 0;
     
-    controllerInputReport.reportId = appData.isYoutubeMode ? 0x01 : 0x02;
-    appData.controllerKeycode.flags.func = funcFlag;
+    keycode->flags.func = funcFlag;
     
-    if (appData.isYoutubeMode && funcFlag && appData.controllerKeycode.flags.next 
+    if (APP_IsVendorRouted() && funcFlag && keycode->flags.next 
             && appData.fullScreenSqeunceNumber == 0) {
             appData.fullScreenSqeunceNumber = 6;
-            appData.controllerKeycode.code = 0;
+            keycode->code = 0;
     }   
     
-    controllerInputReport.code = appData.controllerKeycode.code;
+    report->code = keycode->code;
+    
+}
+
+/* Detents move the volume level: absolute volume is on, and Fn is not held
+ * in YouTube mode, where the encoder seeks */
+bool APP_VolumeIsAbsolute() {
+    
+    return appData.isVolumeAbsolute && !(appData.isYoutubeMode && !MECH_SW_FN_Get());
+}
+
+/* Detents add to the scrubbing seek: scrubbing is on, Fn is held and the
+ * extension takes the vendor reports */
+bool APP_SeekIsScrub() {
+    
+    return appData.isSeekScrub && APP_IsVendorRouted() && !MECH_SW_FN_Get();
+}
+
+/* Moves the volume level of the active instance by one detent. Returns false
+ * when the detent is a key instead, see APP_VolumeIsAbsolute. */
+bool APP_VolumeStep(bool isUp) {
+    
+    USB_DEVICE_HID_INDEX hidInstance = APP_IsVendorRouted() ? APP_HID_VENDOR : APP_HID_CONSUMER;
+    uint8_t level = appData.volumeLevel[hidInstance];
+    
+    if (!APP_VolumeIsAbsolute()) {
+        return false;
+    }
+    
+    if (isUp) {
+        level = (level > APP_VOLUME_MAX - APP_VOLUME_STEP) ? APP_VOLUME_MAX : level + APP_VOLUME_STEP;
+    } else {
+        level = (level < APP_VOLUME_STEP) ? 0 : level - APP_VOLUME_STEP;
+    }
+    
+    appData.volumeLevel[hidInstance] = level;
+    
+    return true;
+}
+
+/* Adds one detent to the scrubbing seek, further the faster the encoder is
+ * turned. Returns false when the detent is handled otherwise: scrubbing is
+ * off, not Fn in YouTube mode, or no extension to send it to. */
+bool APP_SeekStep(bool isForward) {
+    
+    uint32_t interval;
+    uint32_t milliseconds;
+    
+    if (!APP_SeekIsScrub()) {
+        return false;
+    }
+    
+    interval = APP_TIME_CounterElapsedUS(appData.seekDetentCount);
+    appData.seekDetentCount = APP_TIME_Counter32Get();
+    
+    if (interval >= APP_SEEK_SLOW_DETENT_US) {
+        milliseconds = APP_SEEK_DETENT_MS;
+    } else if (interval <= APP_SEEK_SLOW_DETENT_US / APP_SEEK_GAIN_MAX) {
+        milliseconds = APP_SEEK_DETENT_MS * APP_SEEK_GAIN_MAX;
+    } else {
+        milliseconds = (APP_SEEK_DETENT_MS * APP_SEEK_SLOW_DETENT_US) / interval;
+    }
+    
+    appData.seekMilliseconds += isForward ? (int32_t)milliseconds : -(int32_t)milliseconds;
     
+    return true;
 }
 
 void APP_ReadEncoder() {
@@ -306,17 +932,18 @@ void APP_ReadEncoder() {
          appData.encoderValue = (appData.encoderValue << 2) | encoder;        
         switch(appData.encoderValue) {
             case ENCODER_CW:                
-                appData.controllerKeycode.flags.volumeUp = 1;
+                if (!APP_SeekStep(true) && !APP_VolumeStep(true) && appData.encoderSteps < INT16_MAX) {
+                    appData.encoderSteps++;
+                }
                 break;
             case ENCODER_CCW:                
-                appData.controllerKeycode.flags.volumeDown = 1;
+                if (!APP_SeekStep(false) && !APP_VolumeStep(false) && appData.encoderSteps > -INT16_MAX) {
+                    appData.encoderSteps--;
+                }
                 break;
             default:                
                 break;               
         }
-    } else {
-        appData.controllerKeycode.flags.volumeUp = 0;
-        appData.controllerKeycode.flags.volumeDown = 0;
     }
     appData.previousEncoderPortValue =  encoder;
     
@@ -324,18 +951,254 @@ void APP_ReadEncoder() {
 
 
 
+/* One more frame of credit for every rate limit. Called from the SOF
+ * event. */
+void APP_RateRefill(void) {
+    
+    size_t i;
+    
+    for (i = 0; i < APP_RATE_COUNT; i++) {
+        if (appData.rateCredit[i] < appRateLimits[i].framesPerEvent * appRateLimits[i].burst) {
+            appData.rateCredit[i]++;
+        }
+    }
+}
+
+/* Takes the token of one report. False while the bucket is empty, and
+ * the report waits. */
+bool APP_RateTake(APP_RATE rate) {
+    
+    bool isTaken = true;
+    bool interruptState;
+    
+    if (appRateLimits[rate].framesPerEvent == 0) {
+        return true;
+    }
+    
+    interruptState = SYS_INT_Disable();
+    if (appData.rateCredit[rate] >= appRateLimits[rate].framesPerEvent) {
+        appData.rateCredit[rate] -= appRateLimits[rate].framesPerEvent;
+    } else {
+        isTaken = false;
+    }
+    SYS_INT_Restore(interruptState);
+    
+    return isTaken;
+}
+
+/* Moves the detents still counted as keys into the volume level or the
+ * scrubbing seek, once absolute volume or scrubbing takes them. The backlog
+ * then catches up in one report instead of one key per token. A merged
+ * detent seeks APP_SEEK_DETENT_MS, like its key. */
+void APP_EncoderStepsMerge() {
+    
+    USB_DEVICE_HID_INDEX hidInstance;
+    int32_t level;
+    bool interruptState;
+    
+    if (appData.encoderSteps == 0) {
+        return;
+    }
+    
+    /* The SOF event counts detents and moves the level and the seek */
+    interruptState = SYS_INT_Disable();
+    if (APP_SeekIsScrub()) {
+        appData.seekMilliseconds += (int32_t)appData.encoderSteps * APP_SEEK_DETENT_MS;
+        appData.encoderSteps = 0;
+    } else if (APP_VolumeIsAbsolute()) {
+        hidInstance = APP_IsVendorRouted() ? APP_HID_VENDOR : APP_HID_CONSUMER;
+        level = appData.volumeLevel[hidInstance] + (int32_t)appData.encoderSteps * APP_VOLUME_STEP;
+        if (level > APP_VOLUME_MAX) {
+            level = APP_VOLUME_MAX;
+        } else if (level < 0) {
+            level = 0;
+        }
+        appData.volumeLevel[hidInstance] = (uint8_t)level;
+        appData.encoderSteps = 0;
+    }
+    SYS_INT_Restore(interruptState);
+}
+
+/* Turns one counted encoder detent into a volume key press, when no key is
+ * down on the host and the rate limit allows. Every detent beyond the rate
+ * stays counted and goes out later, and turns in both directions cancel
+ * out, so the host ends at the right level. */
+void APP_EncoderKeyTake() {
+    
+    int16_t steps;
+    bool interruptState;
+    
+    APP_EncoderStepsMerge();
+    
+    steps = appData.encoderSteps;
+    
+    if (steps == 0 || appData.previousKeycode != 0 || appData.fullScreenSqeunceNumber > 0
+            || (appData.controllerKeycode.code & (APP_KEY_VOLUME_UP | APP_KEY_VOLUME_DOWN))
+            || !APP_RateTake(APP_RATE_ENCODER_KEY)) {
+        return;
+    }
+    
+    /* The SOF event counts detents */
+    interruptState = SYS_INT_Disable();
+    if (appData.encoderSteps > 0) {
+        appData.encoderSteps--;
+        appData.controllerKeycode.flags.volumeUp = 1;
+    } else if (appData.encoderSteps < 0) {
+        appData.encoderSteps++;
+        appData.controllerKeycode.flags.volumeDown = 1;
+    }
+    SYS_INT_Restore(interruptState);
+}
+
+/* Takes the pending keys for a report. The button and timer interrupts add
+ * keys, see APP_GestureHandler, so they are read and cleared together and
+ * a key added meanwhile is not lost. */
+uint8_t APP_KeycodeTake() {
+    
+    uint8_t code;
+    bool interruptState;
+    
+    interruptState = SYS_INT_Disable();
+    code = appData.controllerKeycode.code;
+    appData.controllerKeycode.code = 0;
+    SYS_INT_Restore(interruptState);
+    
+    return code;
+}
+
+/* Puts back taken keys that a report did not send */
+void APP_KeycodeReturn(uint8_t code) {
+    
+    bool interruptState;
+    
+    interruptState = SYS_INT_Disable();
+    appData.controllerKeycode.code |= code;
+    SYS_INT_Restore(interruptState);
+}
+
+/* Sends the next input report of each instance that is free. Called from
+ * the task loop, or from the SOF event with APP_REPORT_AT_SOF, where the
+ * report is built from the input read in the same event and is armed
+ * before the host's IN token of that frame. */
+void APP_InputReportsSend(void) {
+    
+    USB_DEVICE_HID_INDEX hidInstance;
+    MEDIA_CONTROLLER_KEYCODE_T keycode;
+    uint8_t keys;
+    
+    /* Before the instance is chosen: queued events first, in order, then
+     * the encoder; with Fn the encoder key is a keyboard seek */
+    APP_EventQueueTake();
+    APP_EncoderKeyTake();
+    
+    /* The report is built from the keys taken here; what it does not send
+     * is put back */
+    keycode.code = APP_KeycodeTake();
+    
+    /* Only the instance the report goes to has to be free. The full
+     * screen sequence crosses instances, so its steps also wait for
+     * the other one to stay in order. */
+    hidInstance = APP_InputReportInstance(keycode.code);
+    
+    if (hidInstance == APP_HID_KEYBOARD) {
+        
+        if (appData.isReportSentComplete[APP_HID_KEYBOARD]) {
+            
+            APP_KeyboardReportSend(keycode.code);
+            
+            appData.previousKeycode = keycode.code & 0x3F;
+        } else {
+            APP_KeycodeReturn(keycode.code);
+        }
+    } else if (appData.isReportSentComplete[hidInstance] && (appData.fullScreenSqeunceNumber == 0
+            || (appData.isReportSentComplete[APP_HID_CONSUMER] && appData.isReportSentComplete[APP_HID_VENDOR]))) {
+        
+        keys = keycode.code & 0x3F;
+        
+        if (appData.fullScreenSqeunceNumber == 0 && keys != 0 && appData.previousKeycode != 0) {
+            
+            /* A key is still down on the host. It is released first, so the
+             * new press is an edge; the press stays pending for the next
+             * report. */
+            controllerInputReport[hidInstance].code = 0;
+            
+            USB_DEVICE_HID_ReportSend(hidInstance, &appData.sendTransferHandle[hidInstance],
+                (uint8_t *)&controllerInputReport[hidInstance], sizeof(MEDIA_CONTROLLER_INPUT_REPORT_T));
+            
+            appData.isReportSentComplete[hidInstance] = false;
+            appData.previousKeycode = 0;
+            APP_KeycodeReturn(keycode.code);
+            return;
+        }
+        
+        if (keys != appData.previousKeycode || appData.fullScreenSqeunceNumber > 0) {
+                                
+            if (appData.fullScreenSqeunceNumber > 0) {
+                APP_FullScreenSequnce(&keycode, &controllerInputReport[hidInstance]);                    
+            } else {
+                APP_KeycodeToReport(&keycode, &controllerInputReport[hidInstance]);    
+            }
+            
+            USB_DEVICE_HID_ReportSend(hidInstance, &appData.sendTransferHandle[hidInstance],
+                (uint8_t *)&controllerInputReport[hidInstance], sizeof(MEDIA_CONTROLLER_INPUT_REPORT_T));
+            
+            appData.isReportSentComplete[hidInstance] = false;
+        } else if (appData.volumeLevel[hidInstance] != appData.volumeLevelSent[hidInstance]
+                && APP_RateTake(APP_RATE_VOLUME_LEVEL)) {
+            
+            /* Only the latest level is sent, so detents turned while
+             * the last report was pending collapse into this one */
+            appData.volumeLevelSent[hidInstance] = appData.volumeLevel[hidInstance];
+            controllerVolumeReport[hidInstance].data[1] = appData.volumeLevelSent[hidInstance];
+            
+            USB_DEVICE_HID_ReportSend(hidInstance, &appData.sendTransferHandle[hidInstance],
+                (uint8_t *)&controllerVolumeReport[hidInstance], sizeof(MEDIA_CONTROLLER_INPUT_REPORT_T));
+            
+            appData.isReportSentComplete[hidInstance] = false;
+        } else if (hidInstance == APP_HID_VENDOR && appData.seekMilliseconds != 0
+                && APP_RateTake(APP_RATE_SEEK)) {
+            
+            APP_SeekReportSend();
+        }
+        
+        appData.previousKeycode = keycode.code & 0x3F;
+    } else {
+        APP_KeycodeReturn(keycode.code);
+    }
+    
+    /* The state report goes out when the vendor instance has
+     * nothing else to send, so it never holds up a key */
+    if (appData.isStateReportPending && appData.isReportSentComplete[APP_HID_VENDOR]
+            && appData.fullScreenSqeunceNumber == 0) {
+        APP_StateReportSend();
+    }
+}
+
+/* The host forgets every report on a reset: transfers are aborted and no
+ * key is down any more. Keys not sent yet, queued events, the mode and the
+ * encoder's counts are kept and go out after the next configuration. */
 void APP_StateReset(void)
 {
     appData.isReportReceived = false;
-    appData.isReportSentComplete = true;
-    memset(&controllerOutputReport.data, 0, 64);
+    appData.isReportSentComplete[APP_HID_CONSUMER] = true;
+    appData.isReportSentComplete[APP_HID_VENDOR] = true;
+    appData.isReportSentComplete[APP_HID_KEYBOARD] = true;
+    appData.keyboardAction = NULL;
+    appData.previousKeycode = 0;
     
 }
 
 void APP_Initialize ( void )
 {
+    size_t i;
+    
+    /* First, so the record of a crash that caused this reset is complete
+     * and the trace of this run starts here */
+    APP_CRASH_Initialize();
+    
     /* Place the App state machine in its initial state. */
     appData.state = APP_STATE_INIT;
+    appData.tracedState = APP_STATE_INIT;
 
     appData.deviceHandle = USB_DEVICE_HANDLE_INVALID;
     appData.isConfigured = false;
@@ -343,35 +1206,106 @@ void APP_Initialize ( void )
     /* Initialize the led state */
     memset(&controllerOutputReport.data, 0, 64);
 
-    /* Initialize the HID instance index.  */
-    appData.hidInstance = 0;
+    /* Each HID instance sends a single input report ID */
+    controllerInputReport[APP_HID_CONSUMER].reportId = APP_CONSUMER_REPORT_ID;
+    controllerInputReport[APP_HID_VENDOR].reportId = APP_VENDOR_REPORT_ID;
+    controllerVolumeReport[APP_HID_CONSUMER].reportId = APP_VOLUME_REPORT_ID;
+    controllerVolumeReport[APP_HID_VENDOR].reportId = APP_VOLUME_REPORT_ID;
+    controllerSeekReport.reportId = APP_SEEK_REPORT_ID;
+    controllerStateReport.reportId = APP_STATE_REPORT_ID;
 
     /* Initialize tracking variables */
     appData.isReportReceived = false;
-    appData.isReportSentComplete = true;    
+    appData.isReportSentComplete[APP_HID_CONSUMER] = true;    
+    appData.isReportSentComplete[APP_HID_VENDOR] = true;    
+    appData.isReportSentComplete[APP_HID_KEYBOARD] = true;    
+    appData.keyboardAction = NULL;
     
     appData.encoderValue = 0;
     appData.isYoutubeMode = false;
+    appData.isSuspended = false;
+    appData.errorCode = APP_ERROR_NONE;
     appData.previousEncoderPortValue = GPIO_PortRead(GPIO_PORT_A) & 0x03;
     appData.fullScreenSqeunceNumber = 0;
     
-    GPIO_PinInterruptCallbackRegister(MECH_SW_PREV_PIN, APP_KeyInputHandler, (uintptr_t)NULL);
-    GPIO_PinInterruptCallbackRegister(MECH_SW_NEXT_PIN, APP_KeyInputHandler, (uintptr_t)NULL);
-    GPIO_PinInterruptCallbackRegister(MECH_SW_PLAY_PIN, APP_KeyInputHandler, (uintptr_t)NULL);
-    GPIO_PinInterruptCallbackRegister(ENCODER_SW_PIN, APP_KeyInputHandler, (uintptr_t)NULL);
-    GPIO_PinInterruptCallbackRegister(MODE_SW_PIN, APP_KeyInputHandler, (uintptr_t)NULL);
+    appData.isVolumeAbsolute = APP_VOLUME_ABSOLUTE;
+    appData.volumeLevel[APP_HID_CONSUMER] = APP_VOLUME_INITIAL;
+    appData.volumeLevel[APP_HID_VENDOR] = APP_VOLUME_INITIAL;
+    appData.volumeLevelSent[APP_HID_CONSUMER] = APP_VOLUME_INITIAL;
+    appData.volumeLevelSent[APP_HID_VENDOR] = APP_VOLUME_INITIAL;
+    
+    appData.isSeekScrub = APP_SEEK_SCRUB;
+    appData.seekMilliseconds = 0;
+    appData.seekDetentCount = APP_TIME_Counter32Get() - (uint32_t)APP_TIME_USToCounter64(APP_SEEK_SLOW_DETENT_US);
+    
+    appData.isExtensionAlive = !APP_HEARTBEAT_REQUIRED;
+    appData.heartbeatTimer = APP_TIME_HANDLE_INVALID;
+    appData.stateSequence = 0;
+    appData.isStateReportPending = false;
+    appData.isReportAtSof = APP_REPORT_AT_SOF;
+    
+    appData.eventHead = 0;
+    appData.eventCount = 0;
+    appData.isRecovering = false;
+    appData.resets = 0;
+    appData.recoveryLastMicroseconds = 0;
+    appData.recoveryMaxMicroseconds = 0;
+    appData.queuedEvents = 0;
+    appData.lostEvents = 0;
+    
+    appData.encoderSteps = 0;
+    for (i = 0; i < APP_RATE_COUNT; i++) {
+        appData.rateCredit[i] = appRateLimits[i].framesPerEvent * appRateLimits[i].burst;
+    }
+    
+    /* Starts in media mode, without gestures */
+    APP_GESTURE_Initialize(NULL, 0, APP_GestureHandler);
+    
+    GPIO_PortInterruptCallbackRegister(GPIO_PORT_B, APP_KeyInputHandler, (uintptr_t)NULL);
     MECH_SW_PREV_InterruptEnable();
     MECH_SW_NEXT_InterruptEnable();
     MECH_SW_PLAY_InterruptEnable();
     ENCODER_SW_InterruptEnable();
     MODE_SW_InterruptEnable();
     
+    APP_LED_Initialize();
+    APP_IndicatorUpdate();
+    
+}
+
+/* Printed from the first APP_Tasks pass: with SYS_FAST_BOOT the console
+ * is only initialized after APP_Initialize, right before that pass */
+void APP_BannerPrint(void) {
+    
+    const APP_CRASH_RECORD * crash = APP_CRASH_RecordGet();
+    
     SYS_CONSOLE_PRINT("Youtube Media Controller %u\r\n", appData.previousEncoderPortValue);
     
+    if (crash->cause != APP_CRASH_CAUSE_NONE) {
+        SYS_CONSOLE_PRINT("crash %u: cause %u code %u epc %08lx\r\n", crash->crashes, crash->cause,
+                crash->exceptionCode, (unsigned long)crash->epc);
+    }
 }
 
 void APP_Tasks ( void )
 {   
+    APP_STATES traceState;
+
+#if defined(APP_LOAD_ENABLE) && (APP_LOAD_CONSOLE_WINDOWS > 0)
+    APP_LoadConsolePrint();
+#endif
+
+    /* The polling states follow each other on every pass, they are traced
+       as one so that they do not flood the trace */
+    traceState = appData.state;
+    if ((traceState == APP_STATE_CHECK_IF_CONFIGURED) || (traceState == APP_STATE_EMULATE_KEYBOARD)) {
+        traceState = APP_STATE_CHECK_FOR_OUTPUT_REPORT;
+    }
+    if (traceState != appData.tracedState) {
+        appData.tracedState = traceState;
+        APP_CRASH_Trace(APP_CRASH_TRACE_STATE, (uint8_t)traceState);
+    }
+
     /* Check the application's current state. */
     switch ( appData.state )
     {
@@ -384,6 +1318,8 @@ void APP_Tasks ( void )
 
             if(appData.deviceHandle != USB_DEVICE_HANDLE_INVALID)
             {
+                APP_BannerPrint();
+                
                 /* Register a callback with device layer to get event notification (for end point 0) */
                 USB_DEVICE_EventHandlerSet(appData.deviceHandle, APP_USBDeviceEventHandler, 0);
 
@@ -405,13 +1341,8 @@ void APP_Tasks ( void )
 
             if(appData.isConfigured)
             {
-                /* Initialize the flag and place a request for a
+                /* The configured event has placed the request for an
                  * output report */
-                appData.isReportReceived = false;
-
-                USB_DEVICE_HID_ReportReceive(appData.hidInstance, &appData.receiveTransferHandle,
-                        (uint8_t *)&controllerOutputReport, 64);
-
                 appData.state = APP_STATE_CHECK_IF_CONFIGURED;
             }
 
@@ -420,9 +1351,10 @@ void APP_Tasks ( void )
         case APP_STATE_CHECK_IF_CONFIGURED:
 
             /* This state is needed because the device can get
-             * unconfigured asynchronously. Any application state
-             * machine reset should happen within the state machine
-             * context only. */
+             * unconfigured asynchronously. The reset and configured
+             * events already reset and re-armed what the host forgot;
+             * doing it here as well could drop a report received after a
+             * quick reconfiguration. */
 
             if(appData.isConfigured)
             {
@@ -431,9 +1363,8 @@ void APP_Tasks ( void )
             else
             {
                 /* This means the device got de-configured.
-                 * We reset the state and the wait for configuration */
+                 * Wait for configuration */
 
-                APP_StateReset();
                 appData.state = APP_STATE_WAIT_FOR_CONFIGURATION;
             }
             break;
@@ -443,10 +1374,13 @@ void APP_Tasks ( void )
             if (appData.isReportReceived == true) {
                 
                 appData.isReportReceived = false;
-                USB_DEVICE_HID_ReportReceive(appData.hidInstance, &appData.receiveTransferHandle,
-                        (uint8_t *)&controllerOutputReport, 64);
+                USB_DEVICE_HID_ReportReceive(APP_HID_VENDOR, &appData.receiveTransferHandle,
+                        (uint8_t *)&controllerOutputReport,
+                        USB_DEVICE_HID_ReportReceiveSizeGet(APP_HID_VENDOR));
                 
-                APP_OutputReportHandler();             
+                if (appData.isReportValid) {
+                    APP_OutputReportHandler();
+                }
             }
 
             appData.state = APP_STATE_EMULATE_KEYBOARD;
@@ -454,27 +1388,11 @@ void APP_Tasks ( void )
 
         case APP_STATE_EMULATE_KEYBOARD:
             
-            if(appData.isReportSentComplete)
+            /* With reports at SOF the SOF event sends them instead */
+            if(!appData.isReportAtSof)
             {
-                /* This means report can be sent*/
-                if ((appData.controllerKeycode.code && 0x3F) != appData.previousKeycode 
-                        || appData.fullScreenSqeunceNumber > 0) {
-                                        
-                    if (appData.fullScreenSqeunceNumber > 0) {
-                        APP_FullScreenSequnce();                    
-                    } else {
-                        APP_KeycodeToReport();    
-                    }
-                    
-                    USB_DEVICE_HID_ReportSend(appData.hidInstance, &appData.sendTransferHandle,
-                        (uint8_t *)&controllerInputReport, sizeof(MEDIA_CONTROLLER_INPUT_REPORT_T));
-                    
-                    appData.isReportSentComplete = false;
-                }
-                
-                appData.previousKeycode = appData.controllerKeycode.code & 0x3F;
-                appData.controllerKeycode.code = 0;
-             }
+                APP_InputReportsSend();
+            }
             
             appData.state = APP_STATE_CHECK_IF_CONFIGURED;
             break;
@@ -485,7 +1403,8 @@ void APP_Tasks ( void )
         /* The default state should never be executed. */
         default:
         {
-            /* TODO: Handle error in application's state machine. */
+            APP_ErrorSet(APP_ERROR_STATE);
+            appData.state = APP_STATE_ERROR;
             break;
         }
     }
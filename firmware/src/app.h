@@ -34,6 +34,9 @@
 #include "string.h"
 #include "configuration.h"
 #include "definitions.h"
+#include "app_led.h"
+#include "app_gesture.h"
+#include "app_crash.h"
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -52,6 +55,9 @@ extern "C" {
 #define ENCODER_CW   ((0x01 << 6) | (0x03 << 4) | (0x02 << 2) | 0x00)
 #define ENCODER_CCW   ((0x02 << 6) | (0x03 << 4) | (0x01 << 2) | 0x00)
 
+/* Bit of a GPIO_PIN within its port's CNSTATx/PORTx word */
+#define APP_PIN_MASK(pin)   (1UL << ((pin) & 0xF))
+
 typedef union
 {   
     struct {
@@ -69,6 +75,29 @@ typedef union
 
 } MEDIA_CONTROLLER_KEYCODE_T;
 
+/* MEDIA_CONTROLLER_KEYCODE_T bits, for the action tables */
+#define APP_KEY_NEXT            0x01
+#define APP_KEY_PREV            0x02
+#define APP_KEY_PLAY            0x04
+#define APP_KEY_MUTE            0x08
+#define APP_KEY_VOLUME_UP       0x10
+#define APP_KEY_VOLUME_DOWN     0x20
+#define APP_KEY_FN              0x80
+
+/* Absolute volume level report, input on the consumer and the vendor
+   instance and output on the vendor instance (APP_VOLUME_ABSOLUTE) */
+#define APP_VOLUME_REPORT_ID    0x05
+
+/* Scrubbing seek report, input on the vendor instance (APP_SEEK_SCRUB) */
+#define APP_SEEK_REPORT_ID      0x06
+
+/* Device state report, input on the vendor instance, and its flags */
+#define APP_STATE_REPORT_ID     0x07
+#define APP_STATE_YOUTUBE           0x01
+#define APP_STATE_VOLUME_ABSOLUTE   0x02
+#define APP_STATE_SEEK_SCRUB        0x04
+#define APP_STATE_REPORT_AT_SOF     0x08
+
 typedef union
 {
     
@@ -93,6 +122,254 @@ typedef union
     
 } MEDIA_CONTROLLER_OUTPUT_REPORT_T;
 
+/* Seek of a scrubbing report in milliseconds, negative backwards, little
+   endian. A longer seek is split over several reports. */
+typedef union
+{
+    struct __attribute__((packed)) {
+        uint8_t reportId;
+        int16_t milliseconds;
+    };
+
+    uint8_t data[3];
+
+} MEDIA_CONTROLLER_SEEK_REPORT_T;
+
+/* Device state, sent when it changes on the device and on a resync
+   command. The sequence counts the changes made on the device, so a gap
+   tells the host that it missed one; the flags (APP_STATE_*) are always
+   the current state. */
+typedef union
+{
+    struct {
+        uint8_t reportId;
+        uint8_t sequence;
+        uint8_t flags;
+    };
+
+    uint8_t data[3];
+
+} MEDIA_CONTROLLER_STATE_REPORT_T;
+
+/* Boot protocol keyboard input report. It has no report ID, so the report
+   protocol uses the same layout. */
+typedef union
+{
+    struct {
+        uint8_t modifiers;
+        uint8_t reserved;
+        uint8_t keys[6];
+    };
+
+    uint8_t data[8];
+
+} MEDIA_CONTROLLER_KEYBOARD_REPORT_T;
+
+/* Modifier bits of MEDIA_CONTROLLER_KEYBOARD_REPORT_T */
+#define APP_KEYBOARD_MODIFIER_LEFT_SHIFT    0x02
+
+// *****************************************************************************
+/* YouTube mode action
+
+  Summary:
+    How one key combination is sent in YouTube mode.
+
+  Description:
+    An action matches when the keys of a report, with APP_KEY_FN when Fn is
+    held, equal "keycode". With "isKeyboard" set the action is sent as
+    YouTube's own shortcut on the keyboard interface and the page handles it
+    without the extension. Otherwise it is sent as a vendor report for the
+    extension, and "modifiers" and "key" only document the shortcut.
+*/
+
+typedef struct
+{
+    uint8_t keycode;
+    bool isKeyboard;
+    uint8_t modifiers;
+    USB_HID_KEYBOARD_KEYPAD key;
+
+} APP_YOUTUBE_ACTION;
+
+// *****************************************************************************
+/* Report rate limits
+
+  Summary:
+    Token buckets of the reports the encoder can send faster than a host
+    acts on them.
+
+  Description:
+    Each bucket earns one token per "framesPerEvent" USB frames, up to
+    "burst" tokens, and every report it limits takes one. Without a token
+    the report waits and what it would carry keeps adding up: encoder
+    detents in a signed count, the volume level and the seek in their own
+    fields. Nothing is dropped, the host gets it later and merged.
+    framesPerEvent 0 turns a bucket off.
+*/
+
+typedef enum
+{
+    /* Encoder detents sent as keys: volume increment and decrement, or the
+       Fn seek keys */
+    APP_RATE_ENCODER_KEY = 0,
+
+    /* Report ID 5, absolute volume */
+    APP_RATE_VOLUME_LEVEL,
+
+    /* Report ID 6, scrubbing seek */
+    APP_RATE_SEEK,
+
+    APP_RATE_COUNT
+
+} APP_RATE;
+
+typedef struct
+{
+    uint16_t framesPerEvent;
+    uint8_t burst;
+
+} APP_RATE_LIMIT;
+
+/* HID function driver instances. The media keys and the vendor channel have
+   separate interfaces and interrupt endpoints, so a transfer pending on one
+   never holds up the other. */
+#define APP_HID_CONSUMER        USB_DEVICE_HID_INDEX_0
+#define APP_HID_VENDOR          USB_DEVICE_HID_INDEX_1
+#define APP_HID_KEYBOARD        USB_DEVICE_HID_INDEX_2
+#define APP_HID_INSTANCES       3
+
+/* Input reports of the consumer control and of the vendor collection */
+#define APP_CONSUMER_REPORT_ID  0x02
+#define APP_VENDOR_REPORT_ID    0x01
+
+/* Feature report that exports the boot timestamps (vendor collection) */
+#define APP_BOOT_REPORT_ID      0x03
+
+/* Feature report that exports the CPU load of the last window (vendor
+   collection) */
+#define APP_LOAD_REPORT_ID      0x04
+
+/* Feature report that exports the bus reset recovery counters (vendor
+   collection) */
+#define APP_RECOVERY_REPORT_ID  0x08
+
+/* Feature report that exports the crash record (vendor collection) */
+#define APP_CRASH_REPORT_ID     0x09
+
+/* Blink codes shown on the indicator LED. A lower code is more urgent. */
+#define APP_ERROR_NONE          0
+#define APP_ERROR_STATE         2   /* the state machine reached an unknown state */
+#define APP_ERROR_USB_DEVICE    3   /* USB_DEVICE_EVENT_ERROR, cleared by configuration */
+
+// *****************************************************************************
+/* Boot phases
+
+  Summary:
+    Points on the way from reset to the first input report.
+
+  Description:
+    Each phase is stamped with the CP0 Count value the first time it is
+    reached after reset by APP_BootPhaseRecord. ENTRY is the first statement
+    of SYS_Initialize, so it also holds the time spent in the startup code.
+*/
+
+typedef enum
+{
+    APP_BOOT_PHASE_ENTRY = 0,
+    APP_BOOT_PHASE_CLOCK,
+    APP_BOOT_PHASE_USB_INIT,
+    APP_BOOT_PHASE_INIT_DONE,
+    APP_BOOT_PHASE_CONSOLE,
+    APP_BOOT_PHASE_ATTACH,
+    APP_BOOT_PHASE_RESET,
+    APP_BOOT_PHASE_CONFIGURED,
+    APP_BOOT_PHASE_FIRST_REPORT,
+
+    APP_BOOT_PHASE_COUNT
+
+} APP_BOOT_PHASE;
+
+/* Multi-byte fields are little endian, as HID requires. "flags" bit 0 is set
+   when the image was built with SYS_FAST_BOOT. "phases" has a bit per phase
+   that was reached. microseconds[0] is the time from reset to ENTRY, every
+   other entry is the time from ENTRY to that phase. */
+typedef union
+{
+    struct __attribute__((packed)) {
+        uint8_t reportId;
+        uint8_t flags;
+        uint16_t phases;
+        uint32_t microseconds[APP_BOOT_PHASE_COUNT];
+    };
+
+    uint8_t data[4 + (4 * APP_BOOT_PHASE_COUNT)];
+
+} MEDIA_CONTROLLER_BOOT_REPORT_T;
+
+/* CPU load of the last APP_LOAD_WINDOW_MS window, one entry per
+   APP_LOAD_SLOT in enum order. "window" is the low 16 bits of the window
+   number, so a host can tell a new window from a repeat. "load" and "idle"
+   are in 1/10000 of the window, "count" is the calls in the window and
+   "maxMicroseconds" the longest call; both saturate at 0xFFFF. */
+typedef union
+{
+    struct __attribute__((packed)) {
+        uint8_t reportId;
+        uint8_t slots;
+        uint16_t window;
+        uint16_t idle;
+        struct __attribute__((packed)) {
+            uint16_t load;
+            uint16_t count;
+            uint16_t maxMicroseconds;
+        } slot[APP_LOAD_SLOTS];
+    };
+
+    uint8_t data[6 + (6 * APP_LOAD_SLOTS)];
+
+} MEDIA_CONTROLLER_LOAD_REPORT_T;
+
+/* Recovery from bus resets and deconfigurations of a configured device.
+   "resets" counts them, "lastMicroseconds" and "maxMicroseconds" are the
+   time from one to the next SET_CONFIGURATION. "queuedEvents" are key
+   events made meanwhile and sent afterwards, "lostEvents" those that did
+   not fit in the queue. All saturate. */
+typedef union
+{
+    struct __attribute__((packed)) {
+        uint8_t reportId;
+        uint16_t resets;
+        uint32_t lastMicroseconds;
+        uint32_t maxMicroseconds;
+        uint16_t queuedEvents;
+        uint16_t lostEvents;
+    };
+
+    uint8_t data[15];
+
+} MEDIA_CONTROLLER_RECOVERY_REPORT_T;
+
+/* The last crash, see APP_CRASH_RECORD. "cause" is an APP_CRASH_CAUSE,
+   APP_CRASH_CAUSE_NONE when there was no crash since power-on or since the
+   host cleared the record with vendor output command 11. Each trace entry
+   is an APP_CRASH_TRACE source in the high byte and its value in the low
+   byte, oldest first. */
+typedef union
+{
+    struct __attribute__((packed)) {
+        uint8_t reportId;
+        uint8_t cause;
+        uint8_t exceptionCode;
+        uint16_t crashes;
+        uint32_t epc;
+        uint32_t badAddress;
+        uint16_t trace[APP_CRASH_TRACE_SIZE];
+    };
+
+    uint8_t data[13 + (2 * APP_CRASH_TRACE_SIZE)];
+
+} MEDIA_CONTROLLER_CRASH_REPORT_T;
+
 
 // *****************************************************************************
 /* Application states
@@ -151,20 +428,20 @@ typedef struct
         /* Handle to the device layer */
     USB_DEVICE_HANDLE deviceHandle;
 
-    /* Application HID instance */
-    USB_DEVICE_HID_INDEX hidInstance;
-
     /* Is device configured */
     bool isConfigured;
 
-    /* Track the send report status */
-    bool isReportSentComplete;
+    /* Track the send report status, per HID instance */
+    bool isReportSentComplete[APP_HID_INSTANCES];
 
-    /* Track if a report was received */
+    /* Track if a report was received on the vendor instance */
     bool isReportReceived;
 
-    /* USB HID current Idle */
-    uint8_t idleRate;
+    /* The last receive completed with data, not aborted */
+    bool isReportValid;
+
+    /* USB HID current Idle, per HID instance */
+    uint8_t idleRate[APP_HID_INSTANCES];
 
     /* Flag determines SOF event occurrence */
     bool sofEventHasOccurred;
@@ -172,24 +449,84 @@ typedef struct
     /* Receive transfer handle */
     USB_DEVICE_HID_TRANSFER_HANDLE receiveTransferHandle;
 
-    /* Send transfer handle */
-    USB_DEVICE_HID_TRANSFER_HANDLE sendTransferHandle;
+    /* Send transfer handles, per HID instance */
+    USB_DEVICE_HID_TRANSFER_HANDLE sendTransferHandle[APP_HID_INSTANCES];
 
     /* Key code to be sent */
     USB_HID_KEYBOARD_KEYPAD key;
 
-    /* USB HID active Protocol */
-    USB_HID_PROTOCOL_CODE activeProtocol;
+    /* USB HID active Protocol, per HID instance */
+    USB_HID_PROTOCOL_CODE activeProtocol[APP_HID_INSTANCES];
 
-    MEDIA_CONTROLLER_KEYCODE_T controllerKeycode;
+    /* Keys pending for the next input report. The button and timer
+     * interrupts add to them, see APP_KeycodeTake. */
+    volatile MEDIA_CONTROLLER_KEYCODE_T controllerKeycode;
     bool isYoutubeMode;
     
+    /* Bus suspended, and the blink code to show (APP_ERROR_*) */
+    bool isSuspended;
+    uint8_t errorCode;
+    
     uint8_t previousEncoderPortValue; 
     uint8_t previousKeycode;
     uint8_t encoderValue;
     
     uint8_t fullScreenSqeunceNumber;   // for youtube full screen toggle
     
+    /* Absolute volume: the level per consumer and vendor instance, changed
+     * by the encoder, and the level last reported on it */
+    bool isVolumeAbsolute;
+    volatile uint8_t volumeLevel[APP_HID_VENDOR + 1];
+    uint8_t volumeLevelSent[APP_HID_VENDOR + 1];
+    
+    /* Scrubbing: the seek the encoder added up and has not been sent, and
+     * the core timer count of the last detent */
+    bool isSeekScrub;
+    volatile int32_t seekMilliseconds;
+    uint32_t seekDetentCount;
+    
+    /* The extension sent a heartbeat within APP_HEARTBEAT_TIMEOUT_MS, and
+     * the timer that clears it */
+    volatile bool isExtensionAlive;
+    APP_TIME_HANDLE heartbeatTimer;
+    
+    /* Key events made while the device is not configured, sent one by one
+     * in order once it is configured again */
+    uint8_t eventQueue[APP_EVENT_QUEUE_SIZE];
+    volatile uint8_t eventHead;
+    volatile uint8_t eventCount;
+    
+    /* Recovery counters, see MEDIA_CONTROLLER_RECOVERY_REPORT_T, and the
+     * time of the reset being recovered from */
+    bool isRecovering;
+    uint64_t recoveryStartCount;
+    uint16_t resets;
+    uint32_t recoveryLastMicroseconds;
+    uint32_t recoveryMaxMicroseconds;
+    uint16_t queuedEvents;
+    uint16_t lostEvents;
+    
+    /* Encoder detents not sent as keys yet, positive clockwise, and the
+     * credit of each rate limit bucket in frames */
+    volatile int16_t encoderSteps;
+    volatile uint16_t rateCredit[APP_RATE_COUNT];
+    
+    /* State report: changes made on the device, and a report is due */
+    volatile uint8_t stateSequence;
+    volatile bool isStateReportPending;
+    
+    /* Input reports are built and sent in the SOF event (APP_REPORT_AT_SOF) */
+    bool isReportAtSof;
+    
+    /* Keyboard action whose key is down on the host, NULL when none */
+    const APP_YOUTUBE_ACTION * keyboardAction;
+    
+    /* Keyboard LEDs from the last output report (SET_REPORT) */
+    uint8_t keyboardLeds;
+    
+    /* State last added to the crash trace */
+    APP_STATES tracedState;
+    
 } APP_DATA;
 
 void APP_Initialize ( void );
@@ -198,6 +535,28 @@ void APP_Tasks( void );
 
 void APP_ReadEncoder();
 
+void APP_InputReportsSend(void);
+
+void APP_RateRefill(void);
+
+void APP_BootPhaseRecord(APP_BOOT_PHASE phase);
+
+void APP_LoadReportBuild(void);
+
+void APP_RecoveryReportBuild(void);
+
+void APP_RecoveryRecord(void);
+
+void APP_CrashReportBuild(void);
+
+void APP_BannerPrint(void);
+
+void APP_StateReset(void);
+
+void APP_IndicatorUpdate(void);
+
+void APP_ErrorSet(uint8_t errorCode);
+
 //DOM-IGNORE-BEGIN
 #ifdef __cplusplus
 }
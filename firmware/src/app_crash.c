@@ -0,0 +1,225 @@
+/*******************************************************************************
+  Crash Capture Source File
+
+  File Name:
+    app_crash.c
+
+  Summary:
+    Crash record in persistent RAM, software reset and the watchdog.
+
+  Description:
+    Everything that must outlive a reset is in appCrash, which the startup
+    code leaves alone. A magic number tells a kept appCrash from the random
+    contents of RAM after power-on. The exception handlers only store the
+    cause into it; the trace ring is copied into the record after the reset,
+    where it is safe to take time.
+
+    The main loop reads CP0 Count on each pass and clears the watchdog once
+    a service interval has passed, which costs no timer and keeps TMR2
+    stopped when no software timer is armed.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_crash.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+#define APP_CRASH_MAGIC             0x43524153U
+
+/* XC32 places persistent variables in .persist, which the startup code
+   neither zeroes nor initializes. The simulator keeps its variables across
+   its resets anyway. */
+#if defined(__XC32)
+#define APP_CRASH_PERSISTENT        __attribute__((persistent))
+#else
+#define APP_CRASH_PERSISTENT
+#endif
+
+/* CP0 Count ticks between watchdog clears */
+#define APP_CRASH_SERVICE_TICKS     (APP_WATCHDOG_SERVICE_MS * (APP_TIME_COUNTER_FREQUENCY / 1000U))
+
+/* RCON flags read and cleared at initialization */
+#define APP_CRASH_RCON_FLAGS        (_RCON_POR_MASK | _RCON_BOR_MASK | _RCON_WDTO_MASK \
+                                     | _RCON_SWR_MASK | _RCON_EXTR_MASK)
+
+typedef struct
+{
+    /* APP_CRASH_MAGIC once initialized after power-on */
+    uint32_t magic;
+
+    /* Stored by APP_CRASH_Capture, taken into the record after the reset */
+    uint8_t pendingCause;
+    uint8_t pendingExceptionCode;
+    uint32_t pendingEpc;
+    uint32_t pendingBadAddress;
+
+    /* Trace of the running firmware, traceHead is the next entry written */
+    uint16_t trace[APP_CRASH_TRACE_SIZE];
+    uint8_t traceHead;
+
+    APP_CRASH_RECORD record;
+
+} APP_CRASH_PERSIST;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+static APP_CRASH_PERSIST APP_CRASH_PERSISTENT appCrash;
+
+/* CP0 Count at the last watchdog clear */
+static uint32_t appCrashServiceCount;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* The run that ended with the reset crashed: keep its trace, oldest first */
+static void _APP_CRASH_RecordSet(APP_CRASH_CAUSE cause, uint8_t exceptionCode, uint32_t epc, uint32_t badAddress)
+{
+    size_t i;
+
+    appCrash.record.cause = (uint8_t)cause;
+    appCrash.record.exceptionCode = exceptionCode;
+    appCrash.record.epc = epc;
+    appCrash.record.badAddress = badAddress;
+
+    for(i = 0; i < APP_CRASH_TRACE_SIZE; i++)
+    {
+        appCrash.record.trace[i] = appCrash.trace[(appCrash.traceHead + i) % APP_CRASH_TRACE_SIZE];
+    }
+
+    if(appCrash.record.crashes < UINT16_MAX)
+    {
+        appCrash.record.crashes++;
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_CRASH_Initialize(void)
+{
+    uint32_t resetCause = RCON & APP_CRASH_RCON_FLAGS;
+
+    RCONCLR = resetCause;
+
+    if(((resetCause & (_RCON_POR_MASK | _RCON_BOR_MASK)) != 0U) || (appCrash.magic != APP_CRASH_MAGIC)
+            || (appCrash.traceHead >= APP_CRASH_TRACE_SIZE))
+    {
+        memset(&appCrash, 0, sizeof(appCrash));
+        appCrash.magic = APP_CRASH_MAGIC;
+    }
+    else if(((resetCause & (_RCON_SWR_MASK | _RCON_WDTO_MASK)) != 0U)
+            && (appCrash.pendingCause != APP_CRASH_CAUSE_NONE))
+    {
+        /* A captured exception, even if the watchdog had to finish the
+           reset */
+        _APP_CRASH_RecordSet((APP_CRASH_CAUSE)appCrash.pendingCause, appCrash.pendingExceptionCode,
+                appCrash.pendingEpc, appCrash.pendingBadAddress);
+    }
+    else if((resetCause & _RCON_WDTO_MASK) != 0U)
+    {
+        _APP_CRASH_RecordSet(APP_CRASH_CAUSE_WATCHDOG, 0, 0, 0);
+    }
+
+    appCrash.pendingCause = APP_CRASH_CAUSE_NONE;
+    memset(appCrash.trace, 0, sizeof(appCrash.trace));
+    appCrash.traceHead = 0;
+
+#if APP_WATCHDOG_ENABLE
+    appCrashServiceCount = APP_TIME_Counter32Get();
+    WDTCONSET = _WDTCON_ON_MASK;
+#endif
+}
+
+void APP_CRASH_Trace(APP_CRASH_TRACE source, uint8_t value)
+{
+    bool interruptState = SYS_INT_Disable();
+
+    appCrash.trace[appCrash.traceHead] = ((uint16_t)source << 8) | value;
+    appCrash.traceHead = (appCrash.traceHead + 1U) % APP_CRASH_TRACE_SIZE;
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_CRASH_Capture(APP_CRASH_CAUSE cause, uint8_t exceptionCode, uint32_t epc, uint32_t badAddress)
+{
+    if(appCrash.pendingCause != APP_CRASH_CAUSE_NONE)
+    {
+        return;
+    }
+
+    appCrash.pendingExceptionCode = exceptionCode;
+    appCrash.pendingEpc = epc;
+    appCrash.pendingBadAddress = badAddress;
+
+    /* Last, so that a capture cut short is not taken */
+    appCrash.pendingCause = (uint8_t)cause;
+}
+
+void __attribute__((noreturn)) APP_CRASH_Reset(void)
+{
+    (void)__builtin_disable_interrupts();
+
+    SYSKEY = 0x00000000U;
+    SYSKEY = 0xAA996655U;
+    SYSKEY = 0x556699AAU;
+
+    RSWRSTSET = _RSWRST_SWRST_MASK;
+
+    /* The read starts the reset */
+    (void)RSWRST;
+
+    while(true)
+    {
+    }
+}
+
+void APP_CRASH_WatchdogService(void)
+{
+#if APP_WATCHDOG_ENABLE
+    uint32_t count = APP_TIME_Counter32Get();
+
+    if((count - appCrashServiceCount) >= APP_CRASH_SERVICE_TICKS)
+    {
+        appCrashServiceCount = count;
+        WDTCONSET = _WDTCON_WDTCLR_MASK;
+    }
+#endif
+}
+
+const APP_CRASH_RECORD * APP_CRASH_RecordGet(void)
+{
+    return &appCrash.record;
+}
+
+void APP_CRASH_RecordClear(void)
+{
+    uint16_t crashes = appCrash.record.crashes;
+
+    memset(&appCrash.record, 0, sizeof(appCrash.record));
+    appCrash.record.crashes = crashes;
+}
+
+/*******************************************************************************
+ End of File
+*/
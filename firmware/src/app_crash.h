@@ -0,0 +1,177 @@
+/*******************************************************************************
+  Crash Capture Header File
+
+  File Name:
+    app_crash.h
+
+  Summary:
+    Crash record in persistent RAM, software reset and the watchdog.
+
+  Description:
+    The crash record and a short trace ring live in the .persist section,
+    which the startup code does not clear, so they survive every reset but
+    a power-on or brown-out reset. The application adds a trace entry at
+    each point worth knowing after a fault: state changes, USB events,
+    vendor commands and input reports.
+
+    The exception handlers in exceptions.c call APP_CRASH_Capture with the
+    exception code and EPC, then APP_CRASH_Reset, so a fault costs a reboot
+    and a re-enumeration instead of a dead device. If the stack is unusable
+    the capture faults as well, and the watchdog resets the device instead;
+    the crash is then recorded as a watchdog reset. A main loop that stops
+    running is caught by the watchdog, which runs in window mode: it resets
+    the device when it is not cleared within its period, and also when it is
+    cleared too early, so a loop that spins clearing it is caught as well.
+    APP_CRASH_WatchdogService clears it from the main loop at
+    APP_WATCHDOG_SERVICE_MS, inside the window of the WDTPS and FWDTWINSZ
+    configuration bits.
+
+    APP_CRASH_Initialize reads RCON after reset. A software reset that
+    follows a capture, or a watchdog time-out, makes the trace ring of the
+    run that ended part of the record, where the host can read it until it
+    clears it.
+*******************************************************************************/
+
+#ifndef _APP_CRASH_H
+#define _APP_CRASH_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Crash Cause
+
+  Summary:
+    What ended the run the crash record describes.
+*/
+
+typedef enum
+{
+    APP_CRASH_CAUSE_NONE = 0,
+
+    /* General exception, "exceptionCode" and "epc" are set */
+    APP_CRASH_CAUSE_EXCEPTION,
+
+    /* Exception while STATUS.BEV was set, in the startup code */
+    APP_CRASH_CAUSE_BOOTSTRAP_EXCEPTION,
+
+    /* Watchdog time-out or a clear outside the window */
+    APP_CRASH_CAUSE_WATCHDOG
+
+} APP_CRASH_CAUSE;
+
+// *****************************************************************************
+/* Trace Sources
+
+  Summary:
+    High byte of a trace entry, the low byte is the value.
+*/
+
+typedef enum
+{
+    APP_CRASH_TRACE_NONE = 0,
+
+    /* APP_STATES value the task loop entered, the polling states as
+       APP_STATE_CHECK_FOR_OUTPUT_REPORT */
+    APP_CRASH_TRACE_STATE,
+
+    /* USB_DEVICE_EVENT other than SOF */
+    APP_CRASH_TRACE_USB_EVENT,
+
+    /* Vendor output command */
+    APP_CRASH_TRACE_COMMAND,
+
+    /* HID instance whose input report the host read */
+    APP_CRASH_TRACE_REPORT
+
+} APP_CRASH_TRACE;
+
+// *****************************************************************************
+/* Crash Record
+
+  Summary:
+    The last crash, and the crashes since power-on.
+
+  Description:
+    "trace" holds APP_CRASH_TRACE_SIZE entries, oldest first, of the run
+    that crashed. Unused entries are zero. "badAddress" is CP0 BadVAddr,
+    meaningful for address errors only.
+*/
+
+typedef struct
+{
+    uint16_t crashes;
+    uint8_t cause;
+    uint8_t exceptionCode;
+    uint32_t epc;
+    uint32_t badAddress;
+    uint16_t trace[APP_CRASH_TRACE_SIZE];
+
+} APP_CRASH_RECORD;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Reads and clears RCON, completes the record of a crash that caused the
+   reset, starts a new trace and starts the watchdog. Call once after
+   reset, before the first APP_CRASH_Trace. */
+void APP_CRASH_Initialize(void);
+
+/* Adds an entry to the trace ring. May be called from thread or interrupt
+   context. */
+void APP_CRASH_Trace(APP_CRASH_TRACE source, uint8_t value);
+
+/* Called from the exception handlers with the cause's ExcCode, EPC and
+   BadVAddr. Only stores to persistent RAM. An exception raised after a
+   capture, on the way to the reset, leaves the first one in place. */
+void APP_CRASH_Capture(APP_CRASH_CAUSE cause, uint8_t exceptionCode, uint32_t epc, uint32_t badAddress);
+
+/* Software reset (RSWRST), does not return */
+void __attribute__((noreturn)) APP_CRASH_Reset(void);
+
+/* Clears the watchdog once APP_WATCHDOG_SERVICE_MS have passed since the
+   last clear. Call on every main loop pass; it reads CP0 Count and does
+   nothing else in between. */
+void APP_CRASH_WatchdogService(void);
+
+/* The last crash, with cause APP_CRASH_CAUSE_NONE when there is none */
+const APP_CRASH_RECORD * APP_CRASH_RecordGet(void);
+
+/* Forgets the last crash. The crash count is kept until power-on. */
+void APP_CRASH_RecordClear(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_CRASH_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,438 @@
+/*******************************************************************************
+  Gesture Recognizer Source File
+
+  File Name:
+    app_gesture.c
+
+  Summary:
+    Tap, double tap, long press, chords and hold-to-repeat on the
+    controller's buttons.
+
+  Description:
+    One input, or one chord, is classified at a time. PRESSED waits for a
+    chord partner, a long press or the release; RELEASED waits for the second
+    press of a double tap; REPEATING reports the held input on every timer
+    expiry; CONSUMED waits until the inputs of a reported gesture are
+    released, so their releases do not start anything new.
+
+    Every timer started gets a new generation number as its context. A timer
+    that expires after it was replaced or stopped finds a different
+    generation and does nothing, so stopping a timer never races with its
+    expiry.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_gesture.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    APP_GESTURE_STATE_IDLE = 0,
+    APP_GESTURE_STATE_PRESSED,
+    APP_GESTURE_STATE_RELEASED,
+    APP_GESTURE_STATE_REPEATING,
+    APP_GESTURE_STATE_CONSUMED
+
+} APP_GESTURE_STATE;
+
+typedef struct
+{
+    const APP_GESTURE_ACTION * actions;
+    size_t actionCount;
+    APP_GESTURE_CALLBACK callback;
+
+    APP_GESTURE_STATE state;
+
+    /* Input being classified, or the inputs of a reported gesture that are
+       still held */
+    uint8_t pending;
+
+    /* PRESSED and the chord window is still open */
+    bool isChordOpen;
+
+    /* REPEATING: the action being repeated and the interval to the next
+       repeat */
+    const APP_GESTURE_ACTION * repeat;
+    uint32_t repeatMs;
+
+    APP_TIME_HANDLE timer;
+    uint32_t generation;
+
+} APP_GESTURE_OBJ;
+
+static APP_GESTURE_OBJ appGesture;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static const APP_GESTURE_ACTION * _APP_GESTURE_Find(uint8_t inputs, APP_GESTURE gesture)
+{
+    size_t i;
+
+    for(i = 0; i < appGesture.actionCount; i++)
+    {
+        if((appGesture.actions[i].inputs == inputs) && (appGesture.actions[i].gesture == gesture))
+        {
+            return &appGesture.actions[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool _APP_GESTURE_IsChordMember(uint8_t input)
+{
+    size_t i;
+
+    for(i = 0; i < appGesture.actionCount; i++)
+    {
+        if((appGesture.actions[i].gesture == APP_GESTURE_CHORD) && ((appGesture.actions[i].inputs & input) != 0U))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+static void _APP_GESTURE_Report(uint8_t inputs, APP_GESTURE gesture)
+{
+    const APP_GESTURE_ACTION * action = _APP_GESTURE_Find(inputs, gesture);
+
+    appGesture.callback((action != NULL) ? action->keycode : inputs);
+}
+
+static void _APP_GESTURE_TimerStop(void)
+{
+    if(appGesture.timer != APP_TIME_HANDLE_INVALID)
+    {
+        APP_TIME_TimerDestroy(appGesture.timer);
+        appGesture.timer = APP_TIME_HANDLE_INVALID;
+    }
+
+    appGesture.generation++;
+}
+
+static void _APP_GESTURE_TimerHandler(uintptr_t context);
+
+static void _APP_GESTURE_TimerStart(uint32_t ms)
+{
+    _APP_GESTURE_TimerStop();
+
+    appGesture.timer = APP_TIME_CallbackRegisterMS(_APP_GESTURE_TimerHandler,
+            (uintptr_t)appGesture.generation, ms, APP_TIME_SINGLE);
+}
+
+/* The pending input is no longer anything but a tap. It is reported now and
+   its release is ignored. */
+static void _APP_GESTURE_TapSettle(void)
+{
+    _APP_GESTURE_TimerStop();
+    _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_TAP);
+    appGesture.state = APP_GESTURE_STATE_CONSUMED;
+}
+
+/* The pending input repeats: its tap is reported now and the first repeat
+   comes "delayMs" later */
+static void _APP_GESTURE_RepeatStart(const APP_GESTURE_ACTION * repeat, uint32_t delayMs)
+{
+    _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_TAP);
+    appGesture.repeat = repeat;
+    appGesture.repeatMs = repeat->rate->intervalMs;
+    appGesture.state = APP_GESTURE_STATE_REPEATING;
+    _APP_GESTURE_TimerStart((delayMs > 0U) ? delayMs : 1U);
+}
+
+static void _APP_GESTURE_RepeatNext(void)
+{
+    const APP_GESTURE_REPEAT_RATE * rate = appGesture.repeat->rate;
+    uint32_t repeatMs = appGesture.repeatMs;
+
+    appGesture.callback(appGesture.repeat->keycode);
+    _APP_GESTURE_TimerStart((repeatMs > 0U) ? repeatMs : 1U);
+
+    repeatMs = (repeatMs * rate->accelerationPercent) / 100U;
+    appGesture.repeatMs = (repeatMs > rate->minIntervalMs) ? repeatMs : rate->minIntervalMs;
+}
+
+static void _APP_GESTURE_Press(uint8_t input)
+{
+    const APP_GESTURE_ACTION * repeat;
+
+    switch(appGesture.state)
+    {
+        case APP_GESTURE_STATE_IDLE:
+
+            repeat = _APP_GESTURE_Find(input, APP_GESTURE_REPEAT);
+
+            if(_APP_GESTURE_IsChordMember(input))
+            {
+                appGesture.isChordOpen = true;
+                _APP_GESTURE_TimerStart(APP_GESTURE_CHORD_MS);
+            }
+            else if(repeat != NULL)
+            {
+                appGesture.pending = input;
+                _APP_GESTURE_RepeatStart(repeat, repeat->rate->delayMs);
+                break;
+            }
+            else if(_APP_GESTURE_Find(input, APP_GESTURE_LONG_PRESS) != NULL)
+            {
+                appGesture.isChordOpen = false;
+                _APP_GESTURE_TimerStart(APP_GESTURE_LONG_PRESS_MS);
+            }
+            else if(_APP_GESTURE_Find(input, APP_GESTURE_DOUBLE_TAP) != NULL)
+            {
+                /* Nothing to time until the release */
+                appGesture.isChordOpen = false;
+            }
+            else
+            {
+                appGesture.callback(input);
+                break;
+            }
+
+            appGesture.pending = input;
+            appGesture.state = APP_GESTURE_STATE_PRESSED;
+            break;
+
+        case APP_GESTURE_STATE_PRESSED:
+
+            if(input == appGesture.pending)
+            {
+                break;
+            }
+
+            if(appGesture.isChordOpen && (_APP_GESTURE_Find(appGesture.pending | input, APP_GESTURE_CHORD) != NULL))
+            {
+                _APP_GESTURE_TimerStop();
+                appGesture.pending |= input;
+                _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_CHORD);
+                appGesture.state = APP_GESTURE_STATE_CONSUMED;
+            }
+            else
+            {
+                _APP_GESTURE_TapSettle();
+                appGesture.callback(input);
+            }
+            break;
+
+        case APP_GESTURE_STATE_RELEASED:
+
+            _APP_GESTURE_TimerStop();
+
+            if(input == appGesture.pending)
+            {
+                _APP_GESTURE_Report(input, APP_GESTURE_DOUBLE_TAP);
+                appGesture.state = APP_GESTURE_STATE_CONSUMED;
+            }
+            else
+            {
+                /* The first tap was a tap after all; the new press starts
+                   over */
+                _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_TAP);
+                appGesture.state = APP_GESTURE_STATE_IDLE;
+                _APP_GESTURE_Press(input);
+            }
+            break;
+
+        case APP_GESTURE_STATE_REPEATING:
+        case APP_GESTURE_STATE_CONSUMED:
+        default:
+
+            appGesture.callback(input);
+            break;
+    }
+}
+
+static void _APP_GESTURE_Release(uint8_t input)
+{
+    if((input & appGesture.pending) == 0U)
+    {
+        return;
+    }
+
+    switch(appGesture.state)
+    {
+        case APP_GESTURE_STATE_PRESSED:
+
+            _APP_GESTURE_TimerStop();
+
+            if((_APP_GESTURE_Find(input, APP_GESTURE_REPEAT) == NULL)
+                    && (_APP_GESTURE_Find(input, APP_GESTURE_DOUBLE_TAP) != NULL))
+            {
+                appGesture.state = APP_GESTURE_STATE_RELEASED;
+                _APP_GESTURE_TimerStart(APP_GESTURE_DOUBLE_TAP_MS);
+            }
+            else
+            {
+                _APP_GESTURE_Report(input, APP_GESTURE_TAP);
+                appGesture.pending = 0;
+                appGesture.state = APP_GESTURE_STATE_IDLE;
+            }
+            break;
+
+        case APP_GESTURE_STATE_REPEATING:
+
+            _APP_GESTURE_TimerStop();
+            appGesture.pending = 0;
+            appGesture.state = APP_GESTURE_STATE_IDLE;
+            break;
+
+        case APP_GESTURE_STATE_CONSUMED:
+
+            appGesture.pending &= ~input;
+            if(appGesture.pending == 0U)
+            {
+                appGesture.state = APP_GESTURE_STATE_IDLE;
+            }
+            break;
+
+        default:
+            break;
+    }
+}
+
+static void _APP_GESTURE_TimerHandler(uintptr_t context)
+{
+    bool interruptState = SYS_INT_Disable();
+
+    if((uint32_t)context != appGesture.generation)
+    {
+        /* Stopped or replaced after it had already expired */
+        SYS_INT_Restore(interruptState);
+        return;
+    }
+
+    /* A single timer is freed before its callback runs */
+    appGesture.timer = APP_TIME_HANDLE_INVALID;
+
+    const APP_GESTURE_ACTION * repeat;
+
+    switch(appGesture.state)
+    {
+        case APP_GESTURE_STATE_PRESSED:
+
+            if(appGesture.isChordOpen)
+            {
+                appGesture.isChordOpen = false;
+                repeat = _APP_GESTURE_Find(appGesture.pending, APP_GESTURE_REPEAT);
+
+                if(repeat != NULL)
+                {
+                    _APP_GESTURE_RepeatStart(repeat, (repeat->rate->delayMs > APP_GESTURE_CHORD_MS)
+                            ? (repeat->rate->delayMs - APP_GESTURE_CHORD_MS) : 1U);
+                }
+                else if(_APP_GESTURE_Find(appGesture.pending, APP_GESTURE_LONG_PRESS) != NULL)
+                {
+                    _APP_GESTURE_TimerStart((APP_GESTURE_LONG_PRESS_MS > APP_GESTURE_CHORD_MS)
+                            ? (APP_GESTURE_LONG_PRESS_MS - APP_GESTURE_CHORD_MS) : 1U);
+                }
+                else if(_APP_GESTURE_Find(appGesture.pending, APP_GESTURE_DOUBLE_TAP) == NULL)
+                {
+                    _APP_GESTURE_TapSettle();
+                }
+            }
+            else
+            {
+                _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_LONG_PRESS);
+                appGesture.state = APP_GESTURE_STATE_CONSUMED;
+            }
+            break;
+
+        case APP_GESTURE_STATE_RELEASED:
+
+            _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_TAP);
+            appGesture.pending = 0;
+            appGesture.state = APP_GESTURE_STATE_IDLE;
+            break;
+
+        case APP_GESTURE_STATE_REPEATING:
+
+            _APP_GESTURE_RepeatNext();
+            break;
+
+        default:
+            break;
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_GESTURE_Initialize(const APP_GESTURE_ACTION * actions, size_t actionCount,
+        APP_GESTURE_CALLBACK callback)
+{
+    appGesture.actions = actions;
+    appGesture.actionCount = actionCount;
+    appGesture.callback = callback;
+    appGesture.state = APP_GESTURE_STATE_IDLE;
+    appGesture.pending = 0;
+    appGesture.isChordOpen = false;
+    appGesture.repeat = NULL;
+    appGesture.repeatMs = 0;
+    appGesture.timer = APP_TIME_HANDLE_INVALID;
+    appGesture.generation = 0;
+}
+
+void APP_GESTURE_ActionsSet(const APP_GESTURE_ACTION * actions, size_t actionCount)
+{
+    bool interruptState = SYS_INT_Disable();
+
+    _APP_GESTURE_TimerStop();
+
+    /* A tap waiting out its double tap window is finished; anything else
+       being classified is dropped and its release ignored */
+    if(appGesture.state == APP_GESTURE_STATE_RELEASED)
+    {
+        _APP_GESTURE_Report(appGesture.pending, APP_GESTURE_TAP);
+    }
+
+    appGesture.actions = actions;
+    appGesture.actionCount = actionCount;
+    appGesture.state = APP_GESTURE_STATE_IDLE;
+    appGesture.pending = 0;
+    appGesture.isChordOpen = false;
+    appGesture.repeat = NULL;
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_GESTURE_InputSet(uint8_t input, bool isPressed)
+{
+    bool interruptState = SYS_INT_Disable();
+
+    if(isPressed)
+    {
+        _APP_GESTURE_Press(input);
+    }
+    else
+    {
+        _APP_GESTURE_Release(input);
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+/*******************************************************************************
+ End of File
+ */
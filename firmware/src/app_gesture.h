@@ -0,0 +1,160 @@
+/*******************************************************************************
+  Gesture Recognizer Header File
+
+  File Name:
+    app_gesture.h
+
+  Summary:
+    Tap, double tap, long press, chords and hold-to-repeat on the
+    controller's buttons.
+
+  Description:
+    Inputs are bits of a byte, the application uses the keycode bits of its
+    buttons. Only inputs that appear in the action table are classified; any
+    other input is reported as a tap the moment it is pressed. A classified
+    input is reported as soon as no other gesture is possible for it:
+
+    - A chord is a second input pressed within APP_GESTURE_CHORD_MS of the
+      first one, and is reported on that press.
+    - A long press is reported once the input has been held for
+      APP_GESTURE_LONG_PRESS_MS.
+    - A double tap is reported on the second press, if it comes within
+      APP_GESTURE_DOUBLE_TAP_MS of the first release.
+    - Otherwise the input is a tap. It is reported at the end of the chord
+      window if the input has no long press or double tap, on release if it
+      has a long press but no double tap, and at the end of the double tap
+      window if it has one.
+
+    An input with APP_GESTURE_REPEAT repeats while it is held, so its long
+    press and double tap entries are not used. Its tap is reported on press,
+    or at the end of the chord window if it is part of a chord. After the
+    rate's delay its keycode is reported again and again. Each interval is
+    accelerationPercent of the previous one, down to minIntervalMs. A
+    repeat is a press for one report like any other gesture, so repeats
+    faster than the reports can go out merge and the rate is capped at the
+    endpoint rate.
+
+    An input pressed while another one is being classified, and is not a
+    chord with it, settles the pending one as a tap and is itself reported as
+    a tap.
+
+    Windows are timed with one single-shot software timer (app_time.c), so
+    nothing is polled and the report path never waits on the recognizer.
+    APP_GESTURE_InputSet is called from the button interrupt and the timer
+    expires in the TMR2 interrupt; both run with interrupts disabled while
+    they touch the recognizer.
+*******************************************************************************/
+
+#ifndef _APP_GESTURE_H
+#define _APP_GESTURE_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+typedef enum
+{
+    APP_GESTURE_TAP = 0,
+    APP_GESTURE_DOUBLE_TAP,
+    APP_GESTURE_LONG_PRESS,
+    APP_GESTURE_CHORD,
+    APP_GESTURE_REPEAT
+
+} APP_GESTURE;
+
+// *****************************************************************************
+/* Repeat Rate
+
+  Summary:
+    Timing of one APP_GESTURE_REPEAT action.
+*/
+
+typedef struct
+{
+    /* From the tap to the first repeat */
+    uint16_t delayMs;
+
+    /* From the first repeat to the second */
+    uint16_t intervalMs;
+
+    /* Shortest interval the acceleration reaches */
+    uint16_t minIntervalMs;
+
+    /* Each interval in percent of the previous one, 100 for a steady rate */
+    uint8_t accelerationPercent;
+
+} APP_GESTURE_REPEAT_RATE;
+
+// *****************************************************************************
+/* Gesture Action
+
+  Summary:
+    What one gesture reports.
+
+  Description:
+    "inputs" is one input bit, or two for APP_GESTURE_CHORD. A recognized
+    gesture reports "keycode" instead of its inputs. A tap always reports
+    its input and needs no entry. "rate" is used by APP_GESTURE_REPEAT only.
+*/
+
+typedef struct
+{
+    uint8_t inputs;
+    APP_GESTURE gesture;
+    uint8_t keycode;
+    const APP_GESTURE_REPEAT_RATE * rate;
+
+} APP_GESTURE_ACTION;
+
+/* Called with the keycode of each recognized gesture, in interrupt context */
+typedef void (*APP_GESTURE_CALLBACK)(uint8_t keycode);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* "actions" must stay valid while the recognizer uses them */
+void APP_GESTURE_Initialize(const APP_GESTURE_ACTION * actions, size_t actionCount,
+        APP_GESTURE_CALLBACK callback);
+
+/* Replaces the action table, NULL and 0 for none. A gesture being
+   classified is dropped; a tap waiting for its double tap is reported. */
+void APP_GESTURE_ActionsSet(const APP_GESTURE_ACTION * actions, size_t actionCount);
+
+/* One input changed. Presses and releases of inputs without gestures are
+   cheap: a press calls the callback at once, a release does nothing. */
+void APP_GESTURE_InputSet(uint8_t input, bool isPressed);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_GESTURE_H */
+
+/*******************************************************************************
+ End of File
+ */
@@ -0,0 +1,218 @@
+/*******************************************************************************
+  Indicator LED Engine Source File
+
+  File Name:
+    app_led.c
+
+  Summary:
+    Brightness levels, breathing and blink codes on the indicator LED.
+
+  Description:
+    Patterns are constant step tables. Starting a pattern loads its first
+    duty cycle into OC3RS and, for patterns with more than one step, enables
+    the TMR3 period interrupt. The interrupt counts PWM periods down and moves
+    to the next step when the count runs out; OC3 takes the new OC3RS at the
+    next period boundary, so steps never glitch the output.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "app_led.h"
+#include "definitions.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* TMR3 period in counts (PR3 + 1) and the resulting PWM frequency. An OC3RS
+   value of APP_LED_PWM_PERIOD or more keeps the output high. */
+#define APP_LED_PWM_PERIOD          6250U
+#define APP_LED_PWM_HZ              800U
+
+/* PWM periods in "ms" milliseconds */
+#define APP_LED_MS(ms)              (((ms) * APP_LED_PWM_HZ) / 1000U)
+
+typedef struct
+{
+    /* OC3RS value */
+    uint16_t duty;
+
+    /* PWM periods to hold it, unused by one-step patterns */
+    uint16_t periods;
+
+} APP_LED_STEP;
+
+typedef struct
+{
+    const APP_LED_STEP * steps;
+    uint8_t stepCount;
+    uint8_t step;
+    uint16_t periodsLeft;
+    APP_LED_PATTERN pattern;
+
+} APP_LED_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* APP_LED_PWM_PERIOD * (level / 7) ^ 2.2 */
+static const APP_LED_STEP appLedLevels[APP_LED_LEVELS] =
+{
+    { 0, 0 }, { 86, 0 }, { 397, 0 }, { 969, 0 },
+    { 1825, 0 }, { 2981, 0 }, { 4452, 0 }, { 6250, 0 }
+};
+
+/* 1562 * (i / 31) ^ 2.2 up and back down, 25 ms a step. The peak is a
+   quarter of full scale to keep the draw low while the bus is suspended. */
+static const APP_LED_STEP appLedBreathe[] =
+{
+    {    0, 20 }, {    1, 20 }, {    4, 20 }, {    9, 20 },
+    {   17, 20 }, {   28, 20 }, {   42, 20 }, {   59, 20 },
+    {   79, 20 }, {  103, 20 }, {  130, 20 }, {  160, 20 },
+    {  194, 20 }, {  231, 20 }, {  272, 20 }, {  316, 20 },
+    {  365, 20 }, {  417, 20 }, {  472, 20 }, {  532, 20 },
+    {  596, 20 }, {  663, 20 }, {  735, 20 }, {  810, 20 },
+    {  890, 20 }, {  973, 20 }, { 1061, 20 }, { 1153, 20 },
+    { 1249, 20 }, { 1349, 20 }, { 1453, 20 }, { 1562, 20 },
+    { 1453, 20 }, { 1349, 20 }, { 1249, 20 }, { 1153, 20 },
+    { 1061, 20 }, {  973, 20 }, {  890, 20 }, {  810, 20 },
+    {  735, 20 }, {  663, 20 }, {  596, 20 }, {  532, 20 },
+    {  472, 20 }, {  417, 20 }, {  365, 20 }, {  316, 20 },
+    {  272, 20 }, {  231, 20 }, {  194, 20 }, {  160, 20 },
+    {  130, 20 }, {  103, 20 }, {   79, 20 }, {   59, 20 },
+    {   42, 20 }, {   28, 20 }, {   17, 20 }, {    9, 20 },
+    {    4, 20 }, {    1, 20 }
+};
+
+/* The pause comes first so that code n is simply the first 1 + 2n steps */
+#define APP_LED_FLASH   { APP_LED_PWM_PERIOD, APP_LED_MS(150) }, { 0, APP_LED_MS(250) }
+
+static const APP_LED_STEP appLedCode[1 + (2 * APP_LED_CODE_MAX)] =
+{
+    { 0, APP_LED_MS(1500) },
+    APP_LED_FLASH, APP_LED_FLASH, APP_LED_FLASH, APP_LED_FLASH,
+    APP_LED_FLASH, APP_LED_FLASH, APP_LED_FLASH, APP_LED_FLASH
+};
+
+static APP_LED_OBJ appLed;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static void _APP_LED_TimerHandler(uint32_t status, uintptr_t context)
+{
+    if(--appLed.periodsLeft == 0U)
+    {
+        if(++appLed.step == appLed.stepCount)
+        {
+            appLed.step = 0;
+        }
+
+        OCMP3_CompareSecondaryValueSet(appLed.steps[appLed.step].duty);
+        appLed.periodsLeft = appLed.steps[appLed.step].periods;
+    }
+}
+
+static void _APP_LED_PatternStart(APP_LED_PATTERN pattern, const APP_LED_STEP * steps, uint8_t stepCount)
+{
+    bool interruptState;
+
+    if((appLed.steps == steps) && (appLed.stepCount == stepCount))
+    {
+        /* Already showing it, let it run on */
+        return;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    TMR3_InterruptDisable();
+
+    appLed.pattern = pattern;
+    appLed.steps = steps;
+    appLed.stepCount = stepCount;
+    appLed.step = 0;
+    appLed.periodsLeft = steps[0].periods;
+    OCMP3_CompareSecondaryValueSet(steps[0].duty);
+
+    if(stepCount > 1U)
+    {
+        TMR3_InterruptEnable();
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_LED_Initialize(void)
+{
+    TMR3_CallbackRegister(_APP_LED_TimerHandler, (uintptr_t)NULL);
+
+    appLed.steps = NULL;
+    _APP_LED_PatternStart(APP_LED_PATTERN_OFF, &appLedLevels[0], 1);
+
+    OCMP3_Enable();
+    TMR3_Start();
+}
+
+void APP_LED_LevelSet(uint8_t level)
+{
+    if(level >= APP_LED_LEVELS)
+    {
+        level = APP_LED_LEVELS - 1;
+    }
+
+    _APP_LED_PatternStart((level == 0U) ? APP_LED_PATTERN_OFF : APP_LED_PATTERN_STEADY, &appLedLevels[level], 1);
+}
+
+void APP_LED_Breathe(void)
+{
+    _APP_LED_PatternStart(APP_LED_PATTERN_BREATHE, appLedBreathe, sizeof(appLedBreathe) / sizeof(appLedBreathe[0]));
+}
+
+void APP_LED_BlinkCode(uint8_t count)
+{
+    if(count == 0U)
+    {
+        APP_LED_LevelSet(0);
+        return;
+    }
+
+    if(count > APP_LED_CODE_MAX)
+    {
+        count = APP_LED_CODE_MAX;
+    }
+
+    _APP_LED_PatternStart(APP_LED_PATTERN_CODE, appLedCode, 1U + (2U * count));
+}
+
+APP_LED_PATTERN APP_LED_PatternGet(void)
+{
+    return appLed.pattern;
+}
+
+uint16_t APP_LED_DutyGet(void)
+{
+    return appLed.steps[appLed.step].duty;
+}
+
+
+/*******************************************************************************
+ End of File
+ */
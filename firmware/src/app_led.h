@@ -0,0 +1,116 @@
+/*******************************************************************************
+  Indicator LED Engine Header File
+
+  File Name:
+    app_led.h
+
+  Summary:
+    Brightness levels, breathing and blink codes on the indicator LED.
+
+  Description:
+    LED_INDICATOR (RA4) is mapped to OC3 through PPS and driven as a PWM
+    output from TMR3 (5 MHz, PR3 = 6249, an 800 Hz PWM period). A pattern is
+    a precomputed table of steps, each a duty cycle and the number of PWM
+    periods to hold it. The TMR3 period interrupt walks the table, so a
+    pattern costs no main-loop time. A steady level is a one-step pattern
+    and leaves the TMR3 interrupt disabled, so it costs no CPU time at all.
+
+    Every function in this file may be called from thread or interrupt
+    context.
+*******************************************************************************/
+
+#ifndef _APP_LED_H
+#define _APP_LED_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Steady brightness levels, 0 (off) to APP_LED_LEVELS - 1 (full) */
+#define APP_LED_LEVELS              8
+
+/* Longest blink code APP_LED_BlinkCode shows */
+#define APP_LED_CODE_MAX            8
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Indicator LED Pattern
+
+  Summary:
+    Kind of pattern the indicator LED is showing.
+
+  Description:
+    OFF and STEADY are one-step patterns. BREATHE and CODE are advanced by the
+    TMR3 period interrupt.
+*/
+
+typedef enum
+{
+    APP_LED_PATTERN_OFF = 0,
+    APP_LED_PATTERN_STEADY,
+    APP_LED_PATTERN_BREATHE,
+    APP_LED_PATTERN_CODE
+
+} APP_LED_PATTERN;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Registers the TMR3 callback, starts OC3 and TMR3 and turns the LED off.
+   OCMP3_Initialize and TMR3_Initialize must have run. */
+void APP_LED_Initialize(void);
+
+/* Steady brightness. Level 0 is off, higher levels are clamped to
+   APP_LED_LEVELS - 1. The steps are gamma corrected. */
+void APP_LED_LevelSet(uint8_t level);
+
+/* Slow, dim breathing, about 1.5 s per breath */
+void APP_LED_Breathe(void);
+
+/* "count" short flashes, then a pause, repeated. Zero turns the LED off and
+   counts above APP_LED_CODE_MAX are clamped. */
+void APP_LED_BlinkCode(uint8_t count);
+
+APP_LED_PATTERN APP_LED_PatternGet(void);
+
+/* OC3RS value of the current step */
+uint16_t APP_LED_DutyGet(void);
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif /* _APP_LED_H */
+
+/*******************************************************************************
+ End of File
+ */
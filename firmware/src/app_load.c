@@ -0,0 +1,143 @@
+/*******************************************************************************
+  CPU Load Service Implementation
+
+  File Name:
+    app_load.c
+
+  Summary:
+    Cycle accounting for the interrupt handlers and the polled tasks.
+
+  Description:
+    appLoadAccounted is a running total of every tick charged to any slot.
+    A measured call notes it on entry; on exit the growth since then is the
+    time of the interrupts that preempted the call, which is taken off what
+    the call itself is charged. Nesting to any depth works out the same way.
+
+    The first measured call to end after APP_LOAD_WINDOW_MS closes the
+    window: it moves the running totals into the last window and clears
+    them. Closing windows this way needs no timer, so the time service can
+    still stop TMR2 while nothing else is armed.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "app_load.h"
+#include "system/int/sys_int.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Window length in CP0 Count ticks */
+#define APP_LOAD_WINDOW_CYCLES      (APP_LOAD_WINDOW_MS * (APP_TIME_COUNTER_FREQUENCY / 1000U))
+
+static uint32_t appLoadAccounted;
+
+static uint32_t appLoadWindowStart;
+
+/* Running totals of the current window, and the last complete window */
+static APP_LOAD_SLOT_STATISTICS appLoadCurrent[APP_LOAD_SLOTS];
+
+static APP_LOAD_STATISTICS appLoadLast;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Called with interrupts disabled */
+static void _APP_LOAD_WindowEnd( uint32_t now )
+{
+    uint32_t busy = 0;
+    uint32_t i;
+
+    for (i = 0; i < APP_LOAD_SLOTS; i++)
+    {
+        busy += appLoadCurrent[i].cycles;
+    }
+
+    memcpy(appLoadLast.slot, appLoadCurrent, sizeof(appLoadLast.slot));
+    memset(appLoadCurrent, 0, sizeof(appLoadCurrent));
+
+    appLoadLast.windowCycles = now - appLoadWindowStart;
+    appLoadLast.idleCycles = (busy < appLoadLast.windowCycles) ? (appLoadLast.windowCycles - busy) : 0U;
+    appLoadLast.window++;
+    appLoadWindowStart = now;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+void APP_LOAD_Initialize( void )
+{
+    memset(appLoadCurrent, 0, sizeof(appLoadCurrent));
+    memset(&appLoadLast, 0, sizeof(appLoadLast));
+
+    appLoadAccounted = 0;
+    appLoadWindowStart = APP_TIME_Counter32Get();
+}
+
+void APP_LOAD_Enter( APP_LOAD_PROBE * probe )
+{
+    bool interruptState = SYS_INT_Disable();
+
+    probe->accounted = appLoadAccounted;
+    probe->start = APP_TIME_Counter32Get();
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_LOAD_Exit( APP_LOAD_SLOT slot, const APP_LOAD_PROBE * probe )
+{
+    APP_LOAD_SLOT_STATISTICS * statistics = &appLoadCurrent[slot];
+    uint32_t now;
+    uint32_t cycles;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    now = APP_TIME_Counter32Get();
+
+    /* Elapsed, less what nested interrupts were charged meanwhile */
+    cycles = (now - probe->start) - (appLoadAccounted - probe->accounted);
+    appLoadAccounted += cycles;
+
+    statistics->cycles += cycles;
+    statistics->count++;
+    if (cycles > statistics->maxCycles)
+    {
+        statistics->maxCycles = cycles;
+    }
+
+    if ((now - appLoadWindowStart) >= APP_LOAD_WINDOW_CYCLES)
+    {
+        _APP_LOAD_WindowEnd(now);
+    }
+
+    SYS_INT_Restore(interruptState);
+}
+
+void APP_LOAD_StatisticsGet( APP_LOAD_STATISTICS * statistics )
+{
+    bool interruptState = SYS_INT_Disable();
+
+    *statistics = appLoadLast;
+
+    SYS_INT_Restore(interruptState);
+}
+
+uint32_t APP_LOAD_WindowGet( void )
+{
+    return appLoadLast.window;
+}
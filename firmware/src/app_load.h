@@ -0,0 +1,198 @@
+/*******************************************************************************
+  CPU Load Service Interface Definition
+
+  File Name:
+    app_load.h
+
+  Summary:
+    Cycle accounting for the interrupt handlers and the polled tasks.
+
+  Description:
+    Every interrupt handler in interrupts.c and every task called from
+    SYS_Tasks runs inside APP_LOAD_MEASURE, which charges the CP0 Count ticks
+    it took to one slot. Time spent in a nested interrupt is charged to that
+    interrupt only, not also to the code it preempted. The totals are kept per
+    window of APP_LOAD_WINDOW_MS; APP_LOAD_StatisticsGet returns the last
+    complete window.
+
+    Idle is the part of a window that no slot was charged for: the main loop
+    itself and interrupt entry and exit. The tasks are polled, so their share
+    includes polling with nothing to do; the average and worst case cost per
+    call are the better measure of headroom.
+
+    Without APP_LOAD_ENABLE in configuration.h APP_LOAD_MEASURE just runs its
+    statement and the service is not built in.
+*******************************************************************************/
+
+#ifndef APP_LOAD_H
+#define APP_LOAD_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "app_time.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* CPU Load Slots
+
+  Summary:
+    What the cycles are charged to.
+
+  Remarks:
+    The order is the order of the statistics report, so new slots go at the
+    end of their group and the report layout in app.h follows.
+*/
+
+typedef enum
+{
+    /* Interrupt handlers */
+    APP_LOAD_USB_1 = 0,
+    APP_LOAD_CHANGE_NOTICE,
+    APP_LOAD_UART_1,
+    APP_LOAD_TIMER_2,
+    APP_LOAD_TIMER_3,
+    APP_LOAD_CORE_TIMER,
+
+    /* Tasks called from SYS_Tasks */
+    APP_LOAD_DRV_USBFS_TASKS,
+    APP_LOAD_USB_DEVICE_TASKS,
+    APP_LOAD_APP_TASKS,
+
+    APP_LOAD_SLOTS
+
+} APP_LOAD_SLOT;
+
+typedef struct
+{
+    /* CP0 Count ticks charged in the window */
+    uint32_t cycles;
+
+    /* Calls in the window */
+    uint32_t count;
+
+    /* Longest single call in the window, in ticks */
+    uint32_t maxCycles;
+
+} APP_LOAD_SLOT_STATISTICS;
+
+typedef struct
+{
+    /* Number of the window, counting from 1; 0 until the first one ends */
+    uint32_t window;
+
+    /* Length of the window in ticks, and the part of it no slot took */
+    uint32_t windowCycles;
+
+    uint32_t idleCycles;
+
+    APP_LOAD_SLOT_STATISTICS slot[APP_LOAD_SLOTS];
+
+} APP_LOAD_STATISTICS;
+
+/* Taken when a measured call starts; used only by APP_LOAD_MEASURE */
+typedef struct
+{
+    uint32_t start;
+
+    uint32_t accounted;
+
+} APP_LOAD_PROBE;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Functions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Macro:
+    APP_LOAD_MEASURE( slot, statement )
+
+  Summary:
+    Runs "statement" and charges the ticks it took to "slot".
+
+  Description:
+    Costs two short critical sections, a few tens of cycles, per call. The
+    call that ends after the window is over also closes the window.
+
+  Example:
+    <code>
+    APP_LOAD_MEASURE(APP_LOAD_APP_TASKS, APP_Tasks());
+    </code>
+*/
+
+#if defined(APP_LOAD_ENABLE)
+#define APP_LOAD_MEASURE(slot, statement)                                   \
+    do {                                                                    \
+        APP_LOAD_PROBE _appLoadProbe;                                       \
+        APP_LOAD_Enter(&_appLoadProbe);                                     \
+        statement;                                                          \
+        APP_LOAD_Exit((slot), &_appLoadProbe);                              \
+    } while (0)
+#else
+#define APP_LOAD_MEASURE(slot, statement)   do { statement; } while (0)
+#endif
+
+// *****************************************************************************
+/* Function:
+    void APP_LOAD_Initialize( void )
+
+  Summary:
+    Clears the statistics and starts the first window.
+
+  Remarks:
+    Only needs CP0 Count, so it can run before any other service.
+*/
+
+void APP_LOAD_Initialize( void );
+
+void APP_LOAD_Enter( APP_LOAD_PROBE * probe );
+
+void APP_LOAD_Exit( APP_LOAD_SLOT slot, const APP_LOAD_PROBE * probe );
+
+// *****************************************************************************
+/* Function:
+    void APP_LOAD_StatisticsGet( APP_LOAD_STATISTICS * statistics )
+
+  Summary:
+    Copies the statistics of the last complete window.
+
+  Description:
+    Safe to call from interrupt context. "window" changes each time a new
+    window is available.
+*/
+
+void APP_LOAD_StatisticsGet( APP_LOAD_STATISTICS * statistics );
+
+/* Number of the last complete window, a cheap way to poll for a new one */
+uint32_t APP_LOAD_WindowGet( void );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+
+    }
+
+#endif
+//DOM-IGNORE-END
+
+#endif //APP_LOAD_H
@@ -0,0 +1,580 @@
+/*******************************************************************************
+  Software Timer Service Implementation
+
+  File Name:
+    app_time.c
+
+  Summary:
+    Tickless software timers on one 16-bit hardware timer.
+
+  Description:
+    The hardware timer counts up from zero and raises its interrupt when it
+    matches the period register, then restarts from zero. Instead of a fixed
+    tick, the period is set so that the match falls on the nearest timer
+    deadline (or as far as 16 bits reach, when the deadline is further out).
+    The interrupt adds the finished period to a 32-bit software base, fires
+    the expired timers and programs the next period.
+
+    The period is only changed while the counter is still at least
+    APP_TIME_PERIOD_UPDATE_MARGIN counts below both the old and the new
+    match value, and never while a match is pending. The counter therefore
+    never runs past the period register, and the software base always knows
+    the length of the period that just ended.
+
+    The 64-bit counter adds a wrap count to CP0 Count. A wrap is recognized
+    when a reading is below the previous one, which only works if the count
+    is read at least once per wrap; the core timer interrupt makes sure of
+    that by reading it every half wrap.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stddef.h>
+#include "app_time.h"
+#include "app_time_local.h"
+#include "system/int/sys_int.h"
+#include "peripheral/coretimer/plib_coretimer.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+static APP_TIME_COUNTER_OBJ gSystemCounterObj;
+
+static APP_TIME_TIMER_OBJ timers[APP_TIME_MAX_TIMERS];
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local Functions
+// *****************************************************************************
+// *****************************************************************************
+
+/* The functions below take and return with interrupts disabled */
+
+static uint32_t _APP_TIME_NowGet( void )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    uint32_t counter = counterObj->timePlib->timerCounterGet();
+
+    if (SYS_INT_SourceStatusGet(counterObj->hwTimerIntNum))
+    {
+        /* The period ended and its interrupt has not run yet. The counter
+           has restarted, read it again. */
+        counter = counterObj->timePlib->timerCounterGet();
+        return counterObj->swCounterBase + counterObj->hwTimerPeriod + counter;
+    }
+
+    return counterObj->swCounterBase + counter;
+}
+
+static APP_TIME_TIMER_OBJ * _APP_TIME_TimerObjectGet( APP_TIME_HANDLE handle )
+{
+    uint32_t index = _APP_TIME_HANDLE_INDEX(handle);
+
+    if ((handle == APP_TIME_HANDLE_INVALID) || (index >= APP_TIME_MAX_TIMERS))
+    {
+        return NULL;
+    }
+
+    if ((timers[index].inUse == false) || (timers[index].tmrToken != _APP_TIME_HANDLE_TOKEN(handle)))
+    {
+        return NULL;
+    }
+
+    return &timers[index];
+}
+
+static void _APP_TIME_TimerRemove( APP_TIME_TIMER_OBJ * tmr )
+{
+    APP_TIME_TIMER_OBJ ** link = &gSystemCounterObj.tmrActive;
+
+    while (*link != NULL)
+    {
+        if (*link == tmr)
+        {
+            *link = tmr->tmrNext;
+            break;
+        }
+        link = &(*link)->tmrNext;
+    }
+
+    tmr->tmrNext = NULL;
+    tmr->active = false;
+}
+
+static void _APP_TIME_TimerInsert( APP_TIME_TIMER_OBJ * tmr )
+{
+    APP_TIME_TIMER_OBJ ** link = &gSystemCounterObj.tmrActive;
+
+    /* After the timers with the same expiry, so equal deadlines fire in the
+       order they were armed */
+    while ((*link != NULL) && ((int32_t)((*link)->expiry - tmr->expiry) <= 0))
+    {
+        link = &(*link)->tmrNext;
+    }
+
+    tmr->tmrNext = *link;
+    *link = tmr;
+    tmr->active = true;
+}
+
+static void _APP_TIME_HwTimerUpdate( void )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    uint32_t counter;
+    uint32_t period;
+    int32_t remaining;
+
+    if (counterObj->tmrActive == NULL)
+    {
+        if (counterObj->hwTimerIsRunning)
+        {
+            counterObj->timePlib->timerStop();
+            counterObj->hwTimerIsRunning = false;
+        }
+        return;
+    }
+
+    if (SYS_INT_SourceStatusGet(counterObj->hwTimerIntNum))
+    {
+        /* The interrupt is about to run and will program the period */
+        return;
+    }
+
+    counter = counterObj->timePlib->timerCounterGet();
+    remaining = (int32_t)(counterObj->tmrActive->expiry - (counterObj->swCounterBase + counter));
+
+    /* The match falls on counter + remaining - 1, since the counter restarts
+       from zero one count after it */
+    if (remaining > (int32_t)(APP_TIME_HW_COUNTER_PERIOD + 1U - counter))
+    {
+        period = APP_TIME_HW_COUNTER_PERIOD;
+    }
+    else if (remaining > (int32_t)APP_TIME_PERIOD_UPDATE_MARGIN)
+    {
+        period = counter + (uint32_t)remaining - 1U;
+    }
+    else
+    {
+        period = counter + APP_TIME_PERIOD_UPDATE_MARGIN;
+    }
+
+    if ((counter + APP_TIME_PERIOD_UPDATE_MARGIN < counterObj->hwTimerPeriod - 1U) &&
+            (period <= APP_TIME_HW_COUNTER_PERIOD))
+    {
+        counterObj->timePlib->timerPeriodSet((uint16_t)period);
+        counterObj->hwTimerPeriod = period + 1U;
+    }
+    /* else the current period ends within the margin and its interrupt
+       programs the next one */
+
+    if (counterObj->hwTimerIsRunning == false)
+    {
+        counterObj->timePlib->timerStart();
+        counterObj->hwTimerIsRunning = true;
+    }
+}
+
+static void _APP_TIME_HwTimerCallback( uint32_t status, uintptr_t context )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    APP_TIME_TIMER_OBJ * tmr;
+    APP_TIME_CALLBACK callback;
+    uintptr_t callbackContext;
+    uint32_t now;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+    counterObj->swCounterBase += counterObj->hwTimerPeriod;
+    SYS_INT_Restore(interruptState);
+
+    while (true)
+    {
+        callback = NULL;
+
+        interruptState = SYS_INT_Disable();
+
+        now = _APP_TIME_NowGet();
+        tmr = counterObj->tmrActive;
+
+        if ((tmr == NULL) || ((int32_t)(tmr->expiry - now) > 0))
+        {
+            _APP_TIME_HwTimerUpdate();
+            SYS_INT_Restore(interruptState);
+            break;
+        }
+
+        _APP_TIME_TimerRemove(tmr);
+
+        if (tmr->type == APP_TIME_PERIODIC)
+        {
+            tmr->expiry += tmr->period;
+            if ((int32_t)(tmr->expiry - now) <= 0)
+            {
+                /* Fell a whole period behind, drop the missed expiries */
+                tmr->expiry = now + tmr->period;
+            }
+            _APP_TIME_TimerInsert(tmr);
+        }
+        else if (tmr->autoDelete)
+        {
+            tmr->inUse = false;
+        }
+
+        callback = tmr->callback;
+        callbackContext = tmr->context;
+
+        SYS_INT_Restore(interruptState);
+
+        /* Called with the list consistent, so it may start or stop timers */
+        if (callback != NULL)
+        {
+            callback(callbackContext);
+        }
+    }
+}
+
+static void _APP_TIME_CoreTimerCallback( uint32_t status, uintptr_t context )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+
+    (void)APP_TIME_Counter64Get();
+
+    counterObj->cpuCounterCompare += 0x80000000U;
+    CORETIMER_CompareSet(counterObj->cpuCounterCompare);
+}
+
+static APP_TIME_HANDLE _APP_TIME_TimerAllocate( uint32_t count, uint32_t period, APP_TIME_CALLBACK callBack, uintptr_t context, APP_TIME_CALLBACK_TYPE type, bool autoDelete )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    APP_TIME_HANDLE handle = APP_TIME_HANDLE_INVALID;
+    APP_TIME_TIMER_OBJ * tmr;
+    bool interruptState;
+    uint32_t index;
+
+    if ((counterObj->status != SYS_STATUS_READY) || (period == 0U) ||
+            (period > _APP_TIME_PERIOD_MAX) || (count >= period))
+    {
+        return APP_TIME_HANDLE_INVALID;
+    }
+
+    interruptState = SYS_INT_Disable();
+
+    for (index = 0; index < APP_TIME_MAX_TIMERS; index++)
+    {
+        tmr = &timers[index];
+        if (tmr->inUse == false)
+        {
+            tmr->inUse = true;
+            tmr->active = false;
+            tmr->autoDelete = autoDelete;
+            tmr->type = type;
+            tmr->relativeTimePending = period - count;
+            tmr->period = period;
+            tmr->callback = callBack;
+            tmr->context = context;
+            tmr->tmrNext = NULL;
+
+            if (++counterObj->tmrTokenCount == 0U)
+            {
+                counterObj->tmrTokenCount = 1;
+            }
+            tmr->tmrToken = counterObj->tmrTokenCount;
+
+            handle = _APP_TIME_HANDLE_MAKE(tmr->tmrToken, index);
+            break;
+        }
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return handle;
+}
+
+static APP_TIME_HANDLE _APP_TIME_CallbackRegister( APP_TIME_CALLBACK callback, uintptr_t context, uint32_t count, APP_TIME_CALLBACK_TYPE type )
+{
+    APP_TIME_HANDLE handle;
+
+    handle = _APP_TIME_TimerAllocate(0, (count == 0U) ? 1U : count, callback, context, type, (type == APP_TIME_SINGLE));
+
+    if ((handle != APP_TIME_HANDLE_INVALID) && (APP_TIME_TimerStart(handle) != APP_TIME_SUCCESS))
+    {
+        APP_TIME_TimerDestroy(handle);
+        handle = APP_TIME_HANDLE_INVALID;
+    }
+
+    return handle;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Initialization
+// *****************************************************************************
+// *****************************************************************************
+
+SYS_MODULE_OBJ APP_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODULE_INIT * const init )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    const APP_TIME_INIT * initData = (const APP_TIME_INIT *)init;
+    uint32_t i;
+
+    if ((index != APP_TIME_INDEX_0) || (initData == NULL))
+    {
+        return SYS_MODULE_OBJ_INVALID;
+    }
+
+    for (i = 0; i < APP_TIME_MAX_TIMERS; i++)
+    {
+        timers[i].inUse = false;
+        timers[i].active = false;
+        timers[i].tmrNext = NULL;
+    }
+
+    counterObj->timePlib = initData->timePlib;
+    counterObj->hwTimerIntNum = initData->hwTimerIntNum;
+    counterObj->hwTimerFrequency = counterObj->timePlib->timerFrequencyGet();
+    counterObj->swCounterBase = 0;
+    counterObj->tmrTokenCount = 0;
+    counterObj->tmrActive = NULL;
+
+    /* Stopped until a timer is armed. The counter starts from zero and the
+       first period runs to the end of the counter range. */
+    counterObj->timePlib->timerStop();
+    counterObj->timePlib->timerPeriodSet(APP_TIME_HW_COUNTER_PERIOD);
+    counterObj->hwTimerPeriod = APP_TIME_HW_COUNTER_PERIOD + 1U;
+    counterObj->hwTimerIsRunning = false;
+
+    counterObj->timePlib->timerCallbackSet(_APP_TIME_HwTimerCallback, (uintptr_t)NULL);
+
+    /* Count has been running since reset and may already have wrapped; the
+       wraps are counted from here */
+    counterObj->cpuCounterHigh = 0;
+    counterObj->cpuCounterLast = APP_TIME_Counter32Get();
+    counterObj->cpuCounterCompare = counterObj->cpuCounterLast + 0x80000000U;
+    CORETIMER_CallbackSet(_APP_TIME_CoreTimerCallback, (uintptr_t)NULL);
+    CORETIMER_CompareSet(counterObj->cpuCounterCompare);
+    CORETIMER_InterruptEnable();
+
+    counterObj->status = SYS_STATUS_READY;
+
+    return (SYS_MODULE_OBJ)counterObj;
+}
+
+SYS_STATUS APP_TIME_Status( SYS_MODULE_OBJ object )
+{
+    if (object != (SYS_MODULE_OBJ)&gSystemCounterObj)
+    {
+        return SYS_STATUS_UNINITIALIZED;
+    }
+
+    return gSystemCounterObj.status;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timers
+// *****************************************************************************
+// *****************************************************************************
+
+APP_TIME_HANDLE APP_TIME_TimerCreate( uint32_t count, uint32_t period, APP_TIME_CALLBACK callBack, uintptr_t context, APP_TIME_CALLBACK_TYPE type )
+{
+    return _APP_TIME_TimerAllocate(count, period, callBack, context, type, false);
+}
+
+APP_TIME_RESULT APP_TIME_TimerStart( APP_TIME_HANDLE handle )
+{
+    APP_TIME_RESULT result = APP_TIME_ERROR;
+    APP_TIME_TIMER_OBJ * tmr;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    tmr = _APP_TIME_TimerObjectGet(handle);
+    if (tmr != NULL)
+    {
+        if (tmr->active)
+        {
+            _APP_TIME_TimerRemove(tmr);
+        }
+
+        tmr->expiry = _APP_TIME_NowGet() + tmr->relativeTimePending;
+        tmr->relativeTimePending = tmr->period;
+        _APP_TIME_TimerInsert(tmr);
+
+        if (gSystemCounterObj.tmrActive == tmr)
+        {
+            /* New nearest deadline */
+            _APP_TIME_HwTimerUpdate();
+        }
+
+        result = APP_TIME_SUCCESS;
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return result;
+}
+
+APP_TIME_RESULT APP_TIME_TimerStop( APP_TIME_HANDLE handle )
+{
+    APP_TIME_RESULT result = APP_TIME_ERROR;
+    APP_TIME_TIMER_OBJ * tmr;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    tmr = _APP_TIME_TimerObjectGet(handle);
+    if (tmr != NULL)
+    {
+        if (tmr->active)
+        {
+            _APP_TIME_TimerRemove(tmr);
+
+            if (gSystemCounterObj.tmrActive == NULL)
+            {
+                _APP_TIME_HwTimerUpdate();
+            }
+            /* else the next match is early at worst, and reprograms */
+        }
+
+        result = APP_TIME_SUCCESS;
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return result;
+}
+
+APP_TIME_RESULT APP_TIME_TimerDestroy( APP_TIME_HANDLE handle )
+{
+    APP_TIME_RESULT result = APP_TIME_ERROR;
+    APP_TIME_TIMER_OBJ * tmr;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    if (APP_TIME_TimerStop(handle) == APP_TIME_SUCCESS)
+    {
+        tmr = _APP_TIME_TimerObjectGet(handle);
+        tmr->inUse = false;
+        result = APP_TIME_SUCCESS;
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return result;
+}
+
+bool APP_TIME_TimerIsActive( APP_TIME_HANDLE handle )
+{
+    APP_TIME_TIMER_OBJ * tmr;
+    bool isActive = false;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    tmr = _APP_TIME_TimerObjectGet(handle);
+    if (tmr != NULL)
+    {
+        isActive = tmr->active;
+    }
+
+    SYS_INT_Restore(interruptState);
+
+    return isActive;
+}
+
+APP_TIME_HANDLE APP_TIME_CallbackRegisterMS( APP_TIME_CALLBACK callback, uintptr_t context, uint32_t ms, APP_TIME_CALLBACK_TYPE type )
+{
+    return _APP_TIME_CallbackRegister(callback, context, APP_TIME_MSToCount(ms), type);
+}
+
+APP_TIME_HANDLE APP_TIME_CallbackRegisterUS( APP_TIME_CALLBACK callback, uintptr_t context, uint32_t us, APP_TIME_CALLBACK_TYPE type )
+{
+    return _APP_TIME_CallbackRegister(callback, context, APP_TIME_USToCount(us), type);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Conversions
+// *****************************************************************************
+// *****************************************************************************
+
+uint32_t APP_TIME_FrequencyGet( void )
+{
+    return gSystemCounterObj.hwTimerFrequency;
+}
+
+/* Rounded up, so that a timer never fires before the time asked for */
+uint32_t APP_TIME_MSToCount( uint32_t ms )
+{
+    uint64_t count = (((uint64_t)ms * gSystemCounterObj.hwTimerFrequency) + 999U) / 1000U;
+
+    return (count > _APP_TIME_PERIOD_MAX) ? _APP_TIME_PERIOD_MAX : (uint32_t)count;
+}
+
+uint32_t APP_TIME_USToCount( uint32_t us )
+{
+    uint64_t count = (((uint64_t)us * gSystemCounterObj.hwTimerFrequency) + 999999U) / 1000000U;
+
+    return (count > _APP_TIME_PERIOD_MAX) ? _APP_TIME_PERIOD_MAX : (uint32_t)count;
+}
+
+uint32_t APP_TIME_CountToMS( uint32_t count )
+{
+    return (uint32_t)(((uint64_t)count * 1000U) / gSystemCounterObj.hwTimerFrequency);
+}
+
+uint32_t APP_TIME_CountToUS( uint32_t count )
+{
+    return (uint32_t)(((uint64_t)count * 1000000U) / gSystemCounterObj.hwTimerFrequency);
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: High Resolution Counter
+// *****************************************************************************
+// *****************************************************************************
+
+uint64_t APP_TIME_Counter64Get( void )
+{
+    APP_TIME_COUNTER_OBJ * counterObj = &gSystemCounterObj;
+    uint32_t counter;
+    uint64_t value;
+    bool interruptState;
+
+    interruptState = SYS_INT_Disable();
+
+    counter = APP_TIME_Counter32Get();
+    if (counter < counterObj->cpuCounterLast)
+    {
+        counterObj->cpuCounterHigh++;
+    }
+    counterObj->cpuCounterLast = counter;
+    value = ((uint64_t)counterObj->cpuCounterHigh << 32) | counter;
+
+    SYS_INT_Restore(interruptState);
+
+    return value;
+}
+
+uint64_t APP_TIME_Counter64ToUS( uint64_t ticks )
+{
+    return ticks / APP_TIME_COUNTER_TICKS_PER_US;
+}
+
+uint64_t APP_TIME_USToCounter64( uint64_t us )
+{
+    return us * APP_TIME_COUNTER_TICKS_PER_US;
+}
+
+uint32_t APP_TIME_CounterElapsedUS( uint32_t start )
+{
+    return (APP_TIME_Counter32Get() - start) / APP_TIME_COUNTER_TICKS_PER_US;
+}
@@ -0,0 +1,307 @@
+/*******************************************************************************
+  Software Timer Service Interface Definition
+
+  File Name:
+    app_time.h
+
+  Summary:
+    Software timer service interface.
+
+  Description:
+    The timer service runs one-shot and periodic software timers on a single
+    hardware timer. Armed timers are kept in a list sorted by expiry
+    and the hardware period is reprogrammed to the nearest deadline, so the
+    timer interrupt fires once per expiry rather than at a fixed tick. With no
+    timer armed the hardware timer is stopped.
+
+    Callbacks run in the context of the hardware timer interrupt. They may
+    start, stop and create timers, but should be short.
+
+    Separately, the service extends the CP0 Count register to a monotonic
+    64-bit counter for timestamps. It runs whether or not a timer is armed.
+*******************************************************************************/
+
+#ifndef APP_TIME_H
+#define APP_TIME_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "device.h"
+#include "system/system_module.h"
+#include "app_time_definitions.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Software Timer Service Timer Handle
+
+  Summary:
+    Handle to a software timer.
+
+  Description:
+    Returned by APP_TIME_TimerCreate and the APP_TIME_CallbackRegister
+    functions. A handle goes stale when its timer is destroyed, and the
+    service rejects it from then on.
+
+  Remarks:
+    Code outside the service should treat this as an opaque value.
+*/
+
+typedef uintptr_t APP_TIME_HANDLE;
+
+#define APP_TIME_HANDLE_INVALID         ((APP_TIME_HANDLE)(-1))
+
+// *****************************************************************************
+/* Software Timer Service Results
+
+  Summary:
+    Result of a timer operation.
+*/
+
+typedef enum
+{
+    APP_TIME_SUCCESS = 0,
+
+    APP_TIME_ERROR = -1
+
+} APP_TIME_RESULT;
+
+// *****************************************************************************
+/* Software Timer Service Callback Type
+
+  Summary:
+    Whether a timer fires once or repeatedly.
+
+  Description:
+    A APP_TIME_SINGLE timer is stopped when it fires; if it was made by a
+    APP_TIME_CallbackRegister function it is also destroyed. A
+    APP_TIME_PERIODIC timer is re-armed one period after its previous
+    deadline, so it does not drift with interrupt latency.
+*/
+
+typedef enum
+{
+    APP_TIME_SINGLE = 0,
+
+    APP_TIME_PERIODIC
+
+} APP_TIME_CALLBACK_TYPE;
+
+// *****************************************************************************
+/* Software Timer Service Callback
+
+  Summary:
+    Function called when a timer expires.
+
+  Description:
+    "context" is the value given when the timer was created. The callback
+    runs in interrupt context.
+*/
+
+typedef void (*APP_TIME_CALLBACK)( uintptr_t context );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Initialization
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    SYS_MODULE_OBJ APP_TIME_Initialize( const SYS_MODULE_INDEX index,
+                                        const SYS_MODULE_INIT * const init )
+
+  Summary:
+    Initializes the software timer service.
+
+  Description:
+    Registers the service with the hardware timer PLIB. The hardware timer is
+    left stopped until the first timer is started.
+
+  Precondition:
+    The hardware timer PLIB has been initialized.
+
+  Parameters:
+    index - APP_TIME_INDEX_0
+    init  - Pointer to a APP_TIME_INIT structure
+
+  Returns:
+    The service object, or SYS_MODULE_OBJ_INVALID.
+*/
+
+SYS_MODULE_OBJ APP_TIME_Initialize( const SYS_MODULE_INDEX index, const SYS_MODULE_INIT * const init );
+
+SYS_STATUS APP_TIME_Status( SYS_MODULE_OBJ object );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Timers
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    APP_TIME_HANDLE APP_TIME_TimerCreate( uint32_t count, uint32_t period,
+        APP_TIME_CALLBACK callBack, uintptr_t context, APP_TIME_CALLBACK_TYPE type )
+
+  Summary:
+    Creates a stopped software timer.
+
+  Description:
+    "period" is in counts of APP_TIME_FrequencyGet. "count" is the part of
+    the first period taken as already elapsed, normally 0: the first expiry
+    after APP_TIME_TimerStart comes period - count counts later, every later
+    one a full period later.
+
+  Parameters:
+    count    - Counts of the first period already elapsed (less than period)
+    period   - Timer period in counts, 1 to 0x7FFFFFFF
+    callBack - Function called on expiry, or NULL
+    context  - Value passed to callBack
+    type     - APP_TIME_SINGLE or APP_TIME_PERIODIC
+
+  Returns:
+    A timer handle, or APP_TIME_HANDLE_INVALID if the parameters are out of
+    range or all APP_TIME_MAX_TIMERS timers are in use.
+*/
+
+APP_TIME_HANDLE APP_TIME_TimerCreate( uint32_t count, uint32_t period, APP_TIME_CALLBACK callBack, uintptr_t context, APP_TIME_CALLBACK_TYPE type );
+
+// *****************************************************************************
+/* Function:
+    APP_TIME_RESULT APP_TIME_TimerStart( APP_TIME_HANDLE handle )
+
+  Summary:
+    Arms a timer.
+
+  Description:
+    Starting a timer that is already armed restarts its current period from
+    now, which is how a timeout is pushed back.
+*/
+
+APP_TIME_RESULT APP_TIME_TimerStart( APP_TIME_HANDLE handle );
+
+APP_TIME_RESULT APP_TIME_TimerStop( APP_TIME_HANDLE handle );
+
+APP_TIME_RESULT APP_TIME_TimerDestroy( APP_TIME_HANDLE handle );
+
+bool APP_TIME_TimerIsActive( APP_TIME_HANDLE handle );
+
+// *****************************************************************************
+/* Function:
+    APP_TIME_HANDLE APP_TIME_CallbackRegisterMS( APP_TIME_CALLBACK callback,
+        uintptr_t context, uint32_t ms, APP_TIME_CALLBACK_TYPE type )
+
+  Summary:
+    Creates and starts a timer that calls "callback" after "ms" milliseconds.
+
+  Description:
+    A APP_TIME_SINGLE timer created this way is destroyed after it fires, so
+    its handle is only needed to cancel it with APP_TIME_TimerDestroy.
+    APP_TIME_CallbackRegisterUS is the same in microseconds.
+*/
+
+APP_TIME_HANDLE APP_TIME_CallbackRegisterMS( APP_TIME_CALLBACK callback, uintptr_t context, uint32_t ms, APP_TIME_CALLBACK_TYPE type );
+
+APP_TIME_HANDLE APP_TIME_CallbackRegisterUS( APP_TIME_CALLBACK callback, uintptr_t context, uint32_t us, APP_TIME_CALLBACK_TYPE type );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Conversions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Frequency of the counts used by the timers, in Hz */
+uint32_t APP_TIME_FrequencyGet( void );
+
+uint32_t APP_TIME_MSToCount( uint32_t ms );
+
+uint32_t APP_TIME_USToCount( uint32_t us );
+
+uint32_t APP_TIME_CountToMS( uint32_t count );
+
+uint32_t APP_TIME_CountToUS( uint32_t count );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: High Resolution Counter
+// *****************************************************************************
+// *****************************************************************************
+
+/* CP0 Count runs at SYSCLK / 2 */
+#define APP_TIME_COUNTER_FREQUENCY          (APP_TIME_CPU_CLOCK_FREQUENCY / 2U)
+
+#define APP_TIME_COUNTER_TICKS_PER_US       (APP_TIME_COUNTER_FREQUENCY / 1000000U)
+
+// *****************************************************************************
+/* Function:
+    uint32_t APP_TIME_Counter32Get( void )
+
+  Summary:
+    Returns the raw 32-bit CP0 Count.
+
+  Description:
+    One instruction, and valid from reset. The count wraps every 2^32 ticks
+    (about 214 s at 20 MHz), so it is meant for intervals shorter than that,
+    taken as the unsigned difference of two readings.
+*/
+
+#define APP_TIME_Counter32Get()             ((uint32_t)_CP0_GET_COUNT())
+
+// *****************************************************************************
+/* Function:
+    uint64_t APP_TIME_Counter64Get( void )
+
+  Summary:
+    Returns CP0 Count extended to 64 bits.
+
+  Description:
+    The upper 32 bits count the wraps of CP0 Count since it was first read.
+    The value never goes backwards and does not wrap in the life of the
+    device. Safe to call from any interrupt; it only masks interrupts for the
+    few instructions that compare and store the last reading.
+
+  Precondition:
+    APP_TIME_Initialize has been called, which arms the core timer interrupt
+    that reads the count twice per wrap. Without it a wrap goes unseen if
+    nothing else reads the count for 214 s.
+*/
+
+uint64_t APP_TIME_Counter64Get( void );
+
+/* Ticks of APP_TIME_COUNTER_FREQUENCY to and from microseconds */
+uint64_t APP_TIME_Counter64ToUS( uint64_t ticks );
+
+uint64_t APP_TIME_USToCounter64( uint64_t us );
+
+/* Microseconds since an earlier APP_TIME_Counter32Get reading */
+uint32_t APP_TIME_CounterElapsedUS( uint32_t start );
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+
+    }
+
+#endif
+//DOM-IGNORE-END
+
+#endif //APP_TIME_H
@@ -0,0 +1,120 @@
+/*******************************************************************************
+  Software Timer Service Definitions Header File
+
+  File Name:
+    app_time_definitions.h
+
+  Summary:
+    Software timer service data types used by the configuration.
+
+  Description:
+    This file contains the initialization data and the hardware timer PLIB
+    interface of the software timer service. They are filled in by
+    initialization.c.
+*******************************************************************************/
+
+#ifndef APP_TIME_DEFINITIONS_H
+#define APP_TIME_DEFINITIONS_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "system/system_module.h"
+#include "system/int/sys_int.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Software Timer Service PLIB Interface
+
+  Summary:
+    Hardware timer functions used by the software timer service.
+
+  Description:
+    The service needs a 16-bit up-counting timer that resets to zero on a
+    period match and raises an interrupt there (a PIC32 Type B timer). The
+    period is reprogrammed to the next deadline while the timer runs.
+
+  Remarks:
+    The members match the TMRx PLIB functions, so no casts are needed.
+*/
+
+typedef void (*APP_TIME_PLIB_CALLBACK)( uint32_t status, uintptr_t context );
+
+typedef void (*APP_TIME_PLIB_CALLBACK_REGISTER)( APP_TIME_PLIB_CALLBACK callback, uintptr_t context );
+
+typedef void (*APP_TIME_PLIB_START)( void );
+
+typedef void (*APP_TIME_PLIB_STOP)( void );
+
+typedef uint32_t (*APP_TIME_PLIB_FREQUENCY_GET)( void );
+
+typedef void (*APP_TIME_PLIB_PERIOD_SET)( uint16_t period );
+
+typedef uint16_t (*APP_TIME_PLIB_COUNTER_GET)( void );
+
+typedef struct
+{
+    APP_TIME_PLIB_CALLBACK_REGISTER timerCallbackSet;
+
+    APP_TIME_PLIB_START timerStart;
+
+    APP_TIME_PLIB_STOP timerStop;
+
+    APP_TIME_PLIB_FREQUENCY_GET timerFrequencyGet;
+
+    APP_TIME_PLIB_PERIOD_SET timerPeriodSet;
+
+    APP_TIME_PLIB_COUNTER_GET timerCounterGet;
+
+} APP_TIME_PLIB_INTERFACE;
+
+// *****************************************************************************
+/* Software Timer Service Initialization Data
+
+  Summary:
+    Defines the data required to initialize the software timer service.
+
+  Description:
+    timePlib is the hardware timer interface and hwTimerIntNum its interrupt
+    source, which the service polls for a pending period match while it
+    reprograms the period.
+
+  Remarks:
+    None.
+*/
+
+typedef struct
+{
+    const APP_TIME_PLIB_INTERFACE * timePlib;
+
+    INT_SOURCE hwTimerIntNum;
+
+} APP_TIME_INIT;
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+
+    }
+
+#endif
+//DOM-IGNORE-END
+
+#endif //APP_TIME_DEFINITIONS_H
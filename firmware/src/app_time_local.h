@@ -0,0 +1,149 @@
+/*******************************************************************************
+  Software Timer Service Local Data Structures
+
+  File Name:
+    app_time_local.h
+
+  Summary:
+    Software timer service local declarations and definitions.
+
+  Description:
+    This file contains the timer and counter objects of the time system
+    service. It is only included by app_time.c.
+*******************************************************************************/
+
+#ifndef APP_TIME_LOCAL_H
+#define APP_TIME_LOCAL_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "configuration.h"
+#include "app_time.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* A handle is the timer index in the low 16 bits and the token the timer
+   was given when it was created in the high 16 bits */
+#define _APP_TIME_HANDLE_TOKEN_MAX          0xFFFFU
+#define _APP_TIME_HANDLE_MAKE(token, index) ((APP_TIME_HANDLE)(((uint32_t)(token) << 16) | (index)))
+#define _APP_TIME_HANDLE_INDEX(handle)      ((uint32_t)(handle) & 0xFFFFU)
+#define _APP_TIME_HANDLE_TOKEN(handle)      ((uint16_t)((uint32_t)(handle) >> 16))
+
+/* Longest timer period, so that deadlines compare correctly across a wrap of
+   the 32-bit time base */
+#define _APP_TIME_PERIOD_MAX                0x7FFFFFFFU
+
+// *****************************************************************************
+/* Software Timer Object
+
+  Summary:
+    One software timer.
+
+  Description:
+    "expiry" is an absolute time in counts of the service time base and is
+    only meaningful while the timer is in the active list. Times are compared
+    by their signed difference, so the base may wrap.
+*/
+
+typedef struct _APP_TIME_TIMER_OBJ
+{
+    bool inUse;
+
+    /* In the active list */
+    bool active;
+
+    /* Destroyed after a APP_TIME_SINGLE expiry */
+    bool autoDelete;
+
+    APP_TIME_CALLBACK_TYPE type;
+
+    uint16_t tmrToken;
+
+    /* Counts to the next expiry when started; period - count until the
+       first start, then period */
+    uint32_t relativeTimePending;
+
+    uint32_t period;
+
+    uint32_t expiry;
+
+    APP_TIME_CALLBACK callback;
+
+    uintptr_t context;
+
+    struct _APP_TIME_TIMER_OBJ * tmrNext;
+
+} APP_TIME_TIMER_OBJ;
+
+// *****************************************************************************
+/* Time Base Object
+
+  Summary:
+    State of the hardware timer and the list of armed timers.
+
+  Description:
+    The time base in counts is swCounterBase, the time of the last period
+    match, plus the hardware counter. hwTimerPeriod is the length of the
+    period in progress (PR + 1). While no timer is armed the hardware timer
+    is stopped and the time base does not advance.
+
+    The cpuCounter fields extend CP0 Count. They are kept apart from the
+    software timers, whose time base is TMR2.
+*/
+
+typedef struct
+{
+    SYS_STATUS status;
+
+    const APP_TIME_PLIB_INTERFACE * timePlib;
+
+    INT_SOURCE hwTimerIntNum;
+
+    uint32_t hwTimerFrequency;
+
+    uint32_t hwTimerPeriod;
+
+    bool hwTimerIsRunning;
+
+    uint32_t swCounterBase;
+
+    uint16_t tmrTokenCount;
+
+    /* Armed timers, nearest expiry first */
+    APP_TIME_TIMER_OBJ * tmrActive;
+
+    /* Wraps of CP0 Count, and the reading they were counted against */
+    uint32_t cpuCounterHigh;
+
+    uint32_t cpuCounterLast;
+
+    /* Next core timer match, half a wrap after the previous one */
+    uint32_t cpuCounterCompare;
+
+} APP_TIME_COUNTER_OBJ;
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+
+    }
+
+#endif
+//DOM-IGNORE-END
+
+#endif //#ifndef APP_TIME_LOCAL_H
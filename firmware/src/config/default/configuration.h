@@ -72,6 +72,32 @@ extern "C" {
 // *****************************************************************************
 // *****************************************************************************
 
+/* Interrupt priority plan. USB is serviced first and runs on the shadow
+   register set (PIC32MX1xx/2xx dedicate the shadow set to priority level 7),
+   so token processing never waits behind the input or console handlers.
+   The priority and context type below are used both for the __ISR()
+   declarations in interrupts.c and for the IPCx values in EVIC_Initialize. */
+#define SYS_INT_USB_1_PRIORITY                      7
+#define SYS_INT_USB_1_CONTEXT                       SRS
+#define SYS_INT_CHANGE_NOTICE_PRIORITY              4
+#define SYS_INT_CHANGE_NOTICE_CONTEXT               SOFT
+#define SYS_INT_TIMER_2_PRIORITY                    3
+#define SYS_INT_TIMER_2_CONTEXT                     SOFT
+#define SYS_INT_TIMER_3_PRIORITY                    2
+#define SYS_INT_TIMER_3_CONTEXT                     SOFT
+#define SYS_INT_UART_1_PRIORITY                     1
+#define SYS_INT_UART_1_CONTEXT                      SOFT
+#define SYS_INT_CORE_TIMER_PRIORITY                 1
+#define SYS_INT_CORE_TIMER_CONTEXT                  SOFT
+
+/* Define SYS_FAST_BOOT to bring up the USB driver and device layer
+   straight after the GPIO and leave UART1, the console and the debug
+   service to SYS_DeferredInitialize, which SYS_Tasks runs after the first
+   USB pass. The application banner waits for that pass, but debug
+   messages from the initialization before it are lost, so it is off by
+   default; the boot feature report shows the difference. */
+/* #define SYS_FAST_BOOT */
+
 
 
 // *****************************************************************************
@@ -79,13 +105,13 @@ extern "C" {
 // Section: System Service Configuration
 // *****************************************************************************
 // *****************************************************************************
-#define SYS_CONSOLE_DEVICE_MAX_INSTANCES   			1
+#define SYS_CONSOLE_DEVICE_MAX_INSTANCES   			2
 #define SYS_CONSOLE_UART_MAX_INSTANCES 	   			1
-#define SYS_CONSOLE_USB_CDC_MAX_INSTANCES 	   		0
 #define SYS_CONSOLE_PRINT_BUFFER_SIZE        		200
 
 
 #define SYS_CONSOLE_INDEX_0                       0
+#define SYS_CONSOLE_INDEX_1                       1
 
 
 
@@ -99,11 +125,15 @@ extern "C" {
 
 
 
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Driver Configuration
 // *****************************************************************************
 // *****************************************************************************
+/* Change notice pins are dispatched by scanning CNSTATx & CNENx with clz
+   instead of testing every configured pin on each interrupt. */
+#define GPIO_CN_DISPATCH_BITSCAN
 
 
 // *****************************************************************************
@@ -111,13 +141,20 @@ extern "C" {
 // Section: Middleware & Other Library Configuration
 // *****************************************************************************
 // *****************************************************************************
-/* Maximum instances of HID function driver */
-#define USB_DEVICE_HID_INSTANCES_NUMBER     1 
+/* Maximum instances of HID function driver: media keys on interface 0, the
+   vendor channel on interface 1 and the boot keyboard on interface 4, each
+   with its own endpoints */
+#define USB_DEVICE_HID_INSTANCES_NUMBER     3 
 
 /* HID Transfer Queue Size for both read and
    write. Applicable to all instances of the
-   function driver */
-#define USB_DEVICE_HID_QUEUE_DEPTH_COMBINED                 2
+   function driver: one send for the media keys, one send and one receive
+   for the vendor channel, one send for the keyboard */
+#define USB_DEVICE_HID_QUEUE_DEPTH_COMBINED                 4
+
+/* Alternate settings per HID interface: the vendor channel has right-sized
+   endpoints in setting 0 and 64-byte endpoints in setting 1 */
+#define USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER            2
 
 /*** USB Driver Configuration ***/
 
@@ -140,7 +177,7 @@ extern "C" {
 #define USB_ALIGN  CACHE_ALIGN
 
 /* Number of Endpoints used */
-#define DRV_USBFS_ENDPOINTS_NUMBER                        3
+#define DRV_USBFS_ENDPOINTS_NUMBER                        6
 
 /* The USB Device Layer will not initialize the USB Driver */
 #define USB_DEVICE_DRIVER_INITIALIZE_EXPLICIT
@@ -154,6 +191,10 @@ extern "C" {
 /* Enable SOF Events */
 #define USB_DEVICE_SOF_EVENT_ENABLE
 
+/* Call the USBFS driver and the HID and CDC function drivers directly
+   instead of through their interface tables */
+#define USB_DEVICE_STATIC_BINDING
+
 
 
 
@@ -165,6 +206,119 @@ extern "C" {
 // Section: Application Configuration
 // *****************************************************************************
 // *****************************************************************************
+/* Indicator LED level (0 - APP_LED_LEVELS - 1) in each controller mode */
+#define APP_LED_LEVEL_YOUTUBE                       7
+#define APP_LED_LEVEL_MEDIA                         1
+
+/* Encoder volume. Relative sends the volume increment and decrement usages,
+   one report per detent. Absolute keeps a level (0 - APP_VOLUME_MAX) per
+   mode on the device and reports it with report ID 5: the Consumer Volume
+   control in normal mode, a vendor report in YouTube mode. Vendor output
+   commands 3 and 4 switch between them at run time. */
+#define APP_VOLUME_ABSOLUTE                         false
+#define APP_VOLUME_MAX                              100
+#define APP_VOLUME_STEP                             2
+#define APP_VOLUME_INITIAL                          50
+
+/* Fn + encoder scrubbing in YouTube mode. Off, each detent is the 5 s seek
+   key. On, detents add up to a seek in milliseconds that is sent as vendor
+   report 6. A detent seeks APP_SEEK_DETENT_MS when turned more than
+   APP_SEEK_SLOW_DETENT_US after the last one and proportionally further
+   when faster, up to APP_SEEK_GAIN_MAX times. Vendor output commands 5 and
+   6 switch scrubbing on and off at run time. */
+#define APP_SEEK_SCRUB                              false
+#define APP_SEEK_DETENT_MS                          5000
+#define APP_SEEK_SLOW_DETENT_US                     100000
+#define APP_SEEK_GAIN_MAX                           12
+
+/* Extension heartbeat. Every vendor output report, usually command 7 sent
+   about once a second, keeps the vendor channel alive for
+   APP_HEARTBEAT_TIMEOUT_MS. While it is not alive, YouTube mode sends what
+   would go to the extension as media keys instead. Required, the channel
+   is closed until the first heartbeat; false counts it as alive until then,
+   for an extension that never sends one. */
+#define APP_HEARTBEAT_TIMEOUT_MS                    3000
+#define APP_HEARTBEAT_REQUIRED                      true
+
+/* Input reports built and armed in the SOF event, right after the encoder
+   is read, instead of whenever the task loop finds the endpoint free. A
+   report then carries the input of its own frame. Vendor output commands
+   9 and 10 switch at run time. */
+#define APP_REPORT_AT_SOF                           false
+
+/* Report rate limits (appRateLimits in app.c): at most one report per
+   the given number of 1 ms frames, with bursts of the given size. What is
+   held back is merged into the next report, not dropped. 0 frames turns
+   a limit off. A key carries one detent, so detents sent as keys are
+   counted and paced out: a spin of 40 sends 3 at once and the other 37
+   over the next 925 ms. Once absolute volume or scrubbing takes the
+   detents, the count catches up in one level or seek report. */
+#define APP_RATE_ENCODER_KEY_FRAMES                 25
+#define APP_RATE_ENCODER_KEY_BURST                  3
+#define APP_RATE_VOLUME_LEVEL_FRAMES                10
+#define APP_RATE_VOLUME_LEVEL_BURST                 2
+#define APP_RATE_SEEK_FRAMES                        20
+#define APP_RATE_SEEK_BURST                         2
+
+/* Key events kept while the device is not configured, for example during
+   a bus reset, and sent in order once it is configured again. Events
+   beyond this are counted as lost in feature report 8. */
+#define APP_EVENT_QUEUE_SIZE                        8
+
+/* Crash capture (app_crash.h): trace entries kept in persistent RAM with
+   the last crash, reported in feature report 9 */
+#define APP_CRASH_TRACE_SIZE                        16
+
+/* Watchdog in window mode. The WDTPS and FWDTWINSZ configuration bits in
+   initialization.c set a 256 ms period whose last half is the window, so
+   the main loop clears it between 128 and 256 ms after the last clear. The
+   LPRC clock it runs from is not precise, so the service interval sits in
+   the middle of the window. Off, a hang needs a replug; turn it off to stop
+   at breakpoints. */
+#define APP_WATCHDOG_ENABLE                         true
+#define APP_WATCHDOG_SERVICE_MS                     192
+
+/* Gesture windows of appGestureActions in app.c, see app_gesture.h */
+#define APP_GESTURE_CHORD_MS                        50
+#define APP_GESTURE_DOUBLE_TAP_MS                   250
+#define APP_GESTURE_LONG_PRESS_MS                   500
+
+/* Hold-to-repeat of next and previous: first repeat after the delay, then
+   each interval is the given percent of the previous one down to the
+   minimum */
+#define APP_REPEAT_DELAY_MS                         500
+#define APP_REPEAT_INTERVAL_MS                      400
+#define APP_REPEAT_INTERVAL_MIN_MS                  80
+#define APP_REPEAT_ACCELERATION_PERCENT             85
+
+/* CDC-ACM function driver (usb_acm.c) and the console on it (console_acm.c).
+   Both belong to the application rather than to the Harmony configuration.
+   The transfer objects are shared by all instances: one read and two
+   writes. */
+#define USB_ACM_INSTANCES_NUMBER                    1
+#define USB_ACM_QUEUE_DEPTH_COMBINED                3
+
+/* Console instance 0, which SYS_CONSOLE_PRINT and the debug service use, is
+   the CDC-ACM port. UART1 stays available as instance 1. Output is held
+   until the host reads it; what does not fit in the write buffer is
+   dropped. Both buffer sizes must be powers of two. */
+#define CONSOLE_ACM_MAX_INSTANCES                   1
+#define CONSOLE_ACM_WRITE_BUFFER_SIZE               512
+#define CONSOLE_ACM_READ_BUFFER_SIZE                64
+
+/* Software timers on TMR2 (app_time.c). Like the CDC-ACM files, the
+   service is application code and not a Harmony component. */
+#define APP_TIME_INDEX_0                            (0)
+#define APP_TIME_MAX_TIMERS                         (5)
+#define APP_TIME_HW_COUNTER_PERIOD                  (0xFFFFU)
+#define APP_TIME_PERIOD_UPDATE_MARGIN               (8U)
+#define APP_TIME_CPU_CLOCK_FREQUENCY                (40000000U)
+
+/* CPU load accounting (app_load.c). The console line is printed every
+   APP_LOAD_CONSOLE_WINDOWS windows, 0 for never. */
+#define APP_LOAD_ENABLE
+#define APP_LOAD_WINDOW_MS                          (1000U)
+#define APP_LOAD_CONSOLE_WINDOWS                    (10U)
 
 
 //DOM-IGNORE-BEGIN
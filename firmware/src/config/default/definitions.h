@@ -51,15 +51,24 @@
 #include "peripheral/uart/plib_uart1.h"
 #include "usb/usb_device_hid.h"
 #include "usb/usb_hid.h"
+#include "usb_acm.h"
+#include "usb_acm_class.h"
 #include "peripheral/clk/plib_clk.h"
+#include "peripheral/coretimer/plib_coretimer.h"
 #include "peripheral/gpio/plib_gpio.h"
+#include "peripheral/tmr/plib_tmr2.h"
+#include "peripheral/tmr/plib_tmr3.h"
+#include "peripheral/ocmp/plib_ocmp3.h"
 #include "peripheral/evic/plib_evic.h"
 #include "driver/usb/usbfs/drv_usbfs.h"
 #include "usb/usb_chapter_9.h"
 #include "usb/usb_device.h"
 #include "system/console/sys_console.h"
 #include "system/console/src/sys_console_uart_definitions.h"
+#include "console_acm.h"
 #include "system/int/sys_int.h"
+#include "app_time.h"
+#include "app_load.h"
 #include "osal/osal.h"
 #include "system/debug/sys_debug.h"
 #include "app.h"
@@ -164,6 +173,39 @@ Remarks:
 
 void SYS_Tasks ( void );
 
+// *****************************************************************************
+/* System Deferred Initialization Function
+
+Function:
+    void SYS_DeferredInitialize ( void );
+
+Summary:
+    Initializes the modules left out of SYS_Initialize by SYS_FAST_BOOT.
+
+Description:
+    With SYS_FAST_BOOT defined, SYS_Initialize brings up the USB driver and
+    device layer straight after the GPIO so the device can attach as soon as
+    VBUS is seen. UART1, the console and the debug service are initialized by
+    this function instead, which SYS_Tasks calls once after its first pass
+    over the USB tasks.
+
+Precondition:
+    The SYS_Initialize function must have been called and completed.
+
+Parameters:
+    None.
+
+Returns:
+    None.
+
+Remarks:
+    Console output printed before this function runs is dropped.
+*/
+
+#if defined(SYS_FAST_BOOT)
+void SYS_DeferredInitialize ( void );
+#endif
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Type Definitions
@@ -193,8 +235,12 @@ typedef struct
 
     SYS_MODULE_OBJ  sysConsole0;
 
+    SYS_MODULE_OBJ  sysConsole1;
+
     SYS_MODULE_OBJ  sysDebug;
 
+    SYS_MODULE_OBJ  appTime;
+
 
 } SYSTEM_OBJECTS;
 
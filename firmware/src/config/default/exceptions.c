@@ -10,10 +10,11 @@
 
   Description:
     This file redefines the default _weak_  exception handler with a more debug
-    friendly one. If an unexpected exception occurs the code will stop in a
-    while(1) loop.  The debugger can be halted and two variables _excep_code and
-    _except_addr can be examined to determine the cause and address where the
-    exception occurred.
+    friendly one. If an unexpected exception occurs the cause and address are
+    stored in the crash record (app_crash.h) and the device resets, so it
+    enumerates again and the host can read the record. Debug builds stop at a
+    software breakpoint first, where _excep_code and _excep_addr can be
+    examined.
  *******************************************************************************/
 
 // DOM-IGNORE-BEGIN
@@ -49,6 +50,7 @@
 #include "configuration.h"
 #include "device.h"
 #include "definitions.h"
+#include "app_crash.h"
 #include <stdio.h>
 
 
@@ -114,12 +116,14 @@ void __attribute__((noreturn)) _general_exception_handler ( void )
     _excep_code = (_CP0_GET_CAUSE() & 0x0000007C) >> 2;
     _excep_addr = _CP0_GET_EPC();
 
-    while (1)
-    {
-        #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-            __builtin_software_breakpoint();
-        #endif
-    }
+    APP_CRASH_Capture(APP_CRASH_CAUSE_EXCEPTION, _excep_code, _excep_addr, _CP0_GET_BADVADDR());
+
+    #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
+        /* Stop in the debugger first, resuming resets */
+        __builtin_software_breakpoint();
+    #endif
+
+    APP_CRASH_Reset();
 }
 
 /*******************************************************************************
@@ -141,12 +145,14 @@ void __attribute__((noreturn)) _bootstrap_exception_handler(void)
     _excep_code = (_CP0_GET_CAUSE() & 0x0000007C) >> 2;
     _excep_addr = _CP0_GET_EPC();
 
-    while (1)
-    {
-        #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
-            __builtin_software_breakpoint();
-        #endif
-    }
+    APP_CRASH_Capture(APP_CRASH_CAUSE_BOOTSTRAP_EXCEPTION, _excep_code, _excep_addr, _CP0_GET_BADVADDR());
+
+    #if defined(__DEBUG) || defined(__DEBUG_D) && defined(__XC32)
+        /* Stop in the debugger first, resuming resets */
+        __builtin_software_breakpoint();
+    #endif
+
+    APP_CRASH_Reset();
 }
 /*******************************************************************************
  End of File
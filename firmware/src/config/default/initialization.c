@@ -72,9 +72,9 @@
 #pragma config POSCMOD =    XT
 #pragma config OSCIOFNC =   OFF
 #pragma config FCKSM =      CSDCMD
-#pragma config WDTPS =      PS1048576
-#pragma config FWDTEN =     OFF
-#pragma config WINDIS =     OFF
+#pragma config WDTPS =      PS256
+#pragma config FWDTEN =     OFF     /* started by APP_CRASH_Initialize */
+#pragma config WINDIS =     ON
 #pragma config FWDTWINSZ =  WINSZ_50
 
 
@@ -164,10 +164,31 @@ const DRV_USBFS_INIT drvUSBFSInit =
 // <editor-fold defaultstate="collapsed" desc="SYS_CONSOLE Instance 0 Initialization Data">
 
 
+/* Declared in console device implementation (console_acm.c) */
+extern const SYS_CONSOLE_DEV_DESC consoleACMDevDesc;
+
+const CONSOLE_ACM_INIT_DATA sysConsole0ACMInitData =
+{
+    .cdcInstanceIndex = USB_ACM_INDEX_0,
+};
+
+const SYS_CONSOLE_INIT sysConsole0Init =
+{
+    .deviceInitData = (const void*)&sysConsole0ACMInitData,
+    .consDevDesc = &consoleACMDevDesc,
+    .deviceIndex = 0,
+};
+
+
+
+// </editor-fold>
+// <editor-fold defaultstate="collapsed" desc="SYS_CONSOLE Instance 1 Initialization Data">
+
+
 /* Declared in console device implementation (sys_console_uart.c) */
 extern const SYS_CONSOLE_DEV_DESC sysConsoleUARTDevDesc;
 
-const SYS_CONSOLE_UART_PLIB_INTERFACE sysConsole0UARTPlibAPI =
+const SYS_CONSOLE_UART_PLIB_INTERFACE sysConsole1UARTPlibAPI =
 {
     .read = (SYS_CONSOLE_UART_PLIB_READ)UART1_Read,
 	.readCountGet = (SYS_CONSOLE_UART_PLIB_READ_COUNT_GET)UART1_ReadCountGet,
@@ -177,14 +198,14 @@ const SYS_CONSOLE_UART_PLIB_INTERFACE sysConsole0UARTPlibAPI =
 	.writeFreeBufferCountGet = (SYS_CONSOLE_UART_PLIB_WRITE_FREE_BUFFER_COUNT_GET)UART1_WriteFreeBufferCountGet,
 };
 
-const SYS_CONSOLE_UART_INIT_DATA sysConsole0UARTInitData =
+const SYS_CONSOLE_UART_INIT_DATA sysConsole1UARTInitData =
 {
-    .uartPLIB = &sysConsole0UARTPlibAPI,    
+    .uartPLIB = &sysConsole1UARTPlibAPI,    
 };
 
-const SYS_CONSOLE_INIT sysConsole0Init =
+const SYS_CONSOLE_INIT sysConsole1Init =
 {
-    .deviceInitData = (const void*)&sysConsole0UARTInitData,
+    .deviceInitData = (const void*)&sysConsole1UARTInitData,
     .consDevDesc = &sysConsoleUARTDevDesc,
     .deviceIndex = 0,
 };
@@ -194,6 +215,26 @@ const SYS_CONSOLE_INIT sysConsole0Init =
 // </editor-fold>
 
 
+// <editor-fold defaultstate="collapsed" desc="APP_TIME Initialization Data">
+
+const APP_TIME_PLIB_INTERFACE appTimePlibAPI = {
+    .timerCallbackSet = (APP_TIME_PLIB_CALLBACK_REGISTER)TMR2_CallbackRegister,
+    .timerStart = (APP_TIME_PLIB_START)TMR2_Start,
+    .timerStop = (APP_TIME_PLIB_STOP)TMR2_Stop ,
+    .timerFrequencyGet = (APP_TIME_PLIB_FREQUENCY_GET)TMR2_FrequencyGet,
+    .timerPeriodSet = (APP_TIME_PLIB_PERIOD_SET)TMR2_PeriodSet,
+    .timerCounterGet = (APP_TIME_PLIB_COUNTER_GET)TMR2_CounterGet,
+};
+
+const APP_TIME_INIT appTimeInitData =
+{
+    .timePlib = &appTimePlibAPI,
+    .hwTimerIntNum = INT_SOURCE_TIMER_2,
+};
+
+// </editor-fold>
+
+
 const SYS_DEBUG_INIT debugInit =
 {
     .moduleInit = {0},
@@ -211,6 +252,36 @@ const SYS_DEBUG_INIT debugInit =
 // *****************************************************************************
 // *****************************************************************************
 
+static void SYS_ConsoleInitialize ( void )
+{
+	UART1_Initialize();
+
+    sysObj.sysConsole0 = SYS_CONSOLE_Initialize(SYS_CONSOLE_INDEX_0, (SYS_MODULE_INIT *)&sysConsole0Init);
+
+    sysObj.sysConsole1 = SYS_CONSOLE_Initialize(SYS_CONSOLE_INDEX_1, (SYS_MODULE_INIT *)&sysConsole1Init);
+
+    sysObj.sysDebug = SYS_DEBUG_Initialize(SYS_DEBUG_INDEX_0, (SYS_MODULE_INIT*)&debugInit);
+
+    APP_BootPhaseRecord(APP_BOOT_PHASE_CONSOLE);
+}
+
+#if defined(SYS_FAST_BOOT)
+/*******************************************************************************
+  Function:
+    void SYS_DeferredInitialize ( void )
+
+  Summary:
+    Initializes the modules that SYS_FAST_BOOT keeps off the path to attach.
+
+  Remarks:
+    See prototype in definitions.h.
+ */
+
+void SYS_DeferredInitialize ( void )
+{
+    SYS_ConsoleInitialize();
+}
+#endif
 
 
 /*******************************************************************************
@@ -229,9 +300,12 @@ void SYS_Initialize ( void* data )
     /* Start out with interrupts disabled before configuring any modules */
     __builtin_disable_interrupts();
 
+    APP_BootPhaseRecord(APP_BOOT_PHASE_ENTRY);
   
     CLK_Initialize();
 
+    APP_BootPhaseRecord(APP_BOOT_PHASE_CLOCK);
+
     /* Configure KSEG0 as cacheable memory. This is needed for Prefetch Buffer */
     __builtin_mtc0(16, 0,(__builtin_mfc0(16, 0) | 0x3));
 
@@ -243,13 +317,23 @@ void SYS_Initialize ( void* data )
 
 	GPIO_Initialize();
 
-	UART1_Initialize();
+    OCMP3_Initialize();
 
+	TMR3_Initialize();
 
+	TMR2_Initialize();
 
-    sysObj.sysConsole0 = SYS_CONSOLE_Initialize(SYS_CONSOLE_INDEX_0, (SYS_MODULE_INIT *)&sysConsole0Init);
+	CORETIMER_Initialize();
 
-    sysObj.sysDebug = SYS_DEBUG_Initialize(SYS_DEBUG_INDEX_0, (SYS_MODULE_INIT*)&debugInit);
+#if !defined(SYS_FAST_BOOT)
+    SYS_ConsoleInitialize();
+#endif
+
+    sysObj.appTime = APP_TIME_Initialize(APP_TIME_INDEX_0, (SYS_MODULE_INIT *)&appTimeInitData);
+
+#if defined(APP_LOAD_ENABLE)
+    APP_LOAD_Initialize();
+#endif
 
 
 
@@ -260,6 +344,7 @@ void SYS_Initialize ( void* data )
 	 /* Initialize the USB device layer */
     sysObj.usbDevObject0 = USB_DEVICE_Initialize (USB_DEVICE_INDEX_0 , ( SYS_MODULE_INIT* ) & usbDevInitData);
 	
+    APP_BootPhaseRecord(APP_BOOT_PHASE_USB_INIT);
 	
 
 
@@ -271,6 +356,7 @@ void SYS_Initialize ( void* data )
 	/* Enable global interrupts */
     __builtin_enable_interrupts();
 
+    APP_BootPhaseRecord(APP_BOOT_PHASE_INIT_DONE);
 
 }
 
@@ -61,26 +61,49 @@
 // *****************************************************************************
 
 
+/* Builds the IPLnSOFT/IPLnSRS token for __ISR() from the priority plan in
+   configuration.h. The extra level lets the arguments expand first. */
+#define _SYS_INT_IPL(priority, context)     IPL##priority##context
+#define SYS_INT_IPL(priority, context)      _SYS_INT_IPL(priority, context)
+
 void DRV_USBFS_USB_Handler( void );
 void UART_1_InterruptHandler( void );
 void CHANGE_NOTICE_InterruptHandler( void );
+void CORE_TIMER_InterruptHandler( void );
+void TIMER_2_InterruptHandler( void );
+void TIMER_3_InterruptHandler( void );
 
 
 
 /* All the handlers are defined here.  Each will call its PLIB-specific function. */
-void __ISR(_USB_1_VECTOR, ipl1SOFT) USB_1_Handler (void)
+void __ISR(_USB_1_VECTOR, SYS_INT_IPL(SYS_INT_USB_1_PRIORITY, SYS_INT_USB_1_CONTEXT)) USB_1_Handler (void)
+{
+    APP_LOAD_MEASURE(APP_LOAD_USB_1, DRV_USBFS_USB_Handler());
+}
+
+void __ISR(_UART_1_VECTOR, SYS_INT_IPL(SYS_INT_UART_1_PRIORITY, SYS_INT_UART_1_CONTEXT)) UART_1_Handler (void)
+{
+    APP_LOAD_MEASURE(APP_LOAD_UART_1, UART_1_InterruptHandler());
+}
+
+void __ISR(_CHANGE_NOTICE_VECTOR, SYS_INT_IPL(SYS_INT_CHANGE_NOTICE_PRIORITY, SYS_INT_CHANGE_NOTICE_CONTEXT)) CHANGE_NOTICE_Handler (void)
+{
+    APP_LOAD_MEASURE(APP_LOAD_CHANGE_NOTICE, CHANGE_NOTICE_InterruptHandler());
+}
+
+void __ISR(_CORE_TIMER_VECTOR, SYS_INT_IPL(SYS_INT_CORE_TIMER_PRIORITY, SYS_INT_CORE_TIMER_CONTEXT)) CORE_TIMER_Handler (void)
 {
-    DRV_USBFS_USB_Handler();
+    APP_LOAD_MEASURE(APP_LOAD_CORE_TIMER, CORE_TIMER_InterruptHandler());
 }
 
-void __ISR(_UART_1_VECTOR, ipl1SOFT) UART_1_Handler (void)
+void __ISR(_TIMER_2_VECTOR, SYS_INT_IPL(SYS_INT_TIMER_2_PRIORITY, SYS_INT_TIMER_2_CONTEXT)) TIMER_2_Handler (void)
 {
-    UART_1_InterruptHandler();
+    APP_LOAD_MEASURE(APP_LOAD_TIMER_2, TIMER_2_InterruptHandler());
 }
 
-void __ISR(_CHANGE_NOTICE_VECTOR, ipl1SOFT) CHANGE_NOTICE_Handler (void)
+void __ISR(_TIMER_3_VECTOR, SYS_INT_IPL(SYS_INT_TIMER_3_PRIORITY, SYS_INT_TIMER_3_CONTEXT)) TIMER_3_Handler (void)
 {
-    CHANGE_NOTICE_InterruptHandler();
+    APP_LOAD_MEASURE(APP_LOAD_TIMER_3, TIMER_3_InterruptHandler());
 }
 
 
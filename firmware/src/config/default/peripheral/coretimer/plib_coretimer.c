@@ -0,0 +1,107 @@
+/*******************************************************************************
+  Core Timer Peripheral Library Interface Source File
+
+  Company
+    Microchip Technology Inc.
+
+  File Name
+    plib_coretimer.c
+
+  Summary
+    Core timer Source File
+
+  Description
+    This file implements the interface to the CP0 Count/Compare core timer.
+    The interrupt is raised when Count equals Compare.
+
+*******************************************************************************/
+
+// DOM-IGNORE-BEGIN
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+// DOM-IGNORE-END
+
+#include "device.h"
+#include "plib_coretimer.h"
+
+
+static CORETIMER_OBJECT coreTmr;
+
+
+void CORETIMER_Initialize(void)
+{
+    /* Count keeps running from reset, only the interrupt is set up */
+    coreTmr.callback = NULL;
+
+    IFS0CLR = _IFS0_CTIF_MASK;
+}
+
+
+void CORETIMER_CallbackSet( CORETIMER_CALLBACK callback, uintptr_t context )
+{
+    coreTmr.callback = callback;
+    coreTmr.context = context;
+}
+
+
+uint32_t CORETIMER_FrequencyGet(void)
+{
+    return (CORE_TIMER_FREQUENCY);
+}
+
+
+uint32_t CORETIMER_CounterGet(void)
+{
+    return _CP0_GET_COUNT();
+}
+
+
+void CORETIMER_CompareSet(uint32_t compare)
+{
+    /* Writing Compare also clears the pending core timer request */
+    _CP0_SET_COMPARE(compare);
+}
+
+
+void CORETIMER_InterruptEnable(void)
+{
+    IEC0SET = _IEC0_CTIE_MASK;
+}
+
+
+void CORETIMER_InterruptDisable(void)
+{
+    IEC0CLR = _IEC0_CTIE_MASK;
+}
+
+
+void CORE_TIMER_InterruptHandler (void)
+{
+    uint32_t status = IFS0bits.CTIF;
+    IFS0CLR = _IFS0_CTIF_MASK;
+
+    if(coreTmr.callback != NULL)
+    {
+        coreTmr.callback(status, coreTmr.context);
+    }
+}
@@ -0,0 +1,108 @@
+/*******************************************************************************
+  Core Timer Peripheral Library Interface Header File
+
+  Company:
+    Microchip Technology Inc.
+
+  File Name:
+    plib_coretimer.h
+
+  Summary:
+    Core Timer PLIB Header File
+
+  Description:
+    This file defines the interface to the CP0 Count/Compare core timer. The
+    Count register runs free from reset and is never stopped or cleared here,
+    since the boot timestamps and the software timer service read it.
+
+  Remarks:
+    None.
+
+*******************************************************************************/
+
+/*******************************************************************************
+* Copyright (C) 2019 Microchip Technology Inc. and its subsidiaries.
+*
+* Subject to your compliance with these terms, you may use Microchip software
+* and any derivatives exclusively with Microchip products. It is your
+* responsibility to comply with third party license terms applicable to your
+* use of third party software (including open source software) that may
+* accompany Microchip software.
+*
+* THIS SOFTWARE IS SUPPLIED BY MICROCHIP "AS IS". NO WARRANTIES, WHETHER
+* EXPRESS, IMPLIED OR STATUTORY, APPLY TO THIS SOFTWARE, INCLUDING ANY IMPLIED
+* WARRANTIES OF NON-INFRINGEMENT, MERCHANTABILITY, AND FITNESS FOR A
+* PARTICULAR PURPOSE.
+*
+* IN NO EVENT WILL MICROCHIP BE LIABLE FOR ANY INDIRECT, SPECIAL, PUNITIVE,
+* INCIDENTAL OR CONSEQUENTIAL LOSS, DAMAGE, COST OR EXPENSE OF ANY KIND
+* WHATSOEVER RELATED TO THE SOFTWARE, HOWEVER CAUSED, EVEN IF MICROCHIP HAS
+* BEEN ADVISED OF THE POSSIBILITY OR THE DAMAGES ARE FORESEEABLE. TO THE
+* FULLEST EXTENT ALLOWED BY LAW, MICROCHIP'S TOTAL LIABILITY ON ALL CLAIMS IN
+* ANY WAY RELATED TO THIS SOFTWARE WILL NOT EXCEED THE AMOUNT OF FEES, IF ANY,
+* THAT YOU HAVE PAID DIRECTLY TO MICROCHIP FOR THIS SOFTWARE.
+*******************************************************************************/
+
+#ifndef PLIB_CORETIMER_H
+#define PLIB_CORETIMER_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "device.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+/* Count runs at SYSCLK / 2 */
+#define CORE_TIMER_FREQUENCY    20000000U
+
+typedef void (*CORETIMER_CALLBACK)(uint32_t status, uintptr_t context);
+
+typedef struct
+{
+    CORETIMER_CALLBACK  callback;
+    uintptr_t           context;
+
+} CORETIMER_OBJECT;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Interface Routines
+// *****************************************************************************
+// *****************************************************************************
+
+void CORETIMER_Initialize(void);
+
+void CORETIMER_CallbackSet( CORETIMER_CALLBACK callback, uintptr_t context );
+
+uint32_t CORETIMER_FrequencyGet(void);
+
+uint32_t CORETIMER_CounterGet(void);
+
+void CORETIMER_CompareSet(uint32_t compare);
+
+void CORETIMER_InterruptEnable(void);
+
+void CORETIMER_InterruptDisable(void);
+
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif /* PLIB_CORETIMER_H */
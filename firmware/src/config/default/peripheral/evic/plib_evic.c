@@ -41,6 +41,7 @@
 // DOM-IGNORE-END
 
 #include "device.h"
+#include "configuration.h"
 #include "plib_evic.h"
 
 
@@ -55,9 +56,12 @@ void EVIC_Initialize( void )
     INTCONSET = _INTCON_MVEC_MASK;
 
     /* Set up priority and subpriority of enabled interrupts */
-    IPC7SET = 0x40000 | 0x0;  /* USB_1:  Priority 1 / Subpriority 0 */
-    IPC8SET = 0x4 | 0x0;  /* UART_1:  Priority 1 / Subpriority 0 */
-    IPC8SET = 0x40000 | 0x0;  /* CHANGE_NOTICE:  Priority 1 / Subpriority 0 */
+    IPC0SET = (SYS_INT_CORE_TIMER_PRIORITY << 2) | 0x0;  /* CORE_TIMER:  Subpriority 0 */
+    IPC2SET = (SYS_INT_TIMER_2_PRIORITY << 2) | 0x0;  /* TIMER_2:  Subpriority 0 */
+    IPC3SET = (SYS_INT_TIMER_3_PRIORITY << 2) | 0x0;  /* TIMER_3:  Subpriority 0 */
+    IPC7SET = (SYS_INT_USB_1_PRIORITY << 18) | 0x0;  /* USB_1:  Subpriority 0 */
+    IPC8SET = (SYS_INT_UART_1_PRIORITY << 2) | 0x0;  /* UART_1:  Subpriority 0 */
+    IPC8SET = (SYS_INT_CHANGE_NOTICE_PRIORITY << 18) | 0x0;  /* CHANGE_NOTICE:  Subpriority 0 */
 
 
 }
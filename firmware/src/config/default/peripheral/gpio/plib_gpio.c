@@ -41,6 +41,8 @@
 *******************************************************************************/
 //DOM-IGNORE-END
 
+#include <string.h>
+#include "configuration.h"
 #include "plib_gpio.h"
 
 
@@ -50,6 +52,16 @@ GPIO_PIN_CALLBACK_OBJ portPinCbObj[8];
 /* Array to store number of interrupts in each PORT Channel + previous interrupt count */
 uint8_t portNumCb[2 + 1] = { 0, 2, 8, };
 
+/* Array to store the whole-port callback of each PORT Channel */
+GPIO_PORT_CALLBACK_OBJ portCbObj[2];
+
+#if defined(GPIO_CN_DISPATCH_BITSCAN)
+/* Maps each bit of a PORT Channel to its index in portPinCbObj. Pins without
+   a callback object map to GPIO_PIN_CB_INDEX_NONE. */
+#define GPIO_PIN_CB_INDEX_NONE  0xFF
+static uint8_t portPinCbIndex[2][16];
+#endif
+
 /******************************************************************************
   Function:
     GPIO_Initialize ( void )
@@ -92,6 +104,7 @@ void GPIO_Initialize ( void )
 
     /* PPS Output Remapping */
     RPB15R = 1;
+    RPA4R = 5;
 
     /* Lock back the system after PPS configuration */
     CFGCONbits.IOLOCK = 1;
@@ -119,6 +132,20 @@ void GPIO_Initialize ( void )
     {
         portPinCbObj[i].callback = NULL;
     }
+
+    for(i=0; i<2; i++)
+    {
+        portCbObj[i].callback = NULL;
+    }
+
+#if defined(GPIO_CN_DISPATCH_BITSCAN)
+    memset(portPinCbIndex, GPIO_PIN_CB_INDEX_NONE, sizeof(portPinCbIndex));
+
+    for(i=0; i<8; i++)
+    {
+        portPinCbIndex[portPinCbObj[i].pin >> 4][portPinCbObj[i].pin & 0xF] = i;
+    }
+#endif
 }
 
 // *****************************************************************************
@@ -332,6 +359,36 @@ bool GPIO_PinInterruptCallbackRegister(
     return false;
 }
 
+// *****************************************************************************
+/* Function:
+    bool GPIO_PortInterruptCallbackRegister(
+        GPIO_PORT port,
+        const GPIO_PORT_CALLBACK callback,
+        uintptr_t context
+    );
+
+  Summary:
+    Allows application to register one callback for all pins of a port.
+
+  Remarks:
+    See plib_gpio.h for more details.
+*/
+bool GPIO_PortInterruptCallbackRegister(
+    GPIO_PORT port,
+    const GPIO_PORT_CALLBACK callback,
+    uintptr_t context
+)
+{
+    if (port > GPIO_PORT_B)
+    {
+        return false;
+    }
+
+    portCbObj[port].callback = callback;
+    portCbObj[port].context  = context;
+    return true;
+}
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Local Function Implementation
@@ -339,6 +396,67 @@ bool GPIO_PinInterruptCallbackRegister(
 // *****************************************************************************
 
 
+// *****************************************************************************
+/* Function:
+    static void GPIO_PortEventDispatch(GPIO_PORT port, uint32_t status)
+
+  Summary:
+    Delivers the masked change notice status of a port to the application.
+
+  Description:
+    A registered port callback receives the whole status word in one call.
+    Otherwise the pin callbacks are called once per changed pin. With
+    GPIO_CN_DISPATCH_BITSCAN the changed pins are found with clz, so the
+    cost depends on the number of changed pins only, not on the number of
+    pins configured for the port.
+
+  Remarks:
+	It is an internal function, user should not call it directly.
+*/
+static void GPIO_PortEventDispatch(GPIO_PORT port, uint32_t status)
+{
+    GPIO_PIN_CALLBACK_OBJ *cbObj;
+
+    if (portCbObj[port].callback != NULL)
+    {
+        portCbObj[port].callback (port, status, portCbObj[port].context);
+        return;
+    }
+
+#if defined(GPIO_CN_DISPATCH_BITSCAN)
+    uint32_t bit;
+    uint8_t cbIndex;
+
+    while (status != 0U)
+    {
+        bit = 31U - (uint32_t)__builtin_clz(status);
+        status &= ~(1U << bit);
+
+        cbIndex = portPinCbIndex[port][bit];
+        if (cbIndex != GPIO_PIN_CB_INDEX_NONE)
+        {
+            cbObj = &portPinCbObj[cbIndex];
+            if (cbObj->callback != NULL)
+            {
+                cbObj->callback (cbObj->pin, cbObj->context);
+            }
+        }
+    }
+#else
+    uint8_t i;
+
+    /* Check pending events and call callback if registered */
+    for(i = portNumCb[port]; i < portNumCb[port + 1]; i++)
+    {
+        cbObj = &portPinCbObj[i];
+        if((status & (1 << (cbObj->pin & 0xF))) && (cbObj->callback != NULL))
+        {
+            cbObj->callback (cbObj->pin, cbObj->context);
+        }
+    }
+#endif
+}
+
 // *****************************************************************************
 /* Function:
     void CHANGE_NOTICE_A_InterruptHandler(void)
@@ -351,7 +469,6 @@ bool GPIO_PinInterruptCallbackRegister(
 */
 void CHANGE_NOTICE_A_InterruptHandler(void)
 {
-    uint8_t i;
     uint32_t status;
 
     status  = CNSTATA;
@@ -360,14 +477,7 @@ void CHANGE_NOTICE_A_InterruptHandler(void)
     PORTA;
     IFS1CLR = _IFS1_CNAIF_MASK;
 
-    /* Check pending events and call callback if registered */
-    for(i = 0; i < 2; i++)
-    {
-        if((status & (1 << (portPinCbObj[i].pin & 0xF))) && (portPinCbObj[i].callback != NULL))
-        {
-            portPinCbObj[i].callback (portPinCbObj[i].pin, portPinCbObj[i].context);
-        }
-    }
+    GPIO_PortEventDispatch(GPIO_PORT_A, status);
 }
 
 // *****************************************************************************
@@ -382,7 +492,6 @@ void CHANGE_NOTICE_A_InterruptHandler(void)
 */
 void CHANGE_NOTICE_B_InterruptHandler(void)
 {
-    uint8_t i;
     uint32_t status;
 
     status  = CNSTATB;
@@ -391,14 +500,7 @@ void CHANGE_NOTICE_B_InterruptHandler(void)
     PORTB;
     IFS1CLR = _IFS1_CNBIF_MASK;
 
-    /* Check pending events and call callback if registered */
-    for(i = 2; i < 8; i++)
-    {
-        if((status & (1 << (portPinCbObj[i].pin & 0xF))) && (portPinCbObj[i].callback != NULL))
-        {
-            portPinCbObj[i].callback (portPinCbObj[i].pin, portPinCbObj[i].context);
-        }
-    }
+    GPIO_PortEventDispatch(GPIO_PORT_B, status);
 }
 
 /* Function:
@@ -230,6 +230,8 @@ typedef enum
 
 typedef  void (*GPIO_PIN_CALLBACK) ( GPIO_PIN pin, uintptr_t context);
 
+typedef  void (*GPIO_PORT_CALLBACK) ( GPIO_PORT port, uint32_t status, uintptr_t context);
+
 void GPIO_Initialize(void);
 
 // *****************************************************************************
@@ -277,6 +279,16 @@ typedef struct {
 
 } GPIO_PIN_CALLBACK_OBJ;
 
+typedef struct {
+
+    /* Callback for change notice events on any pin of the port */
+    GPIO_PORT_CALLBACK       callback;
+
+    /* Callback Context */
+    uintptr_t               context;
+
+} GPIO_PORT_CALLBACK_OBJ;
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: GPIO Functions which operates on one pin at a time
@@ -339,6 +351,12 @@ bool GPIO_PinInterruptCallbackRegister(
     uintptr_t context
 );
 
+bool GPIO_PortInterruptCallbackRegister(
+    GPIO_PORT port,
+    const   GPIO_PORT_CALLBACK callBack,
+    uintptr_t context
+);
+
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
 
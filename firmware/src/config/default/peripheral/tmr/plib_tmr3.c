@@ -53,6 +53,8 @@
 #include "plib_tmr3.h"
 
 
+static TMR_TIMER_OBJECT tmr3Obj;
+
 
 
 void TMR3_Initialize(void)
@@ -74,6 +76,8 @@ void TMR3_Initialize(void)
     /*Set period */
     PR3 = 6249U;
 
+    /* Enable TMR Interrupt */
+    IEC0SET = _IEC0_T3IE_MASK;
 
 }
 
@@ -111,3 +115,36 @@ uint32_t TMR3_FrequencyGet(void)
 }
 
 
+void TIMER_3_InterruptHandler (void)
+{
+    uint32_t status  = 0U;
+    status = IFS0bits.T3IF;
+    IFS0CLR = _IFS0_T3IF_MASK;
+
+    if((tmr3Obj.callback_fn != NULL))
+    {
+        tmr3Obj.callback_fn(status, tmr3Obj.context);
+    }
+}
+
+
+void TMR3_InterruptEnable(void)
+{
+    IEC0SET = _IEC0_T3IE_MASK;
+}
+
+
+void TMR3_InterruptDisable(void)
+{
+    IEC0CLR = _IEC0_T3IE_MASK;
+}
+
+
+void TMR3_CallbackRegister( TMR_CALLBACK callback_fn, uintptr_t context )
+{
+    /* Save callback_fn and context in local memory */
+    tmr3Obj.callback_fn = callback_fn;
+    tmr3Obj.context = context;
+}
+
+
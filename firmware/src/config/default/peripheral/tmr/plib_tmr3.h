@@ -85,6 +85,12 @@ uint16_t TMR3_CounterGet(void);
 
 uint32_t TMR3_FrequencyGet(void);
 
+void TMR3_InterruptEnable(void);
+
+void TMR3_InterruptDisable(void);
+
+void TMR3_CallbackRegister( TMR_CALLBACK callback_fn, uintptr_t context );
+
 
 // DOM-IGNORE-BEGIN
 #ifdef __cplusplus  // Provide C++ Compatibility
@@ -54,6 +54,11 @@
 #include "definitions.h"
 
 
+#if defined(SYS_FAST_BOOT)
+static bool isDeferredInitializeDone = false;
+#endif
+
+
 
 
 // *****************************************************************************
@@ -72,7 +77,9 @@
 void SYS_Tasks ( void )
 {
     /* Maintain system services */
-    
+    /* Moves data between the CDC console and its buffers; does nothing
+       until SYS_ConsoleInitialize has run */
+    SYS_CONSOLE_Tasks(sysObj.sysConsole0);
 
 
     /* Maintain Device Drivers */
@@ -80,16 +87,25 @@ void SYS_Tasks ( void )
 
     /* Maintain Middleware & Other Libraries */
         /* USB FS Driver Task Routine */ 
-    DRV_USBFS_Tasks(sysObj.drvUSBFSObject);
+    APP_LOAD_MEASURE(APP_LOAD_DRV_USBFS_TASKS, DRV_USBFS_Tasks(sysObj.drvUSBFSObject));
 
 	/* USB Device layer tasks routine */ 
-    USB_DEVICE_Tasks(sysObj.usbDevObject0);
+    APP_LOAD_MEASURE(APP_LOAD_USB_DEVICE_TASKS, USB_DEVICE_Tasks(sysObj.usbDevObject0));
+
+#if defined(SYS_FAST_BOOT)
+    /* Console and debug come up once USB has had its first pass */
+    if (!isDeferredInitializeDone)
+    {
+        SYS_DeferredInitialize();
+        isDeferredInitializeDone = true;
+    }
+#endif
 
 
 
     /* Maintain the application's state machine. */
         /* Call Application task APP. */
-    APP_Tasks();
+    APP_LOAD_MEASURE(APP_LOAD_APP_TASKS, APP_Tasks());
 
 
 
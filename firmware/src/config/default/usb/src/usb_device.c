@@ -54,6 +54,16 @@
 #include "usb/src/usb_device_local.h"
 #include "driver/usb/drv_usb.h"
 
+#if defined(USB_DEVICE_STATIC_BINDING)
+#include "driver/usb/usbfs/drv_usbfs.h"
+#include "usb/usb_device_hid.h"
+#include "usb/src/usb_device_hid_local.h"
+#if defined(USB_ACM_INSTANCES_NUMBER)
+#include "usb_acm.h"
+#include "usb_acm_local.h"
+#endif
+#endif
+
 /**********************************
  * Device layer instance objects.
  *********************************/
@@ -251,7 +261,7 @@ void USB_DEVICE_Attach( USB_DEVICE_HANDLE usbDeviceHandle )
     else
     {
         /* Attach to Host */
-        usbClientHandle->driverInterface->deviceAttach(usbClientHandle->usbCDHandle); 
+        _USB_DEVICE_DriverInterface(usbClientHandle, deviceAttach)(usbClientHandle->usbCDHandle); 
     
         /* Update the USB Device state */
         usbClientHandle->usbDeviceStatusStruct.usbDeviceState = USB_DEVICE_STATE_POWERED;
@@ -292,7 +302,7 @@ void USB_DEVICE_Detach( USB_DEVICE_HANDLE usbDeviceHandle )
     else
     {
         /* Detach from the Host */
-        usbClientHandle->driverInterface->deviceDetach(usbClientHandle->usbCDHandle); 
+        _USB_DEVICE_DriverInterface(usbClientHandle, deviceDetach)(usbClientHandle->usbCDHandle); 
     
         /* Clear the suspended state */
         usbClientHandle->usbDeviceStatusStruct.isSuspended = false;
@@ -359,7 +369,7 @@ USB_DEVICE_RESULT USB_DEVICE_EndpointEnable
     else
     {
         /* Enable the endpoint */
-        result = (USB_DEVICE_RESULT)usbClientHandle->driverInterface->deviceEndpointEnable(usbClientHandle->usbCDHandle, endpoint, transferType, size);
+        result = (USB_DEVICE_RESULT)_USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointEnable)(usbClientHandle->usbCDHandle, endpoint, transferType, size);
     }
     
     return result; 
@@ -412,7 +422,7 @@ USB_DEVICE_RESULT USB_DEVICE_EndpointDisable
     else
     {
         /* Disable the Endpoint */
-        result = (USB_DEVICE_RESULT)usbClientHandle->driverInterface->deviceEndpointDisable(usbClientHandle->usbCDHandle, endpoint);
+        result = (USB_DEVICE_RESULT)_USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointDisable)(usbClientHandle->usbCDHandle, endpoint);
     }
     
     return result; 
@@ -459,7 +469,7 @@ bool USB_DEVICE_EndpointIsEnabled
     else
     {
         /* Check if the endpoint is enabled */
-        result = usbClientHandle->driverInterface->deviceEndpointIsEnabled(usbClientHandle->usbCDHandle, endpoint); 
+        result = _USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointIsEnabled)(usbClientHandle->usbCDHandle, endpoint); 
     }
     
     return result; 
@@ -502,7 +512,7 @@ void USB_DEVICE_EndpointStall
     else
     {
         /* Stall the endpoint */
-        usbClientHandle->driverInterface->deviceEndpointStall(usbClientHandle->usbCDHandle, endpoint); 
+        _USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointStall)(usbClientHandle->usbCDHandle, endpoint); 
     }
 }
 
@@ -543,7 +553,7 @@ void USB_DEVICE_EndpointStallClear
     else
     { 
         /* Clear endpoint stall condition */
-        usbClientHandle->driverInterface->deviceEndpointStallClear(usbClientHandle->usbCDHandle, endpoint); 
+        _USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointStallClear)(usbClientHandle->usbCDHandle, endpoint); 
     }
 }
 
@@ -588,7 +598,7 @@ bool USB_DEVICE_EndpointIsStalled
     else
     {
         /* Check if the endpoint is stalled */
-        result = usbClientHandle->driverInterface->deviceEndpointIsStalled(usbClientHandle->usbCDHandle, endpoint); 
+        result = _USB_DEVICE_DriverInterface(usbClientHandle, deviceEndpointIsStalled)(usbClientHandle->usbCDHandle, endpoint); 
     }
     
     return result; 
@@ -786,7 +796,7 @@ void USB_DEVICE_Tasks( SYS_MODULE_OBJ devLayerObj )
 
             /* Try to open the driver handle. This could fail if the driver is
              * not ready to be opened. */
-            usbDeviceThisInstance->usbCDHandle = usbDeviceThisInstance->driverInterface->open( usbDeviceThisInstance->driverIndex, (DRV_IO_INTENT)(DRV_IO_INTENT_EXCLUSIVE|DRV_IO_INTENT_NONBLOCKING|DRV_IO_INTENT_READWRITE));
+            usbDeviceThisInstance->usbCDHandle = _USB_DEVICE_DriverInterface(usbDeviceThisInstance, open)( usbDeviceThisInstance->driverIndex, (DRV_IO_INTENT)(DRV_IO_INTENT_EXCLUSIVE|DRV_IO_INTENT_NONBLOCKING|DRV_IO_INTENT_READWRITE));
 
             /* Check if the driver was opened */
             if(usbDeviceThisInstance->usbCDHandle != DRV_HANDLE_INVALID)
@@ -827,10 +837,7 @@ void USB_DEVICE_Tasks( SYS_MODULE_OBJ devLayerObj )
 
                         if (driver != NULL)
                         {
-                            if(driver->tasks != NULL)
-                            {
-                                driver->tasks( funcRegTable->funcDriverIndex );
-                            }
+                            _USB_DEVICE_FunctionTasks(driver, funcRegTable->funcDriverIndex);
                         }
                     }
                 }
@@ -1029,7 +1036,7 @@ void USB_DEVICE_EventHandlerSet
     devClientHandle->context = context;
 
     /* Register a callback with the driver. */
-    devClientHandle->driverInterface->eventHandlerSet(devClientHandle->usbCDHandle, (uintptr_t)devClientHandle, &_USB_DEVICE_EventHandler);
+    _USB_DEVICE_DriverInterface(devClientHandle, eventHandlerSet)(devClientHandle->usbCDHandle, (uintptr_t)devClientHandle, &_USB_DEVICE_EventHandler);
 }   
 
 // ******************************************************************************
@@ -1170,7 +1177,7 @@ USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlSend
     }
 
     /* Submit the IRP to the USBCD */
-    (void)usbDeviceThisInstance->driverInterface->deviceIRPSubmit( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, irpHandle);
+    (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPSubmit)( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, irpHandle);
 
     return USB_DEVICE_CONTROL_TRANSFER_RESULT_SUCCESS;
 }
@@ -1267,7 +1274,7 @@ USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlStatus
     {
         /* This means the control transfer should be stalled. We stall endpoint
          * 0 */
-        usbDeviceThisInstance->driverInterface->deviceEndpointStall(usbDeviceThisInstance->usbCDHandle , controlEndpointTx);        
+        _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointStall)(usbDeviceThisInstance->usbCDHandle , controlEndpointTx);        
     }
     else
     {
@@ -1277,7 +1284,7 @@ USB_DEVICE_CONTROL_TRANSFER_RESULT USB_DEVICE_ControlStatus
         irpHandle->data = NULL;
         irpHandle->size = 0;
 
-        (void)usbDeviceThisInstance->driverInterface->deviceIRPSubmit( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, irpHandle);
+        (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPSubmit)( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, irpHandle);
     }
 
     return USB_DEVICE_CONTROL_TRANSFER_RESULT_SUCCESS;
@@ -1388,7 +1395,7 @@ void USB_DEVICE_RemoteWakeupStop( USB_DEVICE_HANDLE handle )
     }
 
     /* Call the driver remote wake up function here */
-    usbDeviceThisInstance->driverInterface->deviceRemoteWakeupStop(usbDeviceThisInstance->usbCDHandle);
+    _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceRemoteWakeupStop)(usbDeviceThisInstance->usbCDHandle);
 }
 
 // *****************************************************************************
@@ -1423,7 +1430,7 @@ void USB_DEVICE_RemoteWakeupStart( USB_DEVICE_HANDLE usbDeviceHandle )
     }
 
     /* Call the driver remote wake up function here */
-    usbDeviceThisInstance->driverInterface->deviceRemoteWakeupStart(usbDeviceThisInstance->usbCDHandle);
+    _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceRemoteWakeupStart)(usbDeviceThisInstance->usbCDHandle);
 }
 // *****************************************************************************
 // *****************************************************************************
@@ -1481,7 +1488,7 @@ USB_ERROR USB_DEVICE_IRPSubmit
     else
     {
          /* Submit IRP */
-        result = usbClientHandle->driverInterface->deviceIRPSubmit(usbClientHandle->usbCDHandle,endpointAndDirection, irp ); 
+        result = _USB_DEVICE_DriverInterface(usbClientHandle, deviceIRPSubmit)(usbClientHandle->usbCDHandle,endpointAndDirection, irp ); 
     }
     
     return result; 
@@ -1528,7 +1535,7 @@ USB_ERROR USB_DEVICE_IRPCancelAll
     else
     {
         /* Cancel all IRPs pending on the Endpoint */
-        result = usbClientHandle->driverInterface->deviceIRPCancelAll(usbClientHandle->usbCDHandle,endpointAndDirection); 
+        result = _USB_DEVICE_DriverInterface(usbClientHandle, deviceIRPCancelAll)(usbClientHandle->usbCDHandle,endpointAndDirection); 
     }
     
     return result;  
@@ -1584,7 +1591,7 @@ USB_ERROR USB_DEVICE_IRPCancel
     else
     {
         /* Cancel IRP */
-        result = usbClientHandle->driverInterface->deviceIRPCancel(usbClientHandle->usbCDHandle,irp); 
+        result = _USB_DEVICE_DriverInterface(usbClientHandle, deviceIRPCancel)(usbClientHandle->usbCDHandle,irp); 
         
     }
   
@@ -1730,7 +1737,7 @@ void _USB_DEVICE_Ep0ReceiveCompleteCallback( USB_DEVICE_IRP * handle )
     usbDeviceThisInstance->irpEp0Rx.size = USB_DEVICE_EP0_BUFFER_SIZE;
 
     /* Submit IRP to endpoint 0 to receive the next data packet. */
-    (void)usbDeviceThisInstance->driverInterface->deviceIRPSubmit( usbDeviceThisInstance->usbCDHandle, controlEndpointRx , &usbDeviceThisInstance->irpEp0Rx);
+    (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPSubmit)( usbDeviceThisInstance->usbCDHandle, controlEndpointRx , &usbDeviceThisInstance->irpEp0Rx);
 }
 
 // ******************************************************************************
@@ -1768,7 +1775,7 @@ void _USB_DEVICE_Ep0TransmitCompleteCallback(USB_DEVICE_IRP * handle)
      * to set the device address. */ 
     if(usbDeviceThisInstance->usbDeviceStatusStruct.setAddressPending)
     {
-        usbDeviceThisInstance->driverInterface->deviceAddressSet(usbDeviceThisInstance->usbCDHandle, usbDeviceThisInstance->deviceAddress);
+        _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceAddressSet)(usbDeviceThisInstance->usbCDHandle, usbDeviceThisInstance->deviceAddress);
         usbDeviceThisInstance->usbDeviceStatusStruct.setAddressPending = false;
         
         /* Update the USB Device state */
@@ -1782,7 +1789,7 @@ void _USB_DEVICE_Ep0TransmitCompleteCallback(USB_DEVICE_IRP * handle)
     {
         /* Set the flag to false and enter test mode */
         usbDeviceThisInstance->usbDeviceStatusStruct.testModePending = false;
-        usbDeviceThisInstance->driverInterface->deviceTestModeEnter(usbDeviceThisInstance->usbCDHandle, (USB_TEST_MODE_SELECTORS)usbDeviceThisInstance->usbDeviceStatusStruct.testSelector );
+        _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceTestModeEnter)(usbDeviceThisInstance->usbCDHandle, (USB_TEST_MODE_SELECTORS)usbDeviceThisInstance->usbDeviceStatusStruct.testSelector );
     }
 
     if(irpHandle->status == USB_DEVICE_IRP_STATUS_COMPLETED)
@@ -1837,11 +1844,8 @@ void _USB_DEVICE_DeInitializeAllFunctionDrivers
             driver = (USB_DEVICE_FUNCTION_DRIVER *)funcRegTable->driver;
             if (driver != NULL)
             {
-                if(driver->deInitialize != NULL)
-                {
-                    /* Call the function driver deInitialize routine */
-                    driver->deInitialize( funcRegTable->funcDriverIndex );
-                }
+                /* Call the function driver deInitialize routine */
+                _USB_DEVICE_FunctionDeInitialize(driver, funcRegTable->funcDriverIndex);
             }           
         }
 
@@ -1900,25 +1904,25 @@ void _USB_DEVICE_EventHandler
             usbDeviceThisInstance->usbDeviceStatusStruct.isSuspended = false;
 
             /* Cancel any IRP already submitted in the RX direction. */
-            usbDeviceThisInstance->driverInterface->deviceIRPCancelAll( usbDeviceThisInstance->usbCDHandle, controlEndpointRx );
+            _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPCancelAll)( usbDeviceThisInstance->usbCDHandle, controlEndpointRx );
 
             /* Cancel any IRP already submitted in the TX direction. */
-           usbDeviceThisInstance->driverInterface->deviceIRPCancelAll( usbDeviceThisInstance->usbCDHandle, controlEndpointTx );
+           _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPCancelAll)( usbDeviceThisInstance->usbCDHandle, controlEndpointTx );
 
             /* Deinitialize all function drivers.*/
             _USB_DEVICE_DeInitializeAllFunctionDrivers ( usbDeviceThisInstance );
 
             /* Disable all endpoints except for EP0.*/
-            usbDeviceThisInstance->driverInterface->deviceEndpointDisable(usbDeviceThisInstance->usbCDHandle, DRV_USB_DEVICE_ENDPOINT_ALL);
+            _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointDisable)(usbDeviceThisInstance->usbCDHandle, DRV_USB_DEVICE_ENDPOINT_ALL);
 
             /* Enable EP0 endpoint. Note that the driver will ignore the
              * direction because this is endpoint 0. */
-            (void)usbDeviceThisInstance->driverInterface->deviceEndpointEnable( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, USB_TRANSFER_TYPE_CONTROL, USB_DEVICE_EP0_BUFFER_SIZE);
+            (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointEnable)( usbDeviceThisInstance->usbCDHandle, controlEndpointTx, USB_TRANSFER_TYPE_CONTROL, USB_DEVICE_EP0_BUFFER_SIZE);
 
             if(usbDeviceThisInstance->irpEp0Rx.status <= USB_DEVICE_IRP_STATUS_SETUP)
             {
                 /* Submit IRP to endpoint 0 to receive the setup packet */
-                (void)usbDeviceThisInstance->driverInterface->deviceIRPSubmit( usbDeviceThisInstance->usbCDHandle, controlEndpointRx , &usbDeviceThisInstance->irpEp0Rx);
+                (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPSubmit)( usbDeviceThisInstance->usbCDHandle, controlEndpointRx , &usbDeviceThisInstance->irpEp0Rx);
             }
 
             /* Change device state to Default */
@@ -1926,7 +1930,7 @@ void _USB_DEVICE_EventHandler
 
             /* Reset means chirping has already happened. So, we must be knowing
                the speed. Get the speed and save it for future. */
-            usbDeviceThisInstance->usbDeviceStatusStruct.usbSpeed = usbDeviceThisInstance->driverInterface->deviceCurrentSpeedGet(usbDeviceThisInstance->usbCDHandle);
+            usbDeviceThisInstance->usbDeviceStatusStruct.usbSpeed = _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceCurrentSpeedGet)(usbDeviceThisInstance->usbCDHandle);
 
             /* Get the master descriptor table entry.*/
             ptrMasterDescTable = usbDeviceThisInstance->ptrMasterDescTable;
@@ -1976,7 +1980,7 @@ void _USB_DEVICE_EventHandler
             {
                 eventType = (DRV_USB_EVENT)USB_DEVICE_EVENT_SOF;
                 /* Get the frame number */
-                SOFFrameNumber.frameNumber = usbDeviceThisInstance->driverInterface->deviceSOFNumberGet(usbDeviceThisInstance->usbCDHandle);
+                SOFFrameNumber.frameNumber = _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceSOFNumberGet)(usbDeviceThisInstance->usbCDHandle);
                 eventData = &SOFFrameNumber;
             }
 
@@ -2057,7 +2061,7 @@ void  _USB_DEVICE_ControlTransferHandler
         usbDeviceThisInstance->controlTransferDataStageSize = setupPkt->wLength;
 
         /* Cancel any IRP that is in the pipe. */
-        usbDeviceThisInstance->driverInterface->deviceIRPCancelAll( usbDeviceThisInstance->usbCDHandle, controlEndpointTx );
+        _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPCancelAll)( usbDeviceThisInstance->usbCDHandle, controlEndpointTx );
         
         switch (setupPkt->Recipient)
         {
@@ -2297,7 +2301,7 @@ void _USB_DEVICE_ProcessStandardEndpointRequest
         /* This is an Endpoint Get Status request. Send the status to the host.
          * */
         usbDeviceThisInstance->getStatusResponse.status = 0x00;
-        usbDeviceThisInstance->getStatusResponse.endPointHalt =  usbDeviceThisInstance->driverInterface->deviceEndpointIsStalled(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
+        usbDeviceThisInstance->getStatusResponse.endPointHalt =  _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointIsStalled)(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
 
         USB_DEVICE_ControlSend( (USB_DEVICE_HANDLE)usbDeviceThisInstance, (uint8_t *)&usbDeviceThisInstance->getStatusResponse, 2 );
     }
@@ -2307,7 +2311,7 @@ void _USB_DEVICE_ProcessStandardEndpointRequest
         {
             /* This means the host has requested for the stall condition on an
              * endpoint to be cleared. */
-            usbDeviceThisInstance->driverInterface->deviceEndpointStallClear(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
+            _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointStallClear)(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
             USB_DEVICE_ControlStatus((USB_DEVICE_HANDLE)usbDeviceThisInstance, USB_DEVICE_CONTROL_STATUS_OK );
         }
     }
@@ -2318,7 +2322,7 @@ void _USB_DEVICE_ProcessStandardEndpointRequest
             /* This means the host has requested for an endpoint to be stalled
              * */
             usbEndpoint = setupPkt->bEPID;
-            usbDeviceThisInstance->driverInterface->deviceEndpointStall(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
+            _USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceEndpointStall)(usbDeviceThisInstance->usbCDHandle, usbEndpoint );
             USB_DEVICE_ControlStatus((USB_DEVICE_HANDLE)usbDeviceThisInstance, USB_DEVICE_CONTROL_STATUS_OK );
         }
     }
@@ -2621,7 +2625,7 @@ void _USB_DEVICE_ConfigureDevice( USB_DEVICE_OBJ* usbDeviceThisInstance )
                 /* Call the driver intialize by descriptor function. This will
                  * let the function driver know that it should start running and
                  * be initialized. */
-                driver->initializeByDescriptor(pFunctionRegTable->funcDriverIndex, (USB_DEVICE_HANDLE)usbDeviceThisInstance,
+                _USB_DEVICE_FunctionInitializeByDescriptor(driver, pFunctionRegTable->funcDriverIndex, (USB_DEVICE_HANDLE)usbDeviceThisInstance,
                               pFunctionRegTable->funcDriverInit, interfaceNumber, alternateSetting, descriptorType, pDescriptor);
             }
         }
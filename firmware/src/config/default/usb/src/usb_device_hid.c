@@ -182,9 +182,32 @@ void _USB_DEVICE_HID_InitializeByDescriptorType
     USB_ENDPOINT_DESCRIPTOR * epDescriptor = ( USB_ENDPOINT_DESCRIPTOR *)pDescriptor;
     USB_DEVICE_HID_INSTANCE * hidInstance = &gUsbDeviceHidInstance[iHID];
 
-    SYS_ASSERT(altSetting == 0, "USB Device HID: HID supports only one setting \
-            and does not support alternate settings.\
-            Check configuration descriptors ");
+    if(altSetting >= USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER)
+    {
+        SYS_ASSERT(false, "USB Device HID: more alternate settings than \
+                USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER.\
+                Check configuration descriptors ");
+        return;
+    }
+
+    if(altSetting != 0)
+    {
+        /* Only remember the endpoints of the other settings. They are opened
+         * when the host selects the setting. */
+        if((descriptorType == USB_DESCRIPTOR_ENDPOINT) &&
+                (epDescriptor->transferType == USB_TRANSFER_TYPE_INTERRUPT))
+        {
+            if(epDescriptor->dirn == USB_DATA_DIRECTION_DEVICE_TO_HOST)
+            {
+                hidInstance->altEndpointTx[altSetting] = epDescriptor;
+            }
+            else
+            {
+                hidInstance->altEndpointRx[altSetting] = epDescriptor;
+            }
+        }
+        return;
+    }
 
     switch(descriptorType )
     {
@@ -196,6 +219,8 @@ void _USB_DEVICE_HID_InitializeByDescriptorType
             {
                 if(epDescriptor->dirn == USB_DATA_DIRECTION_DEVICE_TO_HOST)
                 {
+                    hidInstance->altEndpointTx[0] = epDescriptor;
+
                     /* Save the Tx endpoint information. */
                     hidInstance->endpointTx = epDescriptor->bEndpointAddress;
                     hidInstance->endpointTxSize =  epDescriptor->wMaxPacketSize;
@@ -213,6 +238,7 @@ void _USB_DEVICE_HID_InitializeByDescriptorType
                 else
                 {
                     /* Direction is OUT */
+                    hidInstance->altEndpointRx[0] = epDescriptor;
                     hidInstance->endpointRx = epDescriptor->bEndpointAddress;
                     hidInstance->endpointRxSize =  epDescriptor->wMaxPacketSize;
 
@@ -239,6 +265,7 @@ void _USB_DEVICE_HID_InitializeByDescriptorType
 
             /* Just mark interface as ready. */
             hidInstance->flags.interfaceReady = 1;
+            hidInstance->alternateSetting = 0;
             hidInstance->devLayerHandle = usbDeviceHandle;
             hidInstance->hidFuncInit = funcDriverInit;
             hidInstance->hidDescriptor = pDescriptor +9 ;
@@ -719,6 +746,93 @@ USB_DEVICE_HID_RESULT USB_DEVICE_HID_ReportReceive
 }
 
 
+// ******************************************************************************
+/* Function:
+    bool _USB_DEVICE_HID_AlternateSettingSelect
+    (
+        SYS_MODULE_INDEX iHID,
+        uint8_t altSetting
+    )
+
+  Summary:
+    Opens the endpoints of an alternate setting.
+
+  Description:
+    Handles SET_INTERFACE. The endpoints of the active setting are closed,
+    which aborts their pending transfers, and reopened with the sizes of the
+    new setting. Returns false, and changes nothing, when the interface has
+    no such setting.
+
+  Remarks:
+    This is a local function and should not be called directly by the
+    application.
+*/
+
+bool _USB_DEVICE_HID_AlternateSettingSelect
+(
+    SYS_MODULE_INDEX iHID,
+    uint8_t altSetting
+)
+{
+    USB_DEVICE_HID_INSTANCE * hidInstance = &gUsbDeviceHidInstance[iHID];
+    USB_ENDPOINT_DESCRIPTOR * epTx;
+    USB_ENDPOINT_DESCRIPTOR * epRx;
+
+    if(altSetting >= USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER)
+    {
+        return false;
+    }
+
+    epTx = hidInstance->altEndpointTx[altSetting];
+    epRx = hidInstance->altEndpointRx[altSetting];
+
+    if((altSetting != 0) && (epTx == NULL) && (epRx == NULL))
+    {
+        /* The interface does not have this setting */
+        return false;
+    }
+
+    if (hidInstance->flags.interruptEpTxReady)
+    {
+        USB_DEVICE_IRPCancelAll( hidInstance->devLayerHandle,
+                                hidInstance->endpointTx );
+        USB_DEVICE_EndpointDisable(  hidInstance->devLayerHandle,
+                                hidInstance->endpointTx);
+        hidInstance->flags.interruptEpTxReady = 0;
+    }
+    if (hidInstance->flags.interruptEpRxReady)
+    {
+        USB_DEVICE_IRPCancelAll( hidInstance->devLayerHandle,
+                                hidInstance->endpointRx );
+        USB_DEVICE_EndpointDisable(  hidInstance->devLayerHandle,
+                                hidInstance->endpointRx);
+        hidInstance->flags.interruptEpRxReady = 0;
+    }
+
+    if(epTx != NULL)
+    {
+        hidInstance->endpointTx = epTx->bEndpointAddress;
+        hidInstance->endpointTxSize = epTx->wMaxPacketSize;
+        USB_DEVICE_EndpointEnable(hidInstance->devLayerHandle, 0,
+                hidInstance->endpointTx, USB_TRANSFER_TYPE_INTERRUPT, epTx->wMaxPacketSize);
+        hidInstance->flags.interruptEpTxReady = 1;
+        hidInstance->currentTxQueueSize = 0;
+    }
+    if(epRx != NULL)
+    {
+        hidInstance->endpointRx = epRx->bEndpointAddress;
+        hidInstance->endpointRxSize = epRx->wMaxPacketSize;
+        USB_DEVICE_EndpointEnable(hidInstance->devLayerHandle, 0,
+                hidInstance->endpointRx, USB_TRANSFER_TYPE_INTERRUPT, epRx->wMaxPacketSize);
+        hidInstance->flags.interruptEpRxReady = 1;
+        hidInstance->currentRxQueueSize = 0;
+    }
+
+    hidInstance->alternateSetting = altSetting;
+
+    return true;
+}
+
 /******************************************************************************
   Function:
     void _USB_DEVICE_HID_ControlTransferHandler
@@ -749,7 +863,6 @@ void _USB_DEVICE_HID_ControlTransferHandler
 {
     size_t length;
     uint8_t reportID;
-    static uint8_t altSetting = 0;
     USB_HID_PROTOCOL_CODE setProtocol;
     USB_DEVICE_HID_INSTANCE * hidThisInstance;
     USB_DEVICE_HID_EVENT_DATA_SET_IDLE setIdle;
@@ -810,13 +923,19 @@ void _USB_DEVICE_HID_ControlTransferHandler
 
                 case USB_REQUEST_SET_INTERFACE:
 
-                     altSetting = setupPkt->W_Value.byte.LB;
-                     USB_DEVICE_ControlStatus( hidThisInstance->devLayerHandle, USB_DEVICE_CONTROL_STATUS_OK);
+                     if(_USB_DEVICE_HID_AlternateSettingSelect(iHID, setupPkt->W_Value.byte.LB))
+                     {
+                         USB_DEVICE_ControlStatus( hidThisInstance->devLayerHandle, USB_DEVICE_CONTROL_STATUS_OK);
+                     }
+                     else
+                     {
+                         USB_DEVICE_ControlStatus( hidThisInstance->devLayerHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+                     }
                      break; 
 
                 case USB_REQUEST_GET_INTERFACE:
 
-                     USB_DEVICE_ControlSend( hidThisInstance->devLayerHandle, &altSetting, 1);
+                     USB_DEVICE_ControlSend( hidThisInstance->devLayerHandle, &hidThisInstance->alternateSetting, 1);
                      break;
 
                 default:
@@ -935,6 +1054,9 @@ void _USB_DEVICE_HID_DeInitialize(SYS_MODULE_INDEX iHID)
                                 hidInstance->endpointRx);
     }
     hidInstance->flags.allFlags = 0;   
+    hidInstance->alternateSetting = 0;
+    memset(hidInstance->altEndpointTx, 0, sizeof(hidInstance->altEndpointTx));
+    memset(hidInstance->altEndpointRx, 0, sizeof(hidInstance->altEndpointRx));
 }
 
 // ******************************************************************************
@@ -987,6 +1109,39 @@ USB_DEVICE_HID_RESULT USB_DEVICE_HID_EventHandlerSet
     return USB_DEVICE_HID_RESULT_OK;    
 }
 
+// ******************************************************************************
+/* Function:
+    size_t USB_DEVICE_HID_ReportReceiveSizeGet
+    (
+        USB_DEVICE_HID_INDEX iHID
+    )
+
+  Summary:
+    Returns the packet size of the OUT endpoint in the active alternate
+    setting.
+
+  Remarks:
+    See usb_device_hid.h for usage information.
+*/
+
+size_t USB_DEVICE_HID_ReportReceiveSizeGet
+(
+    USB_DEVICE_HID_INDEX iHID
+)
+{
+    USB_DEVICE_HID_INSTANCE * thisHIDInstance;
+
+    if(iHID >= USB_DEVICE_HID_INSTANCES_NUMBER)
+    {
+        SYS_ASSERT(false, "HID instance is not valid");
+        return 0;
+    }
+
+    thisHIDInstance = &gUsbDeviceHidInstance[iHID];
+
+    return (thisHIDInstance->flags.interruptEpRxReady) ? thisHIDInstance->endpointRxSize : 0;
+}
+
 /******************************************************************************/
 
 
@@ -49,6 +49,11 @@
 // *****************************************************************************
 #include "osal/osal.h"
 
+/* Alternate settings per HID interface. Setting 0 is opened when the device
+   is configured, any other is opened by SET_INTERFACE. */
+#ifndef USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER
+#define USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER    1
+#endif
 
 // *****************************************************************************
 // *****************************************************************************
@@ -111,6 +116,13 @@ typedef struct
     size_t currentRxQueueSize;
     uint8_t *hidDescriptor;
 
+    /* Active alternate setting, and the endpoints of every setting as the
+       device layer passed them in while configuring. NULL where a setting
+       has no endpoint in that direction. */
+    uint8_t alternateSetting;
+    USB_ENDPOINT_DESCRIPTOR * altEndpointTx[USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER];
+    USB_ENDPOINT_DESCRIPTOR * altEndpointRx[USB_DEVICE_HID_ALTERNATE_SETTINGS_NUMBER];
+
 } USB_DEVICE_HID_INSTANCE;
 
 // *****************************************************************************
@@ -167,6 +179,8 @@ void _USB_DEVICE_HID_ControlTransferHandler
 
 void _USB_DEVICE_HID_DeInitialize(SYS_MODULE_INDEX iHID);
 
+bool _USB_DEVICE_HID_AlternateSettingSelect(SYS_MODULE_INDEX iHID, uint8_t altSetting);
+
 void _USB_DEVICE_HID_GlobalInitialize (void); 
 
 #endif
@@ -174,7 +174,7 @@
     #define _USB_DEVICE_OtherSpeedDescriptorRequestIrpFlagsUpdate(mIrp, mFlags)                                  (mIrp)->flags = mFlags;                                                                                                             
     #define _USB_DEVICE_OtherSpeedDescriptorRequestCopyData(dest,source,size)                                   memcpy(dest,source, size)
     #define _USB_DEVICE_OtherSpeedDescriptorRequestEditDescriptorType(buffer, index, type)                      buffer[index] = type; 
-    #define _USB_DEVICE_OtherSpeedDescriptorRequestIrpSubmit(mCDHandle,mEp,mIrp)        (void)usbDeviceThisInstance->driverInterface->deviceIRPSubmit( mCDHandle, mEp, mIrp);                           
+    #define _USB_DEVICE_OtherSpeedDescriptorRequestIrpSubmit(mCDHandle,mEp,mIrp)        (void)_USB_DEVICE_DriverInterface(usbDeviceThisInstance, deviceIRPSubmit)( mCDHandle, mEp, mIrp);                           
 #else
     #define _USB_DEVICE_DECLARE_IRP(x)
     #define _USB_DEVICE_DECLARE_EP0_BUFFER(x)
@@ -186,6 +186,88 @@
     #define _USB_DEVICE_OtherSpeedDescriptorRequestIrpSubmit(mCDHandle,mEp,mIrp)        
 #endif 
 
+// *****************************************************************************
+// *****************************************************************************
+// Section: Driver and Function Driver Binding
+// *****************************************************************************
+// *****************************************************************************
+
+/* By default the device layer reaches the controller driver through the
+ * DRV_USB_DEVICE_INTERFACE table given in the init data and the function
+ * drivers through their USB_DEVICE_FUNCTION_DRIVER tables. With
+ * USB_DEVICE_STATIC_BINDING, a build with one device layer instance on the
+ * USBFS driver and HID, optionally with CDC, as its function drivers calls
+ * these functions by name, so the calls are direct and can be inlined. With
+ * both drivers present the registration table entry's driver pointer picks
+ * between the two direct calls. */
+
+#if defined(USB_DEVICE_STATIC_BINDING)
+
+    #if (USB_DEVICE_INSTANCES_NUMBER != 1) || !defined(DRV_USBFS_INSTANCES_NUMBER)
+        #error "USB_DEVICE_STATIC_BINDING needs a single device layer instance on the USBFS driver"
+    #endif
+
+    #if !defined(USB_DEVICE_HID_INSTANCES_NUMBER) || \
+        defined(USB_DEVICE_MSD_INSTANCES_NUMBER) || defined(USB_DEVICE_AUDIO_INSTANCES_NUMBER) || \
+        defined(USB_DEVICE_AUDIO_V2_INSTANCES_NUMBER) || defined(USB_DEVICE_VENDOR_ENDPOINT_QUEUE_DEPTH_COMBINED)
+        #error "USB_DEVICE_STATIC_BINDING needs HID, optionally with CDC, as the function drivers"
+    #endif
+
+    #define _USB_DEVICE_DriverInterface(instance, function)     _USB_DEVICE_DRV_USBFS_##function
+
+    #define _USB_DEVICE_DRV_USBFS_open                          DRV_USBFS_Open
+    #define _USB_DEVICE_DRV_USBFS_eventHandlerSet               DRV_USBFS_ClientEventCallBackSet
+    #define _USB_DEVICE_DRV_USBFS_deviceAddressSet              DRV_USBFS_DEVICE_AddressSet
+    #define _USB_DEVICE_DRV_USBFS_deviceCurrentSpeedGet         DRV_USBFS_DEVICE_CurrentSpeedGet
+    #define _USB_DEVICE_DRV_USBFS_deviceSOFNumberGet            DRV_USBFS_DEVICE_SOFNumberGet
+    #define _USB_DEVICE_DRV_USBFS_deviceAttach                  DRV_USBFS_DEVICE_Attach
+    #define _USB_DEVICE_DRV_USBFS_deviceDetach                  DRV_USBFS_DEVICE_Detach
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointEnable          DRV_USBFS_DEVICE_EndpointEnable
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointDisable         DRV_USBFS_DEVICE_EndpointDisable
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointStall           DRV_USBFS_DEVICE_EndpointStall
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointStallClear      DRV_USBFS_DEVICE_EndpointStallClear
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointIsEnabled       DRV_USBFS_DEVICE_EndpointIsEnabled
+    #define _USB_DEVICE_DRV_USBFS_deviceEndpointIsStalled       DRV_USBFS_DEVICE_EndpointIsStalled
+    #define _USB_DEVICE_DRV_USBFS_deviceIRPSubmit               DRV_USBFS_DEVICE_IRPSubmit
+    #define _USB_DEVICE_DRV_USBFS_deviceIRPCancel               DRV_USBFS_DEVICE_IRPCancel
+    #define _USB_DEVICE_DRV_USBFS_deviceIRPCancelAll            DRV_USBFS_DEVICE_IRPCancelAll
+    #define _USB_DEVICE_DRV_USBFS_deviceRemoteWakeupStart       DRV_USBFS_DEVICE_RemoteWakeupStart
+    #define _USB_DEVICE_DRV_USBFS_deviceRemoteWakeupStop        DRV_USBFS_DEVICE_RemoteWakeupStop
+
+    /* Test modes are high speed only; USBFS has no entry for them */
+    #define _USB_DEVICE_DRV_USBFS_deviceTestModeEnter(handle, testMode)
+
+    /* Neither the HID nor the CDC function driver has a tasks routine */
+    #define _USB_DEVICE_FunctionTasks(driver, index)
+
+    #if defined(USB_ACM_INSTANCES_NUMBER)
+
+    #define _USB_DEVICE_FunctionDeInitialize(driver, index) \
+                if((driver) == USB_ACM_FUNCTION_DRIVER) { _USB_ACM_DeInitialize(index); } \
+                else { _USB_DEVICE_HID_DeInitialize(index); }
+    #define _USB_DEVICE_FunctionInitializeByDescriptor(driver, index, handle, init, interface, alternate, type, descriptor) \
+                if((driver) == USB_ACM_FUNCTION_DRIVER) { _USB_ACM_InitializeByDescriptorType(index, handle, init, interface, alternate, type, descriptor); } \
+                else { _USB_DEVICE_HID_InitializeByDescriptorType(index, handle, init, interface, alternate, type, descriptor); }
+
+    #else
+
+    #define _USB_DEVICE_FunctionDeInitialize(driver, index)     _USB_DEVICE_HID_DeInitialize(index)
+    #define _USB_DEVICE_FunctionInitializeByDescriptor(driver, index, handle, init, interface, alternate, type, descriptor) \
+                _USB_DEVICE_HID_InitializeByDescriptorType(index, handle, init, interface, alternate, type, descriptor)
+
+    #endif
+
+#else
+
+    #define _USB_DEVICE_DriverInterface(instance, function)     (instance)->driverInterface->function
+
+    #define _USB_DEVICE_FunctionTasks(driver, index)            if((driver)->tasks != NULL) { (driver)->tasks(index); }
+    #define _USB_DEVICE_FunctionDeInitialize(driver, index)     if((driver)->deInitialize != NULL) { (driver)->deInitialize(index); }
+    #define _USB_DEVICE_FunctionInitializeByDescriptor(driver, index, handle, init, interface, alternate, type, descriptor) \
+                (driver)->initializeByDescriptor(index, handle, init, interface, alternate, type, descriptor)
+
+#endif
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: USB Device Descriptor Macros. 
@@ -1170,6 +1170,43 @@ USB_DEVICE_HID_RESULT USB_DEVICE_HID_TransferCancel
     USB_DEVICE_HID_TRANSFER_HANDLE transferHandle
 );
 
+// *****************************************************************************
+/* Function:
+    size_t USB_DEVICE_HID_ReportReceiveSizeGet
+    (
+        USB_DEVICE_HID_INDEX instanceIndex
+    );
+
+  Summary:
+    Returns the packet size of the OUT endpoint in the active alternate
+    setting.
+
+  Description:
+    A report receive completes when its buffer is full or a short packet
+    arrives. An output report that fills a whole packet is not short, so
+    passing this size to USB_DEVICE_HID_ReportReceive completes the transfer
+    on every report. The size changes when the host selects another
+    alternate setting, which also aborts the pending receive.
+
+  Precondition:
+    The function driver has been configured.
+
+  Parameters:
+    instanceIndex - Instance of the HID Function Driver.
+
+  Returns:
+    The OUT endpoint size in bytes, or 0 when the instance has no OUT
+    endpoint or is not configured.
+
+  Remarks:
+    None.
+*/
+
+size_t USB_DEVICE_HID_ReportReceiveSizeGet
+(
+    USB_DEVICE_HID_INDEX instanceIndex
+);
+
 // *****************************************************************************
 // *****************************************************************************
 // Section: Data Types and constants specific to PIC32 implementation of the
@@ -51,28 +51,10 @@
  **************************************************/
 	/****************************************************
  * Class specific descriptor - HID Report descriptor
+ * of interface 0, consumer control
  ****************************************************/
 const uint8_t hid_rpt0[] =
 {  
-    0x06, 0x00, 0xFF,   // Usage Page = 0xFF00 (Vendor Defined Page 1)
-    0x09, 0x01,             // Usage (Vendor Usage 1)
-    0xA1, 0x01,             // Colsslection (Application)
-    0x85, 0x01,                 // Report ID = 1
-    0x19, 0x01,                 // Usage Minimum
-//    0x29, 0x40,                 // Usage Maximum 	// 64 input usages total (0x01 to 0x40)
-    0x29, 0x01,                 // Usage Maximum 	// 64 input usages total (0x01 to 0x40)
-//    0x15, 0x01,               // Logical Minimum (data bytes in the report may have minimum value = 0x00)
-//    0x25, 0x40,               // Logical Maximum (data bytes in the report may have maximum value = 0x00FF = unsigned 255)
-    0x75, 0x08,                 // Report Size: 8-bit field size
-    0x95, 0x01,                 // 8bit (Report Size) * 1
-//    0x95, 0x40,               // Report Count: Make sixty-four 8-bit fields (the next time the parser hits an "Input", "Output", or "Feature" item)
-    0x81, 0x00,                 // Input (Data, Array, Abs): Instantiates input packet fields based on the above report size, count, logical min/max, and usage.
-    
-    0x19, 0x01,                 // Usage Minimum
-    0x29, 0x40,                 // Usage Maximum 	//64 output usages total (0x01 to 0x40)
-    0x91, 0x00,                 // Output (Data, Array, Abs): Instantiates output packet fields.  Uses same report size and count as "Input" fields, since nothing new/different was specified to the parser since the "Input" item.
-    0xC0,
-    
     // Media Key
     0x05, 0x0C, //  Usage Page (Consumer Device)
 	0x09, 0x01, //  Usage (Consumer Control)			
@@ -92,32 +74,174 @@ const uint8_t hid_rpt0[] =
 	0x81, 0x02, // Input (Data, Variable, Absolute)
 	0x95, 0x02, // Report Count (2)
 	0x81, 0x01, // Input (Constant)
+	0x85, 0x05,	//      Report ID = 5 (absolute volume, see APP_VOLUME_ABSOLUTE)
+	0x09, USB_HID_CONSUMER_VOLUME,  // Usage (Volume), linear control
+	0x25, APP_VOLUME_MAX,           // Logical Maximum
+	0x75, 0x08, //		Report Size (8)
+	0x95, 0x01, //		Report Count (1)
+	0x81, 0x02, // Input (Data, Variable, Absolute)
 	0xC0
-            
-            
+};
+
+/****************************************************
+ * Class specific descriptor - HID Report descriptor
+ * of interface 1, vendor channel
+ ****************************************************/
+const uint8_t hid_rpt1[] =
+{  
+    0x06, 0x00, 0xFF,   // Usage Page = 0xFF00 (Vendor Defined Page 1)
+    0x09, 0x01,             // Usage (Vendor Usage 1)
+    0xA1, 0x01,             // Colsslection (Application)
+    0x85, 0x01,                 // Report ID = 1
+    0x19, 0x01,                 // Usage Minimum
+//    0x29, 0x40,                 // Usage Maximum 	// 64 input usages total (0x01 to 0x40)
+    0x29, 0x01,                 // Usage Maximum 	// 64 input usages total (0x01 to 0x40)
+//    0x15, 0x01,               // Logical Minimum (data bytes in the report may have minimum value = 0x00)
+//    0x25, 0x40,               // Logical Maximum (data bytes in the report may have maximum value = 0x00FF = unsigned 255)
+    0x75, 0x08,                 // Report Size: 8-bit field size
+    0x95, 0x01,                 // 8bit (Report Size) * 1
+//    0x95, 0x40,               // Report Count: Make sixty-four 8-bit fields (the next time the parser hits an "Input", "Output", or "Feature" item)
+    0x81, 0x00,                 // Input (Data, Array, Abs): Instantiates input packet fields based on the above report size, count, logical min/max, and usage.
+    
+    0x19, 0x01,                 // Usage Minimum
+    0x29, 0x40,                 // Usage Maximum 	//64 output usages total (0x01 to 0x40)
+    0x91, 0x00,                 // Output (Data, Array, Abs): Instantiates output packet fields.  Uses same report size and count as "Input" fields, since nothing new/different was specified to the parser since the "Input" item.
+    
+    0x85, 0x03,                 // Report ID = 3 (boot timestamps, MEDIA_CONTROLLER_BOOT_REPORT_T)
+    0x09, 0x02,                 // Usage (Vendor Usage 2)
+    0x95, 3 + (4 * APP_BOOT_PHASE_COUNT), // Report Count: bytes after the report ID
+    0xB1, 0x02,                 // Feature (Data, Variable, Abs)
+    
+    0x85, 0x04,                 // Report ID = 4 (CPU load, MEDIA_CONTROLLER_LOAD_REPORT_T)
+    0x09, 0x03,                 // Usage (Vendor Usage 3)
+    0x95, 5 + (6 * APP_LOAD_SLOTS), // Report Count: bytes after the report ID
+    0xB1, 0x02,                 // Feature (Data, Variable, Abs)
+    
+    0x85, 0x05,                 // Report ID = 5 (YouTube volume level, see APP_VOLUME_ABSOLUTE)
+    0x09, 0x04,                 // Usage (Vendor Usage 4)
+    0x15, 0x00,                 // Logical Minimum (0)
+    0x25, APP_VOLUME_MAX,       // Logical Maximum
+    0x95, 0x01,                 // Report Count: one level byte
+    0x81, 0x02,                 // Input (Data, Variable, Abs): the device's level
+    0x09, 0x04,                 // Usage (Vendor Usage 4)
+    0x91, 0x02,                 // Output (Data, Variable, Abs): the player's level
+    
+    0x85, 0x06,                 // Report ID = 6 (seek in milliseconds, see APP_SEEK_SCRUB)
+    0x09, 0x05,                 // Usage (Vendor Usage 5)
+    0x16, 0x01, 0x80,           // Logical Minimum (-32767)
+    0x26, 0xFF, 0x7F,           // Logical Maximum (32767)
+    0x75, 0x10,                 // Report Size: 16-bit field
+    0x95, 0x01,                 // Report Count: one field
+    0x81, 0x06,                 // Input (Data, Variable, Rel)
+    
+    0x85, 0x07,                 // Report ID = 7 (device state, MEDIA_CONTROLLER_STATE_REPORT_T)
+    0x09, 0x06,                 // Usage (Vendor Usage 6)
+    0x15, 0x00,                 // Logical Minimum (0)
+    0x26, 0xFF, 0x00,           // Logical Maximum (255)
+    0x75, 0x08,                 // Report Size: 8-bit fields
+    0x95, 0x02,                 // Report Count: sequence and flags
+    0x81, 0x02,                 // Input (Data, Variable, Abs)
+    
+    0x85, 0x08,                 // Report ID = 8 (bus reset recovery, MEDIA_CONTROLLER_RECOVERY_REPORT_T)
+    0x09, 0x07,                 // Usage (Vendor Usage 7)
+    0x95, 0x0E,                 // Report Count: 14 bytes after the report ID
+    0xB1, 0x02,                 // Feature (Data, Variable, Abs)
+    
+    0x85, 0x09,                 // Report ID = 9 (crash record, MEDIA_CONTROLLER_CRASH_REPORT_T)
+    0x09, 0x08,                 // Usage (Vendor Usage 8)
+    0x95, 12 + (2 * APP_CRASH_TRACE_SIZE), // Report Count: bytes after the report ID
+    0xB1, 0x02,                 // Feature (Data, Variable, Abs)
+    0xC0
+};
+
+/****************************************************
+ * Class specific descriptor - HID Report descriptor
+ * of interface 4, boot protocol keyboard
+ ****************************************************/
+const uint8_t hid_rpt2[] =
+{
+    0x05, 0x01,             // Usage Page (Generic Desktop)
+    0x09, 0x06,             // Usage (Keyboard)
+    0xA1, 0x01,             // Collection (Application)
+    0x05, 0x07,                 // Usage Page (Key Codes)
+    0x19, 0xE0,                 // Usage Minimum (Left Control)
+    0x29, 0xE7,                 // Usage Maximum (Right GUI)
+    0x15, 0x00,                 // Logical Minimum (0)
+    0x25, 0x01,                 // Logical Maximum (1)
+    0x75, 0x01,                 // Report Size (1)
+    0x95, 0x08,                 // Report Count (8)
+    0x81, 0x02,                 // Input (Data, Variable, Absolute): modifier byte
+    0x95, 0x01,                 // Report Count (1)
+    0x75, 0x08,                 // Report Size (8)
+    0x81, 0x01,                 // Input (Constant): reserved byte
+    0x95, 0x05,                 // Report Count (5)
+    0x75, 0x01,                 // Report Size (1)
+    0x05, 0x08,                 // Usage Page (LEDs)
+    0x19, 0x01,                 // Usage Minimum (Num Lock)
+    0x29, 0x05,                 // Usage Maximum (Kana)
+    0x91, 0x02,                 // Output (Data, Variable, Absolute): LED report
+    0x95, 0x01,                 // Report Count (1)
+    0x75, 0x03,                 // Report Size (3)
+    0x91, 0x01,                 // Output (Constant): LED report padding
+    0x95, 0x06,                 // Report Count (6)
+    0x75, 0x08,                 // Report Size (8)
+    0x15, 0x00,                 // Logical Minimum (0)
+    0x25, 0x65,                 // Logical Maximum (101)
+    0x05, 0x07,                 // Usage Page (Key Codes)
+    0x19, 0x00,                 // Usage Minimum (0)
+    0x29, 0x65,                 // Usage Maximum (101)
+    0x81, 0x00,                 // Input (Data, Array): key arrays (6 bytes)
+    0xC0                    // End Collection
 };
 
 /**************************************************
  * USB Device HID Function Init Data
  **************************************************/
+/* Media keys only: no output reports, so no receive queue */
 const USB_DEVICE_HID_INIT hidInit0 =
 {
 	 .hidReportDescriptorSize = sizeof(hid_rpt0),
 	 .hidReportDescriptor = (void *)&hid_rpt0,
+	 .queueSizeReportReceive = 0,
+	 .queueSizeReportSend = 1
+};
+
+const USB_DEVICE_HID_INIT hidInit1 =
+{
+	 .hidReportDescriptorSize = sizeof(hid_rpt1),
+	 .hidReportDescriptor = (void *)&hid_rpt1,
 	 .queueSizeReportReceive = 1,
 	 .queueSizeReportSend = 1
 };
 
+/* The keyboard LEDs arrive over EP0, so no receive queue */
+const USB_DEVICE_HID_INIT hidInit2 =
+{
+	 .hidReportDescriptorSize = sizeof(hid_rpt2),
+	 .hidReportDescriptor = (void *)&hid_rpt2,
+	 .queueSizeReportReceive = 0,
+	 .queueSizeReportSend = 1
+};
+
+
 
+/**************************************************
+ * USB Device CDC Function Init Data
+ **************************************************/
+const USB_ACM_INIT cdcInit0 =
+{
+	 .queueSizeRead = 1,
+	 .queueSizeWrite = 2
+};
 
 /**************************************************
  * USB Device Layer Function Driver Registration 
  * Table
  **************************************************/
-const USB_DEVICE_FUNCTION_REGISTRATION_TABLE funcRegistrationTable[1] =
+const USB_DEVICE_FUNCTION_REGISTRATION_TABLE funcRegistrationTable[4] =
 {
     
-	/* HID Function 0 */
+	/* HID Function 0, consumer control */
     { 
         .configurationValue = 1,    /* Configuration value */ 
         .interfaceNumber = 0,       /* First interfaceNumber of this function */ 
@@ -128,6 +252,38 @@ const USB_DEVICE_FUNCTION_REGISTRATION_TABLE funcRegistrationTable[1] =
         .funcDriverInit = (void*)&hidInit0    /* Function driver init data */
     },
 
+	/* HID Function 1, vendor channel */
+    { 
+        .configurationValue = 1,    /* Configuration value */ 
+        .interfaceNumber = 1,       /* First interfaceNumber of this function */ 
+        .speed = USB_SPEED_HIGH|USB_SPEED_FULL,    /* Function Speed */ 
+        .numberOfInterfaces = 1,    /* Number of interfaces */
+        .funcDriverIndex = 1,  /* Index of HID Function Driver */
+        .driver = (void*)USB_DEVICE_HID_FUNCTION_DRIVER,    /* USB HID function data exposed to device layer */
+        .funcDriverInit = (void*)&hidInit1    /* Function driver init data */
+    },
+
+	/* CDC Function 0, the diagnostics console */
+    { 
+        .configurationValue = 1,    /* Configuration value */ 
+        .interfaceNumber = 2,       /* First interfaceNumber of this function */ 
+        .speed = USB_SPEED_HIGH|USB_SPEED_FULL,    /* Function Speed */ 
+        .numberOfInterfaces = 2,    /* Communications and data interfaces */
+        .funcDriverIndex = 0,  /* Index of CDC Function Driver */
+        .driver = (void*)USB_ACM_FUNCTION_DRIVER,    /* USB CDC function data exposed to device layer */
+        .funcDriverInit = (void*)&cdcInit0    /* Function driver init data */
+    },
+
+	/* HID Function 2, boot keyboard for YouTube shortcuts */
+    { 
+        .configurationValue = 1,    /* Configuration value */ 
+        .interfaceNumber = 4,       /* First interfaceNumber of this function */ 
+        .speed = USB_SPEED_HIGH|USB_SPEED_FULL,    /* Function Speed */ 
+        .numberOfInterfaces = 1,    /* Number of interfaces */
+        .funcDriverIndex = 2,  /* Index of HID Function Driver */
+        .driver = (void*)USB_DEVICE_HID_FUNCTION_DRIVER,    /* USB HID function data exposed to device layer */
+        .funcDriverInit = (void*)&hidInit2    /* Function driver init data */
+    },
 
 
 };
@@ -144,9 +300,9 @@ const USB_DEVICE_DESCRIPTOR deviceDescriptor =
     0x12,                                                   // Size of this descriptor in bytes
     USB_DESCRIPTOR_DEVICE,                                  // DEVICE descriptor type
     0x0200,                                                 // USB Spec Release Number in BCD format
-    0x00,         // Class Code
-    0x00,         // Subclass code
-    0x00,         // Protocol code
+    0xEF,         // Class Code: Miscellaneous, functions are described by IADs
+    0x02,         // Subclass code: Common Class
+    0x01,         // Protocol code: Interface Association Descriptor
 
 
     USB_DEVICE_EP0_BUFFER_SIZE,                             // Max packet size for EP0, see configuration.h
@@ -169,8 +325,8 @@ const uint8_t fullSpeedConfigurationDescriptor[]=
 
     0x09,                                                   // Size of this descriptor in bytes
     USB_DESCRIPTOR_CONFIGURATION,                           // Descriptor Type
-    USB_DEVICE_16bitTo8bitArrange(41),                      //(41 Bytes)Size of the Configuration descriptor
-    1,                                                      // Number of interfaces in this configuration
+    USB_DEVICE_16bitTo8bitArrange(189),                     //(189 Bytes)Size of the Configuration descriptor
+    5,                                                      // Number of interfaces in this configuration
     0x01,                                                   // Index value of this configuration
     0x00,                                                   // Configuration string index
     USB_ATTRIBUTE_DEFAULT | USB_ATTRIBUTE_SELF_POWERED, // Attributes
@@ -183,7 +339,7 @@ const uint8_t fullSpeedConfigurationDescriptor[]=
     USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
     0,                                  // Interface Number
     0x00,                                  // Alternate Setting Number
-    0x02,                                  // Number of endpoints in this interface
+    0x01,                                  // Number of endpoints in this interface
     USB_HID_CLASS_CODE,                 // Class code
     USB_HID_SUBCLASS_CODE_NO_SUBCLASS , // Subclass code
     USB_HID_PROTOCOL_CODE_NONE,         // No Protocol
@@ -203,7 +359,82 @@ const uint8_t fullSpeedConfigurationDescriptor[]=
 
     0x07,                           // Size of this descriptor in bytes
     USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
-    1 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP1 IN )
+    1 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP1 IN, media keys )
+    USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
+    0x02,0x00,                      // Size: report ID and key bits
+    0x01,                           // Interval
+
+	/* Interface Descriptor: vendor channel, alternate setting 0. The
+	   endpoints fit the largest report of their direction, so an idle
+	   channel reserves little periodic bandwidth. */
+
+    0x09,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
+    1,                                  // Interface Number
+    0x00,                                  // Alternate Setting Number
+    0x02,                                  // Number of endpoints in this interface
+    USB_HID_CLASS_CODE,                 // Class code
+    USB_HID_SUBCLASS_CODE_NO_SUBCLASS , // Subclass code
+    USB_HID_PROTOCOL_CODE_NONE,         // No Protocol
+    0x00,                                  // Interface string index
+
+    /* HID Class-Specific Descriptor */
+
+    0x09,                           // Size of this descriptor in bytes
+    USB_HID_DESCRIPTOR_TYPES_HID,   // HID descriptor type
+    0x11,0x01,                      // HID Spec Release Number in BCD format (1.11)
+    0x00,                           // Country Code (0x00 for Not supported)
+    1,                              // Number of class descriptors
+    USB_HID_DESCRIPTOR_TYPES_REPORT,// Report descriptor type
+    USB_DEVICE_16bitTo8bitArrange(sizeof(hid_rpt1)),   // Size of the report descriptor
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    2 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP2 IN, vendor reports )
+    USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
+    0x03,0x00,                      // Size: the seek report, report ID and 16 bits
+    0x01,                           // Interval
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    2 | USB_EP_DIRECTION_OUT,   // EndpointAddress ( EP2 OUT, vendor reports )
+    USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
+    0x02,0x00,                      // Size: report ID and one byte
+    0x01,                           // Interval
+
+	/* Interface Descriptor: vendor channel, alternate setting 1, full
+	   size endpoints. A host that needs the 64-byte path selects it with
+	   SET_INTERFACE. */
+
+    0x09,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
+    1,                                  // Interface Number
+    0x01,                                  // Alternate Setting Number
+    0x02,                                  // Number of endpoints in this interface
+    USB_HID_CLASS_CODE,                 // Class code
+    USB_HID_SUBCLASS_CODE_NO_SUBCLASS , // Subclass code
+    USB_HID_PROTOCOL_CODE_NONE,         // No Protocol
+    0x00,                                  // Interface string index
+
+    /* HID Class-Specific Descriptor */
+
+    0x09,                           // Size of this descriptor in bytes
+    USB_HID_DESCRIPTOR_TYPES_HID,   // HID descriptor type
+    0x11,0x01,                      // HID Spec Release Number in BCD format (1.11)
+    0x00,                           // Country Code (0x00 for Not supported)
+    1,                              // Number of class descriptors
+    USB_HID_DESCRIPTOR_TYPES_REPORT,// Report descriptor type
+    USB_DEVICE_16bitTo8bitArrange(sizeof(hid_rpt1)),   // Size of the report descriptor
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    2 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP2 IN, vendor reports )
     USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
     0x40,0x00,                      // Size
     0x01,                           // Interval
@@ -212,15 +443,135 @@ const uint8_t fullSpeedConfigurationDescriptor[]=
 
     0x07,                           // Size of this descriptor in bytes
     USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
-    1 | USB_EP_DIRECTION_OUT,   // EndpointAddress ( EP1 OUT )
+    2 | USB_EP_DIRECTION_OUT,   // EndpointAddress ( EP2 OUT, vendor reports )
     USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
-    0x40,0x00,                      // size
+    0x40,0x00,                      // Size
     0x01,                           // Interval
-    
-    
 
+    /* Interface Association Descriptor: interfaces 2 and 3 are one CDC
+       function, so the host binds a single ACM driver to them */
+
+    0x08,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE_ASSOCIATION,   // Interface Association Descriptor
+    2,                                  // First interface
+    2,                                  // Interface count
+    USB_ACM_COMMUNICATIONS_INTERFACE_CLASS_CODE,    // Function class
+    USB_ACM_SUBCLASS_ABSTRACT_CONTROL_MODEL,        // Function subclass
+    USB_ACM_PROTOCOL_NO_CLASS_SPECIFIC,             // Function protocol
+    0x00,                               // Function string index
+
+    /* CDC Communications Interface Descriptor */
+
+    0x09,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
+    2,                                  // Interface Number
+    0x00,                               // Alternate Setting Number
+    0x01,                               // Number of endpoints in this interface
+    USB_ACM_COMMUNICATIONS_INTERFACE_CLASS_CODE,    // Class code
+    USB_ACM_SUBCLASS_ABSTRACT_CONTROL_MODEL,        // Subclass code
+    USB_ACM_PROTOCOL_NO_CLASS_SPECIFIC,             // Protocol code
+    0x00,                               // Interface string index
+
+    /* CDC Header Functional Descriptor */
+
+    0x05,                               // Size of this descriptor in bytes
+    USB_ACM_DESC_CS_INTERFACE,          // CS_INTERFACE
+    USB_ACM_FUNCTIONAL_HEADER,          // Header
+    0x20,0x01,                          // CDC Spec Release Number in BCD format (1.20)
+
+    /* CDC Call Management Functional Descriptor */
+
+    0x05,                               // Size of this descriptor in bytes
+    USB_ACM_DESC_CS_INTERFACE,          // CS_INTERFACE
+    USB_ACM_FUNCTIONAL_CALL_MANAGEMENT, // Call Management
+    0x00,                               // bmCapabilities: no call management
+    3,                                  // Data interface
+
+    /* CDC Abstract Control Management Functional Descriptor */
+
+    0x04,                               // Size of this descriptor in bytes
+    USB_ACM_DESC_CS_INTERFACE,          // CS_INTERFACE
+    USB_ACM_FUNCTIONAL_ABSTRACT_CONTROL_MANAGEMENT,     // Abstract Control Management
+    USB_ACM_SUPPORT_LINE_CODING_LINE_STATE_AND_NOTIFICATION,    // bmCapabilities
+
+    /* CDC Union Functional Descriptor */
+
+    0x05,                               // Size of this descriptor in bytes
+    USB_ACM_DESC_CS_INTERFACE,          // CS_INTERFACE
+    USB_ACM_FUNCTIONAL_UNION,           // Union
+    2,                                  // Control interface
+    3,                                  // Subordinate (data) interface
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    3 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP3 IN, notifications )
+    USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
+    0x0A,0x00,                      // Size: one SERIAL_STATE notification
+    0xFF,                           // Interval, never sent
+
+    /* CDC Data Interface Descriptor */
 
+    0x09,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
+    3,                                  // Interface Number
+    0x00,                               // Alternate Setting Number
+    0x02,                               // Number of endpoints in this interface
+    USB_ACM_DATA_INTERFACE_CLASS_CODE,  // Class code
+    0x00,                               // Subclass code
+    USB_ACM_PROTOCOL_NO_CLASS_SPECIFIC, // Protocol code
+    0x00,                               // Interface string index
 
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    4 | USB_EP_DIRECTION_OUT,   // EndpointAddress ( EP4 OUT )
+    USB_TRANSFER_TYPE_BULK,         // Attributes
+    0x40,0x00,                      // Size
+    0x00,                           // Interval
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    4 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP4 IN )
+    USB_TRANSFER_TYPE_BULK,         // Attributes
+    0x40,0x00,                      // Size
+    0x00,                           // Interval
+
+	/* Interface Descriptor: a boot keyboard, so the shortcuts also work
+	   where only the boot protocol is understood */
+
+    0x09,                               // Size of this descriptor in bytes
+    USB_DESCRIPTOR_INTERFACE,           // Descriptor Type is Interface descriptor
+    4,                                  // Interface Number
+    0x00,                                  // Alternate Setting Number
+    0x01,                                  // Number of endpoints in this interface
+    USB_HID_CLASS_CODE,                 // Class code
+    USB_HID_SUBCLASS_CODE_BOOT_INTERFACE_SUBCLASS,  // Subclass code
+    USB_HID_PROTOCOL_CODE_KEYBOARD,     // Keyboard Protocol
+    0x00,                                  // Interface string index
+
+    /* HID Class-Specific Descriptor */
+
+    0x09,                           // Size of this descriptor in bytes
+    USB_HID_DESCRIPTOR_TYPES_HID,   // HID descriptor type
+    0x11,0x01,                      // HID Spec Release Number in BCD format (1.11)
+    0x00,                           // Country Code (0x00 for Not supported)
+    1,                              // Number of class descriptors
+    USB_HID_DESCRIPTOR_TYPES_REPORT,// Report descriptor type
+    USB_DEVICE_16bitTo8bitArrange(sizeof(hid_rpt2)),   // Size of the report descriptor
+
+    /* Endpoint Descriptor */
+
+    0x07,                           // Size of this descriptor in bytes
+    USB_DESCRIPTOR_ENDPOINT,        // Endpoint Descriptor
+    5 | USB_EP_DIRECTION_IN,    // EndpointAddress ( EP5 IN, keyboard )
+    USB_TRANSFER_TYPE_INTERRUPT,    // Attributes
+    0x08,0x00,                      // Size: one boot keyboard report
+    0x01,                           // Interval
 };
 
 /*******************************************
@@ -321,7 +672,7 @@ const USB_DEVICE_INIT usbDevInitData =
 {
     /* Number of function drivers registered to this instance of the
        USB device layer */
-    .registeredFuncCount = 1,
+    .registeredFuncCount = 4,
 	
     /* Function driver table registered to this instance of the USB device layer*/
     .registeredFunctions = (USB_DEVICE_FUNCTION_REGISTRATION_TABLE*)funcRegistrationTable,
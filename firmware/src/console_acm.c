@@ -0,0 +1,357 @@
+/*******************************************************************************
+  CDC-ACM Console Device
+
+  File Name:
+    console_acm.c
+
+  Summary:
+    Console System Service I/O device on the CDC-ACM function
+
+  Description:
+    This file contains the console I/O device that carries the console over
+    the CDC-ACM function of the USB device. It registers with the CDC function
+    driver when initialized and moves data from SYS_CONSOLE_Tasks; it does not
+    open the device layer, which stays with the application.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "system/console/sys_console.h"
+#include "console_acm_local.h"
+#include "configuration.h"
+#include "definitions.h"
+
+#if ((CONSOLE_ACM_WRITE_BUFFER_SIZE & (CONSOLE_ACM_WRITE_BUFFER_SIZE - 1)) != 0) || \
+    ((CONSOLE_ACM_READ_BUFFER_SIZE & (CONSOLE_ACM_READ_BUFFER_SIZE - 1)) != 0)
+    #error "CONSOLE_ACM buffer sizes must be powers of two"
+#endif
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Variable Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+const SYS_CONSOLE_DEV_DESC consoleACMDevDesc =
+{
+    .consoleDevice              = SYS_CONSOLE_DEV_USB_CDC,
+    .intent                     = DRV_IO_INTENT_READWRITE,
+    .init                       = Console_ACM_Initialize,
+    .read                       = Console_ACM_Read,
+    .readFreeBufferCountGet     = Console_ACM_ReadFreeBufferCountGet,
+    .readCountGet               = Console_ACM_ReadCountGet,
+    .write                      = Console_ACM_Write,
+    .writeFreeBufferCountGet    = Console_ACM_WriteFreeBufferCountGet,
+    .writeCountGet              = Console_ACM_WriteCountGet,
+    .task                       = Console_ACM_Tasks,
+    .status                     = Console_ACM_Status,
+    .flush                      = Console_ACM_Flush,
+};
+
+static CONSOLE_ACM_DATA gConsoleAcmData[CONSOLE_ACM_MAX_INSTANCES];
+
+#define CONSOLE_ACM_GET_INSTANCE(index)    (index >= CONSOLE_ACM_MAX_INSTANCES)? NULL : &gConsoleAcmData[index]
+
+static bool Console_ACM_ResourceLock(CONSOLE_ACM_DATA* pConsoleAcmData)
+{
+    if(OSAL_MUTEX_Lock(&(pConsoleAcmData->mutexTransferObjects), OSAL_WAIT_FOREVER) == OSAL_RESULT_FALSE)
+    {
+        return false;
+    }
+    else
+    {
+        return true;
+    }
+}
+
+static void Console_ACM_ResourceUnlock(CONSOLE_ACM_DATA* pConsoleAcmData)
+{
+    OSAL_MUTEX_Unlock(&(pConsoleAcmData->mutexTransferObjects));
+}
+
+/* Runs in the USB interrupt */
+static void Console_ACM_EventHandler
+(
+    USB_ACM_INDEX cdcIndex,
+    USB_ACM_EVENT event,
+    void * pData,
+    uintptr_t context
+)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = &gConsoleAcmData[context];
+    USB_ACM_EVENT_DATA_READ_COMPLETE* readComplete;
+    USB_ACM_EVENT_DATA_WRITE_COMPLETE* writeComplete;
+    uint32_t readIn;
+    size_t i;
+
+    switch(event)
+    {
+        case USB_ACM_EVENT_WRITE_COMPLETE:
+
+            writeComplete = (USB_ACM_EVENT_DATA_WRITE_COMPLETE *)pData;
+
+            /* A write cancelled by a reset or deconfiguration is sent again
+               once the port is configured */
+            if(writeComplete->status == USB_ACM_RESULT_OK)
+            {
+                pConsoleAcmData->writeOut += pConsoleAcmData->writeLength;
+            }
+            pConsoleAcmData->isWritePending = false;
+            break;
+
+        case USB_ACM_EVENT_READ_COMPLETE:
+
+            readComplete = (USB_ACM_EVENT_DATA_READ_COMPLETE *)pData;
+
+            if(readComplete->status == USB_ACM_RESULT_OK)
+            {
+                /* The read was only submitted with a packet of room left */
+                readIn = pConsoleAcmData->readIn;
+                for(i = 0; i < readComplete->length; i++)
+                {
+                    pConsoleAcmData->readBuffer[readIn & (CONSOLE_ACM_READ_BUFFER_SIZE - 1)] = pConsoleAcmData->readPacket[i];
+                    readIn++;
+                }
+                pConsoleAcmData->readIn = readIn;
+            }
+            pConsoleAcmData->isReadPending = false;
+            break;
+
+        default:
+            break;
+    }
+}
+
+void Console_ACM_Initialize(uint32_t index, const void* initData)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+    const CONSOLE_ACM_INIT_DATA* consoleAcmInitData = (const CONSOLE_ACM_INIT_DATA*)initData;
+
+    if (pConsoleAcmData == NULL)
+    {
+        return;
+    }
+
+    if(OSAL_MUTEX_Create(&(pConsoleAcmData->mutexTransferObjects)) != OSAL_RESULT_TRUE)
+    {
+        return;
+    }
+
+    pConsoleAcmData->cdcInstanceIndex = consoleAcmInitData->cdcInstanceIndex;
+
+    if(USB_ACM_EventHandlerSet(pConsoleAcmData->cdcInstanceIndex, Console_ACM_EventHandler, index) != USB_ACM_RESULT_OK)
+    {
+        pConsoleAcmData->status = SYS_CONSOLE_STATUS_ERROR;
+        return;
+    }
+
+    pConsoleAcmData->status = SYS_CONSOLE_STATUS_CONFIGURED;
+}
+
+/* Read out the data received from the host */
+ssize_t Console_ACM_Read(uint32_t index, void* pRdBuffer, size_t count)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+    uint8_t* pData = (uint8_t*)pRdBuffer;
+    uint32_t readOut;
+    size_t nBytesRead = 0;
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    if (Console_ACM_ResourceLock(pConsoleAcmData) == false)
+    {
+        return -1;
+    }
+
+    readOut = pConsoleAcmData->readOut;
+    while((nBytesRead < count) && (readOut != pConsoleAcmData->readIn))
+    {
+        pData[nBytesRead++] = pConsoleAcmData->readBuffer[readOut & (CONSOLE_ACM_READ_BUFFER_SIZE - 1)];
+        readOut++;
+    }
+    pConsoleAcmData->readOut = readOut;
+
+    Console_ACM_ResourceUnlock(pConsoleAcmData);
+
+    return nBytesRead;
+}
+
+ssize_t Console_ACM_ReadCountGet(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)(pConsoleAcmData->readIn - pConsoleAcmData->readOut);
+}
+
+ssize_t Console_ACM_ReadFreeBufferCountGet(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)(CONSOLE_ACM_READ_BUFFER_SIZE - (pConsoleAcmData->readIn - pConsoleAcmData->readOut));
+}
+
+/* Copy as much as fits into the write ring; the rest is dropped */
+ssize_t Console_ACM_Write(uint32_t index, const void* pWrBuffer, size_t count)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+    const uint8_t* pData = (const uint8_t*)pWrBuffer;
+    uint32_t writeIn;
+    size_t nFree;
+    size_t nBytesWritten = 0;
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    if (Console_ACM_ResourceLock(pConsoleAcmData) == false)
+    {
+        return -1;
+    }
+
+    writeIn = pConsoleAcmData->writeIn;
+    nFree = CONSOLE_ACM_WRITE_BUFFER_SIZE - (writeIn - pConsoleAcmData->writeOut);
+    while((nBytesWritten < count) && (nBytesWritten < nFree))
+    {
+        pConsoleAcmData->writeBuffer[writeIn & (CONSOLE_ACM_WRITE_BUFFER_SIZE - 1)] = pData[nBytesWritten++];
+        writeIn++;
+    }
+    pConsoleAcmData->writeIn = writeIn;
+
+    Console_ACM_ResourceUnlock(pConsoleAcmData);
+
+    return nBytesWritten;
+}
+
+ssize_t Console_ACM_WriteFreeBufferCountGet(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)(CONSOLE_ACM_WRITE_BUFFER_SIZE - (pConsoleAcmData->writeIn - pConsoleAcmData->writeOut));
+}
+
+ssize_t Console_ACM_WriteCountGet(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+
+    if (pConsoleAcmData == NULL)
+    {
+        return -1;
+    }
+
+    return (ssize_t)(pConsoleAcmData->writeIn - pConsoleAcmData->writeOut);
+}
+
+/* Drop the output that has not been handed to the CDC driver yet */
+bool Console_ACM_Flush(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+    OSAL_CRITSECT_DATA_TYPE critSect;
+
+    if (pConsoleAcmData == NULL)
+    {
+        return false;
+    }
+
+    if (Console_ACM_ResourceLock(pConsoleAcmData) == false)
+    {
+        return false;
+    }
+
+    critSect = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+    pConsoleAcmData->writeIn = pConsoleAcmData->writeOut +
+            (pConsoleAcmData->isWritePending ? pConsoleAcmData->writeLength : 0);
+    OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, critSect);
+
+    Console_ACM_ResourceUnlock(pConsoleAcmData);
+
+    return true;
+}
+
+SYS_CONSOLE_STATUS Console_ACM_Status(uint32_t index)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+
+    if (pConsoleAcmData == NULL)
+    {
+        return SYS_CONSOLE_STATUS_ERROR;
+    }
+    else
+    {
+        return pConsoleAcmData->status;
+    }
+}
+
+void Console_ACM_Tasks(uint32_t index, SYS_MODULE_OBJ object)
+{
+    CONSOLE_ACM_DATA* pConsoleAcmData = CONSOLE_ACM_GET_INSTANCE(index);
+    USB_ACM_TRANSFER_HANDLE transferHandle;
+    uint32_t writeOut;
+    size_t offset;
+    size_t length;
+
+    if ((pConsoleAcmData == NULL) || (pConsoleAcmData->status != SYS_CONSOLE_STATUS_CONFIGURED))
+    {
+        return;
+    }
+
+    if (!USB_ACM_IsConfigured(pConsoleAcmData->cdcInstanceIndex))
+    {
+        return;
+    }
+
+    if (!pConsoleAcmData->isReadPending &&
+        ((CONSOLE_ACM_READ_BUFFER_SIZE - (pConsoleAcmData->readIn - pConsoleAcmData->readOut)) >= CONSOLE_ACM_PACKET_SIZE))
+    {
+        pConsoleAcmData->isReadPending = true;
+        if (USB_ACM_Read(pConsoleAcmData->cdcInstanceIndex, &transferHandle,
+                pConsoleAcmData->readPacket, CONSOLE_ACM_PACKET_SIZE) != USB_ACM_RESULT_OK)
+        {
+            pConsoleAcmData->isReadPending = false;
+        }
+    }
+
+    writeOut = pConsoleAcmData->writeOut;
+    if (!pConsoleAcmData->isWritePending && (pConsoleAcmData->writeIn != writeOut))
+    {
+        /* Send up to the end of the ring; the rest goes in the next write */
+        offset = writeOut & (CONSOLE_ACM_WRITE_BUFFER_SIZE - 1);
+        length = pConsoleAcmData->writeIn - writeOut;
+        if (length > (CONSOLE_ACM_WRITE_BUFFER_SIZE - offset))
+        {
+            length = CONSOLE_ACM_WRITE_BUFFER_SIZE - offset;
+        }
+
+        pConsoleAcmData->writeLength = length;
+        pConsoleAcmData->isWritePending = true;
+        if (USB_ACM_Write(pConsoleAcmData->cdcInstanceIndex, &transferHandle,
+                &pConsoleAcmData->writeBuffer[offset], length,
+                USB_ACM_TRANSFER_FLAGS_DATA_COMPLETE) != USB_ACM_RESULT_OK)
+        {
+            pConsoleAcmData->isWritePending = false;
+        }
+    }
+}
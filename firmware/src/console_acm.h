@@ -0,0 +1,55 @@
+/*******************************************************************************
+  CDC-ACM Console Definitions
+
+  File Name:
+    console_acm.h
+
+  Summary:
+    Initialization data of the CDC-ACM console I/O device.
+
+  Description:
+    This file contains the definitions required by the CDC-ACM console I/O
+    device, which plugs into the Console System Service through
+    consoleACMDevDesc. They are filled in by initialization.c. Like usb_acm.h
+    it belongs to the project, not to the Harmony configuration.
+*******************************************************************************/
+
+#ifndef CONSOLE_ACM_H
+#define CONSOLE_ACM_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "usb_acm.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+/* CDC-ACM Console Initialization Data
+
+  Summary:
+    Selects the CDC function driver instance a console device uses.
+*/
+
+typedef struct
+{
+    USB_ACM_INDEX cdcInstanceIndex;
+
+} CONSOLE_ACM_INIT_DATA;
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif /* CONSOLE_ACM_H */
@@ -0,0 +1,125 @@
+/*******************************************************************************
+  CDC-ACM Console Device
+
+  File Name:
+    console_acm_local.h
+
+  Summary:
+    Local declarations of the CDC-ACM console I/O device.
+
+  Description:
+    This file contains the device object and the device functions of the USB
+    CDC console, which carries the console over the CDC-ACM function of the
+    composite USB device.
+*******************************************************************************/
+
+#ifndef CONSOLE_ACM_LOCAL_H
+#define CONSOLE_ACM_LOCAL_H
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File includes
+// *****************************************************************************
+// *****************************************************************************
+
+#include "configuration.h"
+#include "system/console/src/sys_console_local.h"
+#include "osal/osal.h"
+#include "system/console/sys_console.h"
+#include "console_acm.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Type Definitions
+// *****************************************************************************
+// *****************************************************************************
+
+/* Full speed bulk packet size of the CDC data endpoints */
+#define CONSOLE_ACM_PACKET_SIZE         64
+
+// *****************************************************************************
+/* CDC-ACM Console Device Object
+
+  Summary:
+    State of one CDC-ACM console.
+
+  Description:
+    Both buffers are rings indexed by free-running counts. The console
+    functions fill the write ring and drain the read ring; the CDC completion
+    events, which run in the USB interrupt, drain the write ring and fill the
+    read ring. Each index has a single writer, so no lock is shared with the
+    interrupt.
+
+    Console_ACM_Tasks submits the transfers: one write of the contiguous
+    bytes at writeOut while none is in flight, and one packet-sized read while
+    the read ring has room for it.
+*/
+
+typedef struct
+{
+    SYS_CONSOLE_STATUS status;
+
+    USB_ACM_INDEX cdcInstanceIndex;
+
+    volatile bool isWritePending;
+
+    volatile bool isReadPending;
+
+    /* Bytes of the write in flight */
+    size_t writeLength;
+
+    volatile uint32_t writeIn;
+
+    volatile uint32_t writeOut;
+
+    volatile uint32_t readIn;
+
+    volatile uint32_t readOut;
+
+    uint8_t writeBuffer[CONSOLE_ACM_WRITE_BUFFER_SIZE];
+
+    uint8_t readBuffer[CONSOLE_ACM_READ_BUFFER_SIZE];
+
+    /* Target of the read in flight, one bulk packet */
+    uint8_t readPacket[CONSOLE_ACM_PACKET_SIZE] __attribute__((aligned(4)));
+
+    /* Protects the console side of the rings from multiple threads */
+    OSAL_MUTEX_DECLARE(mutexTransferObjects);
+
+} CONSOLE_ACM_DATA;
+
+void Console_ACM_Initialize(uint32_t index, const void* initData);
+
+SYS_CONSOLE_STATUS Console_ACM_Status(uint32_t index);
+
+void Console_ACM_Tasks(uint32_t index, SYS_MODULE_OBJ object);
+
+ssize_t Console_ACM_Read(uint32_t index, void* pRdBuffer, size_t count);
+
+ssize_t Console_ACM_ReadCountGet(uint32_t index);
+
+ssize_t Console_ACM_ReadFreeBufferCountGet(uint32_t index);
+
+ssize_t Console_ACM_Write(uint32_t index, const void* pWrBuffer, size_t count);
+
+ssize_t Console_ACM_WriteFreeBufferCountGet(uint32_t index);
+
+ssize_t Console_ACM_WriteCountGet(uint32_t index);
+
+bool Console_ACM_Flush(uint32_t index);
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+    }
+#endif
+// DOM-IGNORE-END
+
+#endif //#ifndef CONSOLE_ACM_LOCAL_H
@@ -43,6 +43,9 @@ int main ( void )
     {
         /* Maintain state machines of all polled MPLAB Harmony modules. */
         SYS_Tasks ( );
+
+        /* Only a running loop keeps the watchdog from resetting the device */
+        APP_CRASH_WatchdogService ( );
     }
 
     /* Execution should not come here during normal operation */
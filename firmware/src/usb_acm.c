@@ -0,0 +1,520 @@
+/*******************************************************************************
+  USB CDC ACM Function Driver
+
+  File Name:
+    usb_acm.c
+
+  Summary:
+    USB CDC Abstract Control Model function driver.
+
+  Description:
+    This file implements the CDC function driver interface in
+    usb_acm.h and the callbacks the device layer calls through
+    cdcFuncDriver. It is laid out like the HID function driver: one IRP pool
+    shared by all instances, and transfer completions forwarded to the
+    client's event handler.
+*******************************************************************************/
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <string.h>
+#include "usb/src/usb_external_dependencies.h"
+#include "usb_acm.h"
+#include "usb_acm_local.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Global Data
+// *****************************************************************************
+// *****************************************************************************
+
+/* Line coding reported until the host sets one: 115200 8N1 */
+#define _USB_ACM_LINE_CODING_DEFAULT_RATE    115200U
+
+/* IRPs shared by all CDC instances */
+static USB_DEVICE_IRP gUsbAcmIRP[USB_ACM_QUEUE_DEPTH_COMBINED];
+
+static USB_ACM_COMMON_DATA_OBJ gUsbAcmCommonDataObj;
+
+static USB_ACM_INSTANCE gUsbAcmInstance[USB_ACM_INSTANCES_NUMBER];
+
+// *****************************************************************************
+/* CDC Device function driver function structure
+
+  Summary:
+    Defines the function driver structure required by the device layer.
+
+  Remarks:
+    The CDC driver has no tasks routine; it runs entirely from device layer
+    and IRP callbacks.
+*/
+
+const USB_DEVICE_FUNCTION_DRIVER cdcFuncDriver =
+{
+    .initializeByDescriptor         = &_USB_ACM_InitializeByDescriptorType,
+
+    .deInitialize                   = &_USB_ACM_DeInitialize,
+
+    .controlTransferNotification    = &_USB_ACM_ControlTransferHandler,
+
+    .tasks                          = NULL,
+
+    .globalInitialize               = &_USB_ACM_GlobalInitialize
+};
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: File Scope Functions
+// *****************************************************************************
+// *****************************************************************************
+
+static USB_ACM_RESULT _USB_ACM_IRPStatusToResult(USB_DEVICE_IRP_STATUS status)
+{
+    switch(status)
+    {
+        case USB_DEVICE_IRP_STATUS_COMPLETED:
+        case USB_DEVICE_IRP_STATUS_COMPLETED_SHORT:
+            return USB_ACM_RESULT_OK;
+
+        case USB_DEVICE_IRP_STATUS_ABORTED_ENDPOINT_HALT:
+            return USB_ACM_RESULT_ERROR_ENDPOINT_HALTED;
+
+        case USB_DEVICE_IRP_STATUS_TERMINATED_BY_HOST:
+            return USB_ACM_RESULT_ERROR_TERMINATED_BY_HOST;
+
+        default:
+            return USB_ACM_RESULT_ERROR;
+    }
+}
+
+static void _USB_ACM_Notify(USB_ACM_INDEX iCDC, USB_ACM_EVENT event, void * pData)
+{
+    USB_ACM_INSTANCE * cdcInstance = &gUsbAcmInstance[iCDC];
+
+    if(cdcInstance->appCallBack != NULL)
+    {
+        cdcInstance->appCallBack(iCDC, event, pData, cdcInstance->userData);
+    }
+}
+
+static void _USB_ACM_WriteCallBack(USB_DEVICE_IRP * irp)
+{
+    USB_ACM_INDEX iCDC = irp->userData;
+    USB_ACM_EVENT_DATA_WRITE_COMPLETE writeComplete;
+
+    gUsbAcmInstance[iCDC].currentTxQueueSize--;
+
+    writeComplete.handle = (USB_ACM_TRANSFER_HANDLE)irp;
+    writeComplete.length = irp->size;
+    writeComplete.status = _USB_ACM_IRPStatusToResult(irp->status);
+
+    _USB_ACM_Notify(iCDC, USB_ACM_EVENT_WRITE_COMPLETE, &writeComplete);
+}
+
+static void _USB_ACM_ReadCallBack(USB_DEVICE_IRP * irp)
+{
+    USB_ACM_INDEX iCDC = irp->userData;
+    USB_ACM_EVENT_DATA_READ_COMPLETE readComplete;
+
+    gUsbAcmInstance[iCDC].currentRxQueueSize--;
+
+    readComplete.handle = (USB_ACM_TRANSFER_HANDLE)irp;
+    readComplete.length = irp->size;
+    readComplete.status = _USB_ACM_IRPStatusToResult(irp->status);
+
+    _USB_ACM_Notify(iCDC, USB_ACM_EVENT_READ_COMPLETE, &readComplete);
+}
+
+/* Takes a free IRP from the shared pool, counts it against the instance queue
+   and submits it. Reads and writes differ only in the endpoint, the callback
+   and the queue they count against. */
+static USB_ACM_RESULT _USB_ACM_IRPSubmit
+(
+    USB_ACM_INDEX iCDC,
+    USB_ACM_TRANSFER_HANDLE * transferHandle,
+    USB_ENDPOINT endpoint,
+    void * data,
+    size_t size,
+    USB_DEVICE_IRP_FLAG flags,
+    void (*callback)(USB_DEVICE_IRP * irp),
+    size_t * queueSize,
+    size_t queueLimit
+)
+{
+    size_t count;
+    USB_DEVICE_IRP * irp;
+    USB_ERROR irpError;
+    USB_ACM_INSTANCE * cdcInstance = &gUsbAcmInstance[iCDC];
+    OSAL_CRITSECT_DATA_TYPE status;
+
+    if(*queueSize >= queueLimit)
+    {
+        return USB_ACM_RESULT_ERROR_TRANSFER_QUEUE_FULL;
+    }
+
+    if(OSAL_MUTEX_Lock(&gUsbAcmCommonDataObj.mutexCDCIRP, OSAL_WAIT_FOREVER) != OSAL_RESULT_TRUE)
+    {
+        return USB_ACM_RESULT_ERROR;
+    }
+
+    irpError = USB_ERROR_IRP_QUEUE_FULL;
+
+    for(count = 0; count < USB_ACM_QUEUE_DEPTH_COMBINED; count++)
+    {
+        irp = &gUsbAcmIRP[count];
+        if(irp->status <= USB_DEVICE_IRP_STATUS_COMPLETED_SHORT)
+        {
+            irp->data = data;
+            irp->size = size;
+            irp->flags = flags;
+            irp->callback = callback;
+            irp->userData = iCDC;
+
+            status = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+            (*queueSize)++;
+            OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, status);
+
+            *transferHandle = (USB_ACM_TRANSFER_HANDLE)irp;
+
+            irpError = USB_DEVICE_IRPSubmit(cdcInstance->devLayerHandle, endpoint, irp);
+            if(irpError != USB_ERROR_NONE)
+            {
+                status = OSAL_CRIT_Enter(OSAL_CRIT_TYPE_HIGH);
+                (*queueSize)--;
+                OSAL_CRIT_Leave(OSAL_CRIT_TYPE_HIGH, status);
+
+                *transferHandle = USB_ACM_TRANSFER_HANDLE_INVALID;
+            }
+            break;
+        }
+    }
+
+    OSAL_MUTEX_Unlock(&gUsbAcmCommonDataObj.mutexCDCIRP);
+
+    return (USB_ACM_RESULT)irpError;
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Device Layer Callbacks
+// *****************************************************************************
+// *****************************************************************************
+
+void _USB_ACM_GlobalInitialize(void)
+{
+    if(gUsbAcmCommonDataObj.isMutexCdcIrpInitialized == false)
+    {
+        if(OSAL_MUTEX_Create(&gUsbAcmCommonDataObj.mutexCDCIRP) != OSAL_RESULT_TRUE)
+        {
+            return;
+        }
+
+        gUsbAcmCommonDataObj.isMutexCdcIrpInitialized = true;
+    }
+}
+
+void _USB_ACM_InitializeByDescriptorType
+(
+    SYS_MODULE_INDEX iCDC,
+    USB_DEVICE_HANDLE usbDeviceHandle,
+    void* funcDriverInit,
+    uint8_t intfNumber,
+    uint8_t altSetting,
+    uint8_t descriptorType,
+    uint8_t * pDescriptor
+)
+{
+    USB_ENDPOINT_DESCRIPTOR * epDescriptor = (USB_ENDPOINT_DESCRIPTOR *)pDescriptor;
+    USB_INTERFACE_DESCRIPTOR * interfaceDescriptor = (USB_INTERFACE_DESCRIPTOR *)pDescriptor;
+    USB_ACM_INSTANCE * cdcInstance = &gUsbAcmInstance[iCDC];
+
+    switch(descriptorType)
+    {
+        case USB_DESCRIPTOR_INTERFACE:
+
+            if(interfaceDescriptor->bInterfaceClass == USB_ACM_COMMUNICATIONS_INTERFACE_CLASS_CODE)
+            {
+                cdcInstance->devLayerHandle = usbDeviceHandle;
+                cdcInstance->cdcFuncInit = (const USB_ACM_INIT *)funcDriverInit;
+                cdcInstance->lineCodingPending = false;
+                cdcInstance->lineCoding.dwDTERate = _USB_ACM_LINE_CODING_DEFAULT_RATE;
+                cdcInstance->lineCoding.bCharFormat = 0;
+                cdcInstance->lineCoding.bParityType = 0;
+                cdcInstance->lineCoding.bDataBits = 8;
+                cdcInstance->controlLineState.value = 0;
+                cdcInstance->flags.interfaceReady = 1;
+            }
+            break;
+
+        case USB_DESCRIPTOR_ENDPOINT:
+
+            if(epDescriptor->transferType == USB_TRANSFER_TYPE_INTERRUPT)
+            {
+                /* Notification endpoint. Opened so the host's polls are NAKed;
+                   the SERIAL_STATE notification is never sent. */
+                cdcInstance->endpointNotification = epDescriptor->bEndpointAddress;
+                USB_DEVICE_EndpointEnable(usbDeviceHandle, 0, cdcInstance->endpointNotification,
+                        USB_TRANSFER_TYPE_INTERRUPT, epDescriptor->wMaxPacketSize);
+                cdcInstance->flags.notificationEpReady = 1;
+            }
+            else if(epDescriptor->transferType == USB_TRANSFER_TYPE_BULK)
+            {
+                if(epDescriptor->dirn == USB_DATA_DIRECTION_DEVICE_TO_HOST)
+                {
+                    cdcInstance->endpointTx = epDescriptor->bEndpointAddress;
+                    USB_DEVICE_EndpointEnable(usbDeviceHandle, 0, cdcInstance->endpointTx,
+                            USB_TRANSFER_TYPE_BULK, epDescriptor->wMaxPacketSize);
+                    cdcInstance->currentTxQueueSize = 0;
+                    cdcInstance->flags.bulkEpTxReady = 1;
+                }
+                else
+                {
+                    cdcInstance->endpointRx = epDescriptor->bEndpointAddress;
+                    cdcInstance->endpointRxSize = epDescriptor->wMaxPacketSize;
+                    USB_DEVICE_EndpointEnable(usbDeviceHandle, 0, cdcInstance->endpointRx,
+                            USB_TRANSFER_TYPE_BULK, epDescriptor->wMaxPacketSize);
+                    cdcInstance->currentRxQueueSize = 0;
+                    cdcInstance->flags.bulkEpRxReady = 1;
+                }
+            }
+            else
+            {
+                SYS_ASSERT(false, "USB ACM: unexpected endpoint type, check the descriptors");
+            }
+            break;
+
+        default:
+            /* Functional descriptors need no action */
+            break;
+    }
+}
+
+void _USB_ACM_ControlTransferHandler
+(
+    SYS_MODULE_INDEX iCDC,
+    USB_DEVICE_EVENT controlEvent,
+    USB_SETUP_PACKET * setupPkt
+)
+{
+    static uint8_t altSetting = 0;
+    USB_ACM_INSTANCE * cdcInstance = &gUsbAcmInstance[iCDC];
+    USB_DEVICE_HANDLE deviceHandle = cdcInstance->devLayerHandle;
+
+    if(controlEvent == USB_DEVICE_EVENT_CONTROL_TRANSFER_SETUP_REQUEST)
+    {
+        cdcInstance->lineCodingPending = false;
+
+        if((setupPkt->Recipient == USB_SETUP_RECIPIENT_INTERFACE) && (setupPkt->RequestType == 0))
+        {
+            switch(setupPkt->bRequest)
+            {
+                case USB_REQUEST_SET_INTERFACE:
+
+                    /* Both interfaces have only alternate setting 0 */
+                    USB_DEVICE_ControlStatus(deviceHandle, (setupPkt->W_Value.byte.LB == 0) ?
+                            USB_DEVICE_CONTROL_STATUS_OK : USB_DEVICE_CONTROL_STATUS_ERROR);
+                    break;
+
+                case USB_REQUEST_GET_INTERFACE:
+
+                    USB_DEVICE_ControlSend(deviceHandle, &altSetting, 1);
+                    break;
+
+                default:
+                    USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+                    break;
+            }
+        }
+        else if((setupPkt->Recipient == USB_SETUP_RECIPIENT_INTERFACE) && (setupPkt->RequestType == 1))
+        {
+            switch(setupPkt->bRequest)
+            {
+                case USB_ACM_REQUEST_SET_LINE_CODING:
+
+                    cdcInstance->lineCodingPending = true;
+                    USB_DEVICE_ControlReceive(deviceHandle, &cdcInstance->lineCodingReceive, sizeof(USB_ACM_LINE_CODING));
+                    break;
+
+                case USB_ACM_REQUEST_GET_LINE_CODING:
+
+                    USB_DEVICE_ControlSend(deviceHandle, &cdcInstance->lineCoding,
+                            (setupPkt->wLength < sizeof(USB_ACM_LINE_CODING)) ? setupPkt->wLength : sizeof(USB_ACM_LINE_CODING));
+                    break;
+
+                case USB_ACM_REQUEST_SET_CONTROL_LINE_STATE:
+
+                    cdcInstance->controlLineState.value = setupPkt->wValue & 0x3U;
+                    USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+                    _USB_ACM_Notify(iCDC, USB_ACM_EVENT_CONTROL_LINE_STATE, &cdcInstance->controlLineState);
+                    break;
+
+                case USB_ACM_REQUEST_SEND_BREAK:
+
+                    /* There is no line to break; accept the request */
+                    USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+                    break;
+
+                default:
+                    USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+                    break;
+            }
+        }
+        else
+        {
+            USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_ERROR);
+        }
+    }
+    else if((controlEvent == USB_DEVICE_EVENT_CONTROL_TRANSFER_DATA_RECEIVED) && cdcInstance->lineCodingPending)
+    {
+        cdcInstance->lineCodingPending = false;
+        cdcInstance->lineCoding = cdcInstance->lineCodingReceive;
+        USB_DEVICE_ControlStatus(deviceHandle, USB_DEVICE_CONTROL_STATUS_OK);
+        _USB_ACM_Notify(iCDC, USB_ACM_EVENT_SET_LINE_CODING, &cdcInstance->lineCoding);
+    }
+}
+
+void _USB_ACM_DeInitialize(SYS_MODULE_INDEX iCDC)
+{
+    USB_ACM_INSTANCE * cdcInstance = &gUsbAcmInstance[iCDC];
+    bool wasOpen = (cdcInstance->controlLineState.value != 0);
+
+    if(cdcInstance->flags.notificationEpReady)
+    {
+        USB_DEVICE_EndpointDisable(cdcInstance->devLayerHandle, cdcInstance->endpointNotification);
+    }
+
+    /* Clear the ready flags first, so a client that resubmits from the
+       cancellation callbacks below is refused */
+    if(cdcInstance->flags.bulkEpTxReady)
+    {
+        cdcInstance->flags.bulkEpTxReady = 0;
+        USB_DEVICE_IRPCancelAll(cdcInstance->devLayerHandle, cdcInstance->endpointTx);
+        USB_DEVICE_EndpointDisable(cdcInstance->devLayerHandle, cdcInstance->endpointTx);
+    }
+
+    if(cdcInstance->flags.bulkEpRxReady)
+    {
+        cdcInstance->flags.bulkEpRxReady = 0;
+        USB_DEVICE_IRPCancelAll(cdcInstance->devLayerHandle, cdcInstance->endpointRx);
+        USB_DEVICE_EndpointDisable(cdcInstance->devLayerHandle, cdcInstance->endpointRx);
+    }
+
+    cdcInstance->flags.allFlags = 0;
+    cdcInstance->controlLineState.value = 0;
+
+    if(wasOpen)
+    {
+        _USB_ACM_Notify(iCDC, USB_ACM_EVENT_CONTROL_LINE_STATE, &cdcInstance->controlLineState);
+    }
+}
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Client Interface
+// *****************************************************************************
+// *****************************************************************************
+
+USB_ACM_RESULT USB_ACM_EventHandlerSet
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_EVENT_HANDLER eventHandler,
+    uintptr_t context
+)
+{
+    USB_ACM_INSTANCE * cdcInstance;
+
+    if(instanceIndex >= USB_ACM_INSTANCES_NUMBER)
+    {
+        return USB_ACM_RESULT_ERROR_INSTANCE_INVALID;
+    }
+
+    if(eventHandler == NULL)
+    {
+        return USB_ACM_RESULT_ERROR_PARAMETER_INVALID;
+    }
+
+    cdcInstance = &gUsbAcmInstance[instanceIndex];
+    cdcInstance->userData = context;
+    cdcInstance->appCallBack = eventHandler;
+
+    return USB_ACM_RESULT_OK;
+}
+
+USB_ACM_RESULT USB_ACM_Read
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_TRANSFER_HANDLE * transferHandle,
+    void * data,
+    size_t size
+)
+{
+    USB_ACM_INSTANCE * cdcInstance;
+
+    *transferHandle = USB_ACM_TRANSFER_HANDLE_INVALID;
+
+    if(instanceIndex >= USB_ACM_INSTANCES_NUMBER)
+    {
+        return USB_ACM_RESULT_ERROR_INSTANCE_INVALID;
+    }
+
+    cdcInstance = &gUsbAcmInstance[instanceIndex];
+
+    if(!cdcInstance->flags.bulkEpRxReady)
+    {
+        return USB_ACM_RESULT_ERROR_INSTANCE_NOT_CONFIGURED;
+    }
+
+    if((size == 0) || ((size % cdcInstance->endpointRxSize) != 0))
+    {
+        return USB_ACM_RESULT_ERROR_TRANSFER_SIZE_INVALID;
+    }
+
+    return _USB_ACM_IRPSubmit(instanceIndex, transferHandle, cdcInstance->endpointRx,
+            data, size, USB_DEVICE_IRP_FLAG_NONE, &_USB_ACM_ReadCallBack,
+            &cdcInstance->currentRxQueueSize, cdcInstance->cdcFuncInit->queueSizeRead);
+}
+
+USB_ACM_RESULT USB_ACM_Write
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_TRANSFER_HANDLE * transferHandle,
+    const void * data,
+    size_t size,
+    USB_ACM_TRANSFER_FLAGS flags
+)
+{
+    USB_ACM_INSTANCE * cdcInstance;
+
+    *transferHandle = USB_ACM_TRANSFER_HANDLE_INVALID;
+
+    if(instanceIndex >= USB_ACM_INSTANCES_NUMBER)
+    {
+        return USB_ACM_RESULT_ERROR_INSTANCE_INVALID;
+    }
+
+    cdcInstance = &gUsbAcmInstance[instanceIndex];
+
+    if(!cdcInstance->flags.bulkEpTxReady)
+    {
+        return USB_ACM_RESULT_ERROR_INSTANCE_NOT_CONFIGURED;
+    }
+
+    return _USB_ACM_IRPSubmit(instanceIndex, transferHandle, cdcInstance->endpointTx,
+            (void *)data, size, (USB_DEVICE_IRP_FLAG)flags, &_USB_ACM_WriteCallBack,
+            &cdcInstance->currentTxQueueSize, cdcInstance->cdcFuncInit->queueSizeWrite);
+}
+
+bool USB_ACM_IsConfigured( USB_ACM_INDEX instanceIndex )
+{
+    if(instanceIndex >= USB_ACM_INSTANCES_NUMBER)
+    {
+        return false;
+    }
+
+    return (gUsbAcmInstance[instanceIndex].flags.bulkEpTxReady &&
+            gUsbAcmInstance[instanceIndex].flags.bulkEpRxReady);
+}
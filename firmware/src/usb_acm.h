@@ -0,0 +1,374 @@
+/*******************************************************************************
+  USB CDC ACM Function Driver
+
+  File Name:
+    usb_acm.h
+
+  Summary:
+    USB CDC Abstract Control Model function driver interface.
+
+  Description:
+    The CDC function driver presents a virtual serial port. It owns two
+    interfaces: a communications interface with an interrupt IN endpoint and a
+    data interface with a bulk IN and a bulk OUT endpoint. The data endpoints
+    are read and written through USB_ACM_Read and USB_ACM_Write.
+
+    Unlike the HID function driver, the CDC driver answers its class requests
+    itself: it keeps the line coding the host sets (the port has no baud rate
+    of its own, so the value is only echoed back) and reports changes of the
+    control line state to the client. The client does not need the device
+    layer handle and may register its event handler before the device is
+    configured; the registration survives reconfiguration.
+
+    This is the project's own driver, not the Harmony CDC function driver,
+    and only covers what the console needs. It is kept out of config/default,
+    which MHC regenerates, and its USB_ACM_ names do not clash with the
+    Harmony driver if that is ever enabled.
+*******************************************************************************/
+
+#ifndef _USB_ACM_H_
+#define _USB_ACM_H_
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "configuration.h"
+#include "system/system_common.h"
+#include "usb/usb_common.h"
+#include "usb/usb_chapter_9.h"
+#include "usb/usb_device.h"
+#include "usb/src/usb_device_function_driver.h"
+#include "usb_acm_class.h"
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Index
+
+  Summary:
+    Identifies an instance of the CDC function driver.
+*/
+
+typedef uintptr_t USB_ACM_INDEX;
+
+#define USB_ACM_INDEX_0 0
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Transfer Handle
+
+  Summary:
+    Identifies a read or write submitted to the CDC function driver.
+
+  Description:
+    Returned by USB_ACM_Read and USB_ACM_Write and passed back
+    in the completion event of the transfer.
+*/
+
+typedef uintptr_t USB_ACM_TRANSFER_HANDLE;
+
+#define USB_ACM_TRANSFER_HANDLE_INVALID  /*DOM-IGNORE-BEGIN*/((USB_ACM_TRANSFER_HANDLE)(-1))/*DOM-IGNORE-END*/
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Results
+
+  Summary:
+    Results of the CDC function driver operations.
+*/
+
+typedef enum
+{
+    /* The operation was successful */
+    USB_ACM_RESULT_OK
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_NONE /*DOM-IGNORE-END*/,
+
+    /* All transfer objects of this direction are in use */
+    USB_ACM_RESULT_ERROR_TRANSFER_QUEUE_FULL
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_IRP_QUEUE_FULL /*DOM-IGNORE-END*/,
+
+    /* The instance is not configured yet */
+    USB_ACM_RESULT_ERROR_INSTANCE_NOT_CONFIGURED
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_ENDPOINT_NOT_CONFIGURED /*DOM-IGNORE-END*/,
+
+    /* The instance is not provisioned in the system */
+    USB_ACM_RESULT_ERROR_INSTANCE_INVALID
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_DEVICE_FUNCTION_INSTANCE_INVALID /*DOM-IGNORE-END*/,
+
+    /* One or more parameters are invalid */
+    USB_ACM_RESULT_ERROR_PARAMETER_INVALID
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_PARAMETER_INVALID /*DOM-IGNORE-END*/,
+
+    /* A read size is not a multiple of the endpoint size */
+    USB_ACM_RESULT_ERROR_TRANSFER_SIZE_INVALID
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_IRP_SIZE_INVALID /*DOM-IGNORE-END*/,
+
+    /* Transfer terminated because the host halted the endpoint */
+    USB_ACM_RESULT_ERROR_ENDPOINT_HALTED
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_ENDPOINT_HALTED /*DOM-IGNORE-END*/,
+
+    /* Transfer terminated by the host with a stall clear */
+    USB_ACM_RESULT_ERROR_TERMINATED_BY_HOST
+        /*DOM-IGNORE-BEGIN*/ = USB_ERROR_TRANSFER_TERMINATED_BY_HOST /*DOM-IGNORE-END*/,
+
+    /* General error */
+    USB_ACM_RESULT_ERROR
+
+} USB_ACM_RESULT;
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Transfer Flags
+
+  Summary:
+    How USB_ACM_Write ends a transfer.
+
+  Description:
+    With USB_ACM_TRANSFER_FLAGS_DATA_COMPLETE a write whose size is a
+    multiple of the endpoint size is followed by a zero length packet, so the
+    host sees the end of the transfer. USB_ACM_TRANSFER_FLAGS_DATA_PENDING
+    leaves the transfer open for the next write.
+*/
+
+typedef enum
+{
+    USB_ACM_TRANSFER_FLAGS_DATA_COMPLETE
+        /*DOM-IGNORE-BEGIN*/ = USB_DEVICE_IRP_FLAG_DATA_COMPLETE /*DOM-IGNORE-END*/,
+
+    USB_ACM_TRANSFER_FLAGS_DATA_PENDING
+        /*DOM-IGNORE-BEGIN*/ = USB_DEVICE_IRP_FLAG_DATA_PENDING /*DOM-IGNORE-END*/
+
+} USB_ACM_TRANSFER_FLAGS;
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Events
+
+  Summary:
+    Events the CDC function driver reports to its client.
+
+  Description:
+    The events are raised from the device layer and the USB driver, so with
+    the driver in interrupt mode the handler runs in the USB interrupt.
+*/
+
+typedef enum
+{
+    /* The host changed DTR or RTS. pData is a USB_ACM_CONTROL_LINE_STATE
+       pointer. Also raised with both lines clear when the device is
+       deconfigured. */
+    USB_ACM_EVENT_CONTROL_LINE_STATE,
+
+    /* The host set the line coding. pData is a USB_ACM_LINE_CODING
+       pointer. */
+    USB_ACM_EVENT_SET_LINE_CODING,
+
+    /* A read finished. pData is a USB_ACM_EVENT_DATA_READ_COMPLETE
+       pointer. */
+    USB_ACM_EVENT_READ_COMPLETE,
+
+    /* A write finished. pData is a USB_ACM_EVENT_DATA_WRITE_COMPLETE
+       pointer. */
+    USB_ACM_EVENT_WRITE_COMPLETE
+
+} USB_ACM_EVENT;
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Transfer Completion Data
+
+  Summary:
+    Data of the USB_ACM_EVENT_READ_COMPLETE and
+    USB_ACM_EVENT_WRITE_COMPLETE events.
+
+  Description:
+    A transfer that was cancelled because the device was deconfigured or
+    reset completes with USB_ACM_RESULT_ERROR.
+*/
+
+typedef struct
+{
+    /* Handle returned when the transfer was submitted */
+    USB_ACM_TRANSFER_HANDLE handle;
+
+    /* Bytes transferred */
+    size_t length;
+
+    USB_ACM_RESULT status;
+
+} USB_ACM_EVENT_DATA_READ_COMPLETE,
+  USB_ACM_EVENT_DATA_WRITE_COMPLETE;
+
+// *****************************************************************************
+/* USB Device CDC Event Handler Function Pointer Type
+
+  Summary:
+    Signature of the client's event handler.
+*/
+
+typedef void (*USB_ACM_EVENT_HANDLER)
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_EVENT event,
+    void * pData,
+    uintptr_t context
+);
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: API definitions
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* Function:
+    USB_ACM_RESULT USB_ACM_EventHandlerSet
+    (
+        USB_ACM_INDEX instanceIndex,
+        USB_ACM_EVENT_HANDLER eventHandler,
+        uintptr_t context
+    );
+
+  Summary:
+    Registers the event handler of a CDC instance.
+
+  Description:
+    May be called at any time after USB_DEVICE_Initialize. The handler stays
+    registered across configurations.
+*/
+
+USB_ACM_RESULT USB_ACM_EventHandlerSet
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_EVENT_HANDLER eventHandler,
+    uintptr_t context
+);
+
+// *****************************************************************************
+/* Function:
+    USB_ACM_RESULT USB_ACM_Read
+    (
+        USB_ACM_INDEX instanceIndex,
+        USB_ACM_TRANSFER_HANDLE * transferHandle,
+        void * data,
+        size_t size
+    );
+
+  Summary:
+    Queues a read on the bulk OUT endpoint.
+
+  Description:
+    "size" must be a multiple of the endpoint size. The read completes when
+    the buffer is full or the host ends the transfer with a short packet, and
+    USB_ACM_EVENT_READ_COMPLETE gives the number of bytes received.
+    The buffer must not be touched until then.
+
+  Returns:
+    USB_ACM_RESULT_OK, or an error with *transferHandle set to
+    USB_ACM_TRANSFER_HANDLE_INVALID.
+*/
+
+USB_ACM_RESULT USB_ACM_Read
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_TRANSFER_HANDLE * transferHandle,
+    void * data,
+    size_t size
+);
+
+// *****************************************************************************
+/* Function:
+    USB_ACM_RESULT USB_ACM_Write
+    (
+        USB_ACM_INDEX instanceIndex,
+        USB_ACM_TRANSFER_HANDLE * transferHandle,
+        const void * data,
+        size_t size,
+        USB_ACM_TRANSFER_FLAGS flags
+    );
+
+  Summary:
+    Queues a write on the bulk IN endpoint.
+
+  Description:
+    The data is sent in as many packets as needed. The buffer must not be
+    changed until USB_ACM_EVENT_WRITE_COMPLETE.
+*/
+
+USB_ACM_RESULT USB_ACM_Write
+(
+    USB_ACM_INDEX instanceIndex,
+    USB_ACM_TRANSFER_HANDLE * transferHandle,
+    const void * data,
+    size_t size,
+    USB_ACM_TRANSFER_FLAGS flags
+);
+
+// *****************************************************************************
+/* Function:
+    bool USB_ACM_IsConfigured( USB_ACM_INDEX instanceIndex );
+
+  Summary:
+    Returns true while the data endpoints of the instance are enabled.
+*/
+
+bool USB_ACM_IsConfigured( USB_ACM_INDEX instanceIndex );
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Function Driver Registration
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Device Layer Callback Function Pointer Group
+
+  Summary:
+    The driver member of a function driver registration table entry for a
+    CDC instance.
+*/
+
+/*DOM-IGNORE-BEGIN*/extern const USB_DEVICE_FUNCTION_DRIVER cdcFuncDriver; /*DOM-IGNORE-END*/
+
+#define USB_ACM_FUNCTION_DRIVER /*DOM-IGNORE-BEGIN*/&cdcFuncDriver/*DOM-IGNORE-END*/
+
+// *****************************************************************************
+/* USB Device CDC Function Driver Initialization Data Structure
+
+  Summary:
+    The funcDriverInit member of a registration table entry for a CDC
+    instance.
+
+  Description:
+    The queue sizes bound the reads and the writes that may be pending on the
+    instance at once. All instances share USB_ACM_QUEUE_DEPTH_COMBINED
+    transfer objects.
+*/
+
+typedef struct
+{
+    size_t queueSizeRead;
+
+    size_t queueSizeWrite;
+
+} USB_ACM_INIT;
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+}
+#endif
+//DOM-IGNORE-END
+
+#endif
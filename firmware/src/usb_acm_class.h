@@ -0,0 +1,147 @@
+/*******************************************************************************
+  USB CDC Class Definitions
+
+  File Name:
+    usb_acm_class.h
+
+  Summary:
+    USB Communications Device Class codes, requests and structures.
+
+  Description:
+    This file contains the parts of the CDC 1.2 and PSTN 1.2 specifications
+    that an Abstract Control Model (virtual serial port) function needs: the
+    interface codes, the functional descriptor subtypes, the class requests
+    and the line coding and control line state structures.
+*******************************************************************************/
+
+#ifndef _USB_ACM_CLASS_H_
+#define _USB_ACM_CLASS_H_
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include <stdint.h>
+
+// DOM-IGNORE-BEGIN
+#ifdef __cplusplus  // Provide C++ Compatibility
+
+    extern "C" {
+
+#endif
+// DOM-IGNORE-END
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Constants
+// *****************************************************************************
+// *****************************************************************************
+
+/* Interface class, subclass and protocol codes */
+#define USB_ACM_COMMUNICATIONS_INTERFACE_CLASS_CODE         0x02
+#define USB_ACM_DATA_INTERFACE_CLASS_CODE                   0x0A
+#define USB_ACM_SUBCLASS_ABSTRACT_CONTROL_MODEL             0x02
+#define USB_ACM_PROTOCOL_NO_CLASS_SPECIFIC                  0x00
+#define USB_ACM_PROTOCOL_AT_V250                            0x01
+
+/* Class-specific descriptor types */
+#define USB_ACM_DESC_CS_INTERFACE                           0x24
+#define USB_ACM_DESC_CS_ENDPOINT                            0x25
+
+/* Functional descriptor subtypes */
+#define USB_ACM_FUNCTIONAL_HEADER                           0x00
+#define USB_ACM_FUNCTIONAL_CALL_MANAGEMENT                  0x01
+#define USB_ACM_FUNCTIONAL_ABSTRACT_CONTROL_MANAGEMENT      0x02
+#define USB_ACM_FUNCTIONAL_UNION                            0x06
+
+/* Abstract Control Management functional descriptor bmCapabilities: the
+   device supports SET_LINE_CODING, GET_LINE_CODING, SET_CONTROL_LINE_STATE
+   and the SERIAL_STATE notification */
+#define USB_ACM_SUPPORT_LINE_CODING_LINE_STATE_AND_NOTIFICATION     0x02
+
+// *****************************************************************************
+/* CDC Class Requests
+
+  Summary:
+    bRequest values of the CDC and PSTN class requests.
+*/
+
+typedef enum
+{
+    USB_ACM_REQUEST_SEND_ENCAPSULATED_COMMAND = 0x00,
+
+    USB_ACM_REQUEST_GET_ENCAPSULATED_RESPONSE = 0x01,
+
+    USB_ACM_REQUEST_SET_LINE_CODING = 0x20,
+
+    USB_ACM_REQUEST_GET_LINE_CODING = 0x21,
+
+    USB_ACM_REQUEST_SET_CONTROL_LINE_STATE = 0x22,
+
+    USB_ACM_REQUEST_SEND_BREAK = 0x23
+
+} USB_ACM_REQUEST;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Data Types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* CDC Line Coding
+
+  Summary:
+    Data of SET_LINE_CODING and GET_LINE_CODING (PSTN 1.2, 6.3.11).
+
+  Description:
+    bCharFormat is 0, 1 or 2 for 1, 1.5 or 2 stop bits. bParityType is 0 to
+    4 for none, odd, even, mark and space.
+*/
+
+typedef struct __attribute__((packed))
+{
+    uint32_t dwDTERate;
+
+    uint8_t bCharFormat;
+
+    uint8_t bParityType;
+
+    uint8_t bDataBits;
+
+} USB_ACM_LINE_CODING;
+
+// *****************************************************************************
+/* CDC Control Line State
+
+  Summary:
+    wValue of SET_CONTROL_LINE_STATE (PSTN 1.2, 6.3.12).
+
+  Description:
+    dtr is set while a terminal program has the port open. carrier is RTS.
+*/
+
+typedef union
+{
+    struct
+    {
+        uint16_t dtr:1;
+
+        uint16_t carrier:1;
+    };
+
+    uint16_t value;
+
+} USB_ACM_CONTROL_LINE_STATE;
+
+//DOM-IGNORE-BEGIN
+#ifdef __cplusplus
+
+    }
+
+#endif
+//DOM-IGNORE-END
+
+#endif //_USB_ACM_CLASS_H_
@@ -0,0 +1,146 @@
+/*******************************************************************************
+  USB CDC ACM Function Driver Local Data Structures
+
+  File Name:
+    usb_acm_local.h
+
+  Summary:
+    CDC function driver local declarations and definitions.
+
+  Description:
+    This file contains the instance objects and the device layer entry points
+    of the CDC function driver. It is included by usb_acm.c and, with
+    USB_DEVICE_STATIC_BINDING, by usb_device.c.
+*******************************************************************************/
+
+#ifndef _USB_ACM_LOCAL_H_
+#define _USB_ACM_LOCAL_H_
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Included Files
+// *****************************************************************************
+// *****************************************************************************
+
+#include "osal/osal.h"
+#include "usb_acm.h"
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local data types
+// *****************************************************************************
+// *****************************************************************************
+
+// *****************************************************************************
+/* CDC flags
+
+  Summary:
+    Which parts of the function the device layer has configured.
+*/
+
+typedef union _USB_ACM_FLAGS
+{
+    struct
+    {
+        uint8_t interfaceReady:1;
+        uint8_t notificationEpReady:1;
+        uint8_t bulkEpTxReady:1;
+        uint8_t bulkEpRxReady:1;
+    };
+    uint8_t allFlags;
+
+} USB_ACM_FLAGS;
+
+// *****************************************************************************
+/* CDC Instance structure
+
+  Summary:
+    State of one CDC function.
+
+  Description:
+    lineCodingReceive is the EP0 buffer of a SET_LINE_CODING data stage. It
+    is copied to lineCoding when the data stage completes, so a request
+    that fails part way does not change the reported line coding.
+*/
+
+typedef struct
+{
+    USB_ACM_FLAGS flags;
+
+    USB_DEVICE_HANDLE devLayerHandle;
+
+    const USB_ACM_INIT * cdcFuncInit;
+
+    USB_ACM_EVENT_HANDLER appCallBack;
+
+    uintptr_t userData;
+
+    /* A SET_LINE_CODING data stage is in progress */
+    bool lineCodingPending;
+
+    USB_ENDPOINT endpointNotification;
+
+    USB_ENDPOINT endpointTx;
+
+    USB_ENDPOINT endpointRx;
+
+    uint16_t endpointRxSize;
+
+    size_t currentTxQueueSize;
+
+    size_t currentRxQueueSize;
+
+    USB_ACM_LINE_CODING lineCoding;
+
+    USB_ACM_LINE_CODING lineCodingReceive;
+
+    USB_ACM_CONTROL_LINE_STATE controlLineState;
+
+} USB_ACM_INSTANCE;
+
+// *****************************************************************************
+/* CDC Common data object
+
+  Summary:
+    Data shared by all CDC instances.
+*/
+
+typedef struct
+{
+    /* Set once the mutex has been created */
+    bool isMutexCdcIrpInitialized;
+
+    /* Protects the shared IRP pool */
+    OSAL_MUTEX_DECLARE(mutexCDCIRP);
+
+} USB_ACM_COMMON_DATA_OBJ;
+
+// *****************************************************************************
+// *****************************************************************************
+// Section: Local function protoypes.
+// *****************************************************************************
+// *****************************************************************************
+
+void _USB_ACM_InitializeByDescriptorType
+(
+    SYS_MODULE_INDEX iCDC,
+    USB_DEVICE_HANDLE usbDeviceHandle,
+    void* funcDriverInit,
+    uint8_t intfNumber,
+    uint8_t altSetting,
+    uint8_t descriptorType,
+    uint8_t * pDescriptor
+);
+
+void _USB_ACM_ControlTransferHandler
+(
+    SYS_MODULE_INDEX iCDC,
+    USB_DEVICE_EVENT controlEvent,
+    USB_SETUP_PACKET * setupPkt
+);
+
+void _USB_ACM_DeInitialize(SYS_MODULE_INDEX iCDC);
+
+void _USB_ACM_GlobalInitialize(void);
+
+#endif